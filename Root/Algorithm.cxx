@@ -1,7 +1,25 @@
 #include <xAODAnaHelpers/Algorithm.h>
+#include <xAODAnaHelpers/HelperFunctions.h>
+
+// EL include(s):
+#include <EventLoop/Worker.h>
 
 // ROOT includes
 #include <TSystem.h>
+#include <TH1D.h>
+#include <TEnv.h>
+#include <TROOT.h>
+#include <TThread.h>
+#include <RVersion.h>
+
+// c++ include(s):
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <sys/resource.h>
+#include <unistd.h>
 
 // RCU include for throwing an exception+message
 #include <RootCoreUtils/ThrowMsg.h>
@@ -14,9 +32,23 @@ xAH::Algorithm::Algorithm() :
   m_debug(false),
   m_systName(""),
   m_systVal(0),
+  m_systThreads(1),
+  m_profile(false),
+  m_profileWarmup(0),
   m_configName(""),
   m_event(nullptr),
-  m_store(nullptr)
+  m_store(nullptr),
+  m_profileStartTime(0),
+  m_profileStartRSS(0),
+  m_initializeTime(0),
+  m_finalizeTime(0),
+  m_executeCalls(0),
+  m_executeTotal(0),
+  m_profileEvent(0),
+  m_profileWallStart(0),
+  m_initializeRSS(0),
+  m_executeRSS(0),
+  m_finalizeRSS(0)
 {}
 
 xAH::Algorithm* xAH::Algorithm::setName(std::string name){
@@ -57,3 +89,211 @@ xAH::Algorithm* xAH::Algorithm::setSyst(std::string systName, float systVal){
   m_systVal = systVal;
   return this;
 }
+
+xAH::Algorithm* xAH::Algorithm::setSystThreads(unsigned int systThreads){
+  m_systThreads = systThreads;
+  return this;
+}
+
+void xAH::Algorithm::enableThreadSafety(){
+  static std::once_flag enabled;
+  std::call_once(enabled, [](){
+    Info("xAH::Algorithm::enableThreadSafety()", "Making ROOT thread safe");
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,6,0)
+    ROOT::EnableThreadSafety();
+#else
+    TThread::Initialize();
+#endif
+  });
+}
+
+int xAH::Algorithm::configValue(const std::string& key, int value) const {
+  if ( m_configName.empty() ) return value;
+  TEnv config(m_configName.c_str());
+  return config.GetValue(key.c_str(), value);
+}
+
+xAH::Algorithm* xAH::Algorithm::setProfile(bool profile, unsigned int warmup){
+  m_profile = profile;
+  m_profileWarmup = warmup;
+  return this;
+}
+
+namespace {
+  // wall clock in seconds
+  double profileClock(){
+    return std::chrono::duration<double>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+  }
+
+  // peak resident set size of the process so far, in kB
+  long profilePeakRSS(){
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+  }
+
+  // current resident set size of the process, in kB (0 if /proc is not there)
+  long profileCurrentRSS(){
+    std::ifstream statm("/proc/self/statm");
+    long size(0), resident(0);
+    if ( !( statm >> size >> resident ) ) return 0;
+    return resident * ( sysconf(_SC_PAGESIZE) / 1024 );
+  }
+
+  // execute times are histogrammed in 20 bins per decade from 1 us to 100 s,
+  // so the quantiles come out to about 12% whatever the number of events
+  const int    profileBinsPerDecade = 20;
+  const double profileMinTime       = 1e-6;
+  const int    profileNBins         = 8*profileBinsPerDecade + 2; // + under/overflow
+
+  int profileBin(double t){
+    if ( t < profileMinTime ) return 0;
+    int bin = 1 + static_cast<int>( std::log10( t/profileMinTime ) * profileBinsPerDecade );
+    return std::min( bin, profileNBins-1 );
+  }
+
+  // geometric centre of a bin
+  double profileBinTime(int bin){
+    if ( bin == 0 ) return profileMinTime;
+    return profileMinTime * std::pow( 10., ( bin - 0.5 ) / profileBinsPerDecade );
+  }
+
+  // the events the worker started so far, counted by whichever algorithm executes
+  // first on each new input file entry, so the warm-up is the same events for everyone
+  struct ProfileEvents {
+    const void*   file;
+    long long     entry;
+    unsigned long count;
+  };
+
+  ProfileEvents& profileEvents(){
+    static ProfileEvents events = { nullptr, -1, 0 };
+    return events;
+  }
+
+  // value below which a fraction q of the histogrammed times lies
+  float profileQuantile(const std::vector<unsigned long>& hist, unsigned long n, float q){
+    if ( !n ) return 0;
+    unsigned long target = std::min( n-1, static_cast<unsigned long>( q*n ) );
+    unsigned long seen(0);
+    for ( unsigned int bin = 0; bin < hist.size(); ++bin ) {
+      seen += hist[bin];
+      if ( seen > target ) return profileBinTime( bin );
+    }
+    return profileBinTime( hist.size()-1 );
+  }
+}
+
+void xAH::Algorithm::profileStart(Stage stage){
+  // the retrieve() cache follows the entries of the TEvent by itself, it only needs to
+  // know when a job starts and when its TEvent is about to go
+  if ( stage == Stage::INITIALIZE ) {
+    HelperFunctions::RetrieveCache::open( wk()->xaodEvent() );
+  } else if ( stage == Stage::FINALIZE ) {
+    HelperFunctions::RetrieveCache::release( wk()->xaodEvent() );
+  }
+  if ( !m_profile ) return;
+  if ( stage == Stage::EXECUTE ) {
+    ProfileEvents& events = profileEvents();
+    if ( events.file != wk()->inputFile() || events.entry != wk()->treeEntry() ) {
+      events.file  = wk()->inputFile();
+      events.entry = wk()->treeEntry();
+      ++events.count;
+    }
+    m_profileEvent = events.count;
+  }
+  m_profileStartRSS  = profileCurrentRSS();
+  m_profileStartTime = profileClock();
+  // the event loop wall clock runs from the start of the first event after the warm-up
+  if ( stage == Stage::EXECUTE && m_profileEvent == m_profileWarmup+1 && m_profileWallStart == 0 ) {
+    m_profileWallStart = m_profileStartTime;
+  }
+}
+
+void xAH::Algorithm::profileStop(Stage stage){
+  if ( !m_profile ) return;
+  double elapsed = profileClock() - m_profileStartTime;
+  long   growth  = profileCurrentRSS() - m_profileStartRSS;
+
+  switch ( stage ) {
+    case Stage::INITIALIZE:
+      m_initializeTime += elapsed;
+      m_initializeRSS  += growth;
+      break;
+    case Stage::EXECUTE:
+      if ( m_profileEvent <= m_profileWarmup ) { break; }
+      if ( m_executeHist.empty() ) { m_executeHist.assign( profileNBins, 0 ); }
+      ++m_executeHist[ profileBin( elapsed ) ];
+      ++m_executeCalls;
+      m_executeTotal   += elapsed;
+      m_executeRSS     += growth;
+      break;
+    case Stage::FINALIZE:
+      m_finalizeTime   += elapsed;
+      m_finalizeRSS    += growth;
+      // finalize is the last call we see, so write out what we have
+      if ( this->profileReport() != EL::StatusCode::SUCCESS ) {
+        Error("profileStop()", "%s failed to write the profile summary", m_name.c_str());
+      }
+      break;
+  }
+}
+
+EL::StatusCode xAH::Algorithm::profileReport(){
+  if ( !m_profile ) return EL::StatusCode::SUCCESS;
+
+  double total        = m_executeTotal;
+  unsigned int nCalls = m_executeCalls;
+  float mean          = nCalls ? total/nCalls : 0;
+  float p50           = profileQuantile( m_executeHist, m_executeCalls, 0.50 );
+  float p99           = profileQuantile( m_executeHist, m_executeCalls, 0.99 );
+  float rate          = total > 0 ? nCalls/total : 0;
+  long  peakRSS       = profilePeakRSS();
+  // wall clock from the start of this algorithm's first measured event to now (its finalize),
+  // and the events the worker started since: for the first algorithm of the chain this is the
+  // event loop itself, input and framework included
+  double wall         = m_profileWallStart > 0 ? profileClock() - m_profileWallStart : 0;
+  unsigned long nWall = profileEvents().count > m_profileWarmup ? profileEvents().count - m_profileWarmup : 0;
+
+  Info("profileReport()", "%s: %u calls to execute, mean %.3f ms, p50 %.3f ms, p99 %.3f ms, %.1f events/s",
+       m_name.c_str(), nCalls, 1e3*mean, 1e3*p50, 1e3*p99, rate);
+  Info("profileReport()", "%s: %lu events in %.3f s of wall clock since the warm-up",
+       m_name.c_str(), nWall, wall);
+  Info("profileReport()", "%s: initialize %.3f s, finalize %.3f s, RSS growth %ld/%ld/%ld kB (init/execute/finalize), process peak RSS %ld kB",
+       m_name.c_str(), m_initializeTime, m_finalizeTime, m_initializeRSS, m_executeRSS, m_finalizeRSS, peakRSS);
+
+  // the summary as a labelled histogram in the EL output, so it gets merged like the cutflows
+  std::string histName = "profile_" + m_name;
+  std::replace( histName.begin(), histName.end(), '/', '_' );
+
+  TH1D* summary = new TH1D( histName.c_str(), histName.c_str(), 13, 0.5, 13.5 );
+  summary->GetXaxis()->SetBinLabel(1,  "nExecute");
+  summary->GetXaxis()->SetBinLabel(2,  "initialize [s]");
+  summary->GetXaxis()->SetBinLabel(3,  "execute total [s]");
+  summary->GetXaxis()->SetBinLabel(4,  "execute mean [ms]");
+  summary->GetXaxis()->SetBinLabel(5,  "execute p50 [ms]");
+  summary->GetXaxis()->SetBinLabel(6,  "execute p99 [ms]");
+  summary->GetXaxis()->SetBinLabel(7,  "finalize [s]");
+  summary->GetXaxis()->SetBinLabel(8,  "events/s");
+  summary->GetXaxis()->SetBinLabel(9,  "RSS growth initialize [kB]");
+  summary->GetXaxis()->SetBinLabel(10, "RSS growth execute [kB]");
+  summary->GetXaxis()->SetBinLabel(11, "peak RSS [kB]");
+  summary->GetXaxis()->SetBinLabel(12, "events after warm-up");
+  summary->GetXaxis()->SetBinLabel(13, "wall after warm-up [s]");
+  summary->SetBinContent(1,  nCalls);
+  summary->SetBinContent(2,  m_initializeTime);
+  summary->SetBinContent(3,  total);
+  summary->SetBinContent(4,  1e3*mean);
+  summary->SetBinContent(5,  1e3*p50);
+  summary->SetBinContent(6,  1e3*p99);
+  summary->SetBinContent(7,  m_finalizeTime);
+  summary->SetBinContent(8,  rate);
+  summary->SetBinContent(9,  m_initializeRSS);
+  summary->SetBinContent(10, m_executeRSS);
+  summary->SetBinContent(11, peakRSS);
+  summary->SetBinContent(12, nWall);
+  summary->SetBinContent(13, wall);
+  wk()->addOutput( summary );
+
+  return EL::StatusCode::SUCCESS;
+}
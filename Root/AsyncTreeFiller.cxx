@@ -0,0 +1,113 @@
+/******************************************
+ *
+ * TTree::Fill on a thread of its own, one
+ * event of one tree per output file in
+ * flight at a time.
+ *
+ ******************************************/
+
+// package include(s):
+#include <xAODAnaHelpers/AsyncTreeFiller.h>
+
+std::mutex AsyncTreeFiller::s_mutex;
+std::map< TFile*, AsyncTreeFiller* > AsyncTreeFiller::s_fillers;
+
+AsyncTreeFiller* AsyncTreeFiller :: acquire( TFile* file )
+{
+  std::lock_guard<std::mutex> lock( s_mutex );
+  AsyncTreeFiller*& filler = s_fillers[ file ];
+  if ( !filler ) { filler = new AsyncTreeFiller( file ); }
+  ++filler->m_users;
+  return filler;
+}
+
+void AsyncTreeFiller :: release( AsyncTreeFiller*& filler )
+{
+  if ( !filler ) { return; }
+  {
+    std::lock_guard<std::mutex> lock( s_mutex );
+    if ( --filler->m_users ) { filler = nullptr; return; }
+    s_fillers.erase( filler->m_file );
+  }
+  delete filler;
+  filler = nullptr;
+}
+
+void AsyncTreeFiller :: waitFor( TFile* file )
+{
+  AsyncTreeFiller* filler(nullptr);
+  {
+    std::lock_guard<std::mutex> lock( s_mutex );
+    auto it = s_fillers.find( file );
+    if ( it == s_fillers.end() ) { return; }
+    filler = it->second;
+  }
+  // only the main thread fills and releases, the filler is still there
+  filler->wait();
+}
+
+AsyncTreeFiller :: AsyncTreeFiller( TFile* file ) :
+  m_file(file),
+  m_users(0),
+  m_pending(nullptr),
+  m_stop(false),
+  m_entries(0),
+  m_bytes(0),
+  m_errors(0)
+{
+  // ROOT was made thread safe before any I/O, see xAH::Algorithm::enableThreadSafety()
+  m_thread = std::thread( &AsyncTreeFiller::run, this );
+}
+
+AsyncTreeFiller :: ~AsyncTreeFiller()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cond.wait( lock, [this]{ return !m_pending; } );
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  m_thread.join();
+
+  const char* fileName = m_file ? m_file->GetName() : "";
+  Info("AsyncTreeFiller", "%s: %lld entries, %lld bytes written in the background", fileName, m_entries, m_bytes);
+  if ( m_errors ) {
+    Error("AsyncTreeFiller", "%s: TTree::Fill failed for %lld entries", fileName, m_errors);
+  }
+}
+
+void AsyncTreeFiller :: fill( TTree* tree )
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cond.wait( lock, [this]{ return !m_pending; } );
+    m_pending = tree;
+  }
+  m_cond.notify_all();
+}
+
+void AsyncTreeFiller :: wait()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [this]{ return !m_pending; } );
+}
+
+void AsyncTreeFiller :: run()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while ( true ) {
+    m_cond.wait( lock, [this]{ return m_pending || m_stop; } );
+    if ( !m_pending ) { return; }
+
+    // the owner does not touch the buffers, nor anybody the file, until m_pending is cleared
+    TTree* tree = m_pending;
+    lock.unlock();
+    Int_t nBytes = tree->Fill();
+    lock.lock();
+
+    ++m_entries;
+    if ( nBytes < 0 ) { ++m_errors; } else { m_bytes += nBytes; }
+    m_pending = nullptr;
+    m_cond.notify_all();
+  }
+}
@@ -9,6 +9,7 @@
 
 // c++ include(s):
 #include <iostream>
+#include <set>
 
 // EL include(s):
 #include <EventLoop/Job.h>
@@ -33,7 +34,8 @@ ClassImp(BJetEfficiencyCorrector)
 
 
 BJetEfficiencyCorrector :: BJetEfficiencyCorrector () :
-  m_BJetEffSFTool(nullptr)
+  m_BJetEffSFTool(nullptr),
+  m_systPool(nullptr)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -61,6 +63,8 @@ EL::StatusCode  BJetEfficiencyCorrector :: configure ()
     m_inContainerName         = config->GetValue("InputContainer",  "");
     m_systName                = config->GetValue("SystName" ,       "" );      // default: no syst
     m_outputSystName          = config->GetValue("OutputSystName",  "BJetEfficiency_Algo");
+    // number of threads (and of efficiency tool instances) the systematics are spread over
+    m_systThreads             = config->GetValue("SystThreads", static_cast<int>(m_systThreads));
 
     //
     // configuration of the bjet eff tool
@@ -129,6 +133,8 @@ EL::StatusCode BJetEfficiencyCorrector :: setupJob (EL::Job& job)
 
 EL::StatusCode BJetEfficiencyCorrector :: histInitialize ()
 {
+  // the systematic threads need ROOT to be thread safe before the input is read
+  if ( this->configValue( "SystThreads", static_cast<int>(m_systThreads) ) > 1 ) { xAH::Algorithm::enableThreadSafety(); }
   return EL::StatusCode::SUCCESS;
 }
 
@@ -148,6 +154,8 @@ EL::StatusCode BJetEfficiencyCorrector :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode BJetEfficiencyCorrector :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   Info("initialize()", "Initializing BJetEfficiencyCorrector Interface... ");
 
   m_event = wk()->xaodEvent();
@@ -164,19 +172,7 @@ EL::StatusCode BJetEfficiencyCorrector :: initialize ()
   // initialize the BJetEfficiencyCorrectionTool
   //
   std::string sf_tool_name = std::string("BJetEfficiencyCorrectionTool_") + m_name;
-  m_BJetEffSFTool = new BTaggingEfficiencyTool( "BTagTest" );
-  m_BJetEffSFTool->msg().setLevel( MSG::INFO ); // DEBUG, VERBOSE, INFO, ERROR
-
-  //
-  //  Configure the BJetEfficiencyCorrectionTool
-  //
-  RETURN_CHECK( "BJetEfficiencyCorrector::initialize()", m_BJetEffSFTool->setProperty("TaggerName",          m_taggerName),"Failed to set property");
-  RETURN_CHECK( "BJetEfficiencyCorrector::initialize()", m_BJetEffSFTool->setProperty("OperatingPoint",      m_operatingPt),"Failed to set property");
-  RETURN_CHECK( "BJetEfficiencyCorrector::initialize()", m_BJetEffSFTool->setProperty("JetAuthor",           m_jetAuthor),"Failed to set property");
-  RETURN_CHECK( "BJetEfficiencyCorrector::initialize()", m_BJetEffSFTool->setProperty("ScaleFactorFileName", m_corrFileName),"Failed to set property");
-  RETURN_CHECK( "BJetEfficiencyCorrector::initialize()", m_BJetEffSFTool->setProperty("UseDevelopmentFile",  m_useDevelopmentFile), "Failed to set property");
-  RETURN_CHECK( "BJetEfficiencyCorrector::initialize()", m_BJetEffSFTool->setProperty("ConeFlavourLabel",    m_coneFlavourLabel), "Failed to set property");
-  RETURN_CHECK( "BJetEfficiencyCorrector::initialize()", m_BJetEffSFTool->initialize(), "Failed to properly initialize the BJetEfficiencyCorrectionTool");
+  RETURN_CHECK( "BJetEfficiencyCorrector::initialize()", this->makeEffSFTool( m_BJetEffSFTool, sf_tool_name ), "");
 
   //
   // Print out
@@ -216,6 +212,30 @@ EL::StatusCode BJetEfficiencyCorrector :: initialize ()
     Info("initialize()"," Running w/ All systematics");
   }
 
+  //
+  // if not running systematics, only compute weight for specified systematic (m_systName)
+  //    default is nominal (i.e., "")
+  //
+  if( !m_runAllSyst ){
+    for( auto syst_it = m_systList.begin(); syst_it != m_systList.end(); ){
+      if( syst_it->name() != m_systName ) { syst_it = m_systList.erase( syst_it ); }
+      else { ++syst_it; }
+    }
+  }
+
+  //
+  // an instance of the tool for every further thread, no more than there are systematics
+  //
+  m_BJetEffSFTools.assign( 1, m_BJetEffSFTool );
+  for( unsigned int iTool = 1; iTool < m_systThreads && iTool < m_systList.size(); ++iTool ){
+    BTaggingEfficiencyTool* effSFTool(nullptr);
+    RETURN_CHECK( "BJetEfficiencyCorrector::initialize()", this->makeEffSFTool( effSFTool, sf_tool_name + "_" + std::to_string(iTool) ), "");
+    m_BJetEffSFTools.push_back( effSFTool );
+  }
+
+  m_systPool = new TaskPool( m_BJetEffSFTools.size() );
+  if( m_systPool->workers() > 1 ) Warning("initialize()", "Evaluating the systematics with %u threads. This is experimental: the CP tools may still read the input from the threads", m_systPool->workers());
+
   Info("initialize()", "BJetEfficiencyCorrector Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -224,29 +244,34 @@ EL::StatusCode BJetEfficiencyCorrector :: initialize ()
 
 EL::StatusCode BJetEfficiencyCorrector :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   if(m_debug) Info("execute()", "Applying BJet Efficiency Correction... ");
 
   // get the collection from TEvent or TStore
   const xAOD::JetContainer* correctedJets(nullptr);
   RETURN_CHECK("BJetEfficiencyCorrector::execute()", HelperFunctions::retrieve(correctedJets, m_inContainerName, m_event, m_store, m_debug) ,"");
 
+  //
+  // the threads should not make TEvent read anything: what the tool looks at, on the jets
+  // and the b-tagging objects they link to, is read here
+  //
+  if( m_systPool->workers() > 1 ){
+    RETURN_CHECK("BJetEfficiencyCorrector::execute()", HelperFunctions::preloadEvent(m_event, m_store, m_debug), "");
+    std::set<const SG::AuxVectorData*> btaggings;
+    for( auto jet_itr : *correctedJets ){
+      if( jet_itr->btagging() ) btaggings.insert( jet_itr->btagging()->container() );
+    }
+    HelperFunctions::preloadAux( correctedJets, { "pt", "eta", "phi", "m", "TruthLabelID", "ConeTruthLabelID", "HadronConeExclTruthLabelID" } );
+    HelperFunctions::preloadAux( btaggings, { m_taggerName + "_discriminant" } );
+  }
+
   //
   // loop over available systematics
   //
   std::vector< std::string >* sysVariationNames = new std::vector< std::string >;
   for(const auto& syst_it : m_systList){
 
-    //
-    // if not running systematics, only compulte weight for specified systematic (m_systName)
-    //    default is nominal (i.e., "")
-    //
-    if(!m_runAllSyst){
-      if( syst_it.name() != m_systName ) {
-	if(m_debug) Info("execute()","Not running systematics only apply nominal SF");
-	continue;
-      }
-    }
-
     //
     // Create the name of the weight
     //   template:  SYSNAME_BTag_SF
@@ -256,70 +281,106 @@ EL::StatusCode BJetEfficiencyCorrector :: execute ()
        std::string prepend = syst_it.name() + "_";
        sfName.insert( 0, prepend );
     }
-    if(m_debug) Info("execute()", "SF decoration name is: %s", m_decor.c_str());
+    if(m_debug) Info("execute()", "SF decoration name is: %s", sfName.c_str());
     sysVariationNames->push_back(sfName);
 
+  }
+
+  //
+  // obtain efficiency SF - the systematics are independent, each worker of the pool has its own tool
+  //
+  std::vector< std::vector<float> > SFs( m_systList.size(), std::vector<float>( correctedJets->size(), 0.0 ) );
+  bool systOk = m_systPool->run( m_systList.size(), [&]( unsigned int worker, unsigned int iSyst ) {
+
+    const CP::SystematicSet& syst_it = m_systList.at(iSyst);
+    BTaggingEfficiencyTool* effSFTool = m_BJetEffSFTools.at(worker);
+
     //
     // configure tool with syst variation
     //
-    if (m_BJetEffSFTool->applySystematicVariation(syst_it) != CP::SystematicCode::Ok) {
-      Error("initialize()", "Failed to configure BJetEfficiencyCorrections for systematic %s", syst_it.name().c_str());
-      return EL::StatusCode::FAILURE;
+    if (effSFTool->applySystematicVariation(syst_it) != CP::SystematicCode::Ok) {
+      Error("execute()", "Failed to configure BJetEfficiencyCorrections for systematic %s", syst_it.name().c_str());
+      return false;
     }
     if(m_debug) Info("execute()", "Successfully applied systematic: %s", syst_it.name().c_str());
 
-    //
-    // and now apply data-driven efficiency and efficiency SF!
-    //
-    for( auto jet_itr : *(correctedJets)) {
-
-      //
-      //  If btagging vector doesnt exist create it
-      //
-      SG::AuxElement::Decorator< std::vector<float> > sfVec( m_outputSystName );
-      if(!sfVec.isAvailable(*jet_itr)){
-	sfVec(*jet_itr) = std::vector<float>();
-      }
+    for( unsigned int iJet = 0; iJet < correctedJets->size(); ++iJet ) {
+      const xAOD::Jet* jet_itr = correctedJets->at(iJet);
 
-      //
-      // obtain efficiency SF
-      //
-      float SF(0.0);
-      if( m_BJetEffSFTool->getScaleFactor( *jet_itr, SF ) != CP::CorrectionCode::Ok){
+      if( effSFTool->getScaleFactor( *jet_itr, SFs.at(iSyst).at(iJet) ) != CP::CorrectionCode::Ok){
 	Error( "execute()", "Problem in getEfficiencyScaleFactor");
-	return EL::StatusCode::FAILURE;
+	return false;
       }
-      if(m_debug) Info( "execute()", "\t efficiency SF = %g", SF );
-
-      //
-      // Add it to vector
-      //
-      sfVec(*jet_itr).push_back(SF);
+      if(m_debug) Info( "execute()", "\t efficiency SF = %g", SFs.at(iSyst).at(iJet) );
 
       if(m_debug){
 	//
 	// directly obtain reco efficiency
 	//
 	float eff(0.0);
-	if( m_BJetEffSFTool->getEfficiency( *jet_itr, eff ) != CP::CorrectionCode::Ok){
+	if( effSFTool->getEfficiency( *jet_itr, eff ) != CP::CorrectionCode::Ok){
 	  Error( "execute()", "Problem in getRecoEfficiency");
-	  return EL::StatusCode::FAILURE;
+	  return false;
 	}
 	Info( "execute()", "\t reco efficiency = %g", eff );
       }
 
+    } // close jet loop
+    return true;
+  });
+  if( !systOk ){
+    delete sysVariationNames;
+    return EL::StatusCode::FAILURE;
+  }
+
+  //
+  // and now add them to the jets, in the order of the systematics
+  //
+  SG::AuxElement::Decorator< std::vector<float> > sfVec( m_outputSystName );
+  for( unsigned int iJet = 0; iJet < correctedJets->size(); ++iJet ) {
+    const xAOD::Jet* jet_itr = correctedJets->at(iJet);
+
+    //
+    //  If btagging vector doesnt exist create it
+    //
+    if(!sfVec.isAvailable(*jet_itr)){
+      sfVec(*jet_itr) = std::vector<float>();
+    }
+
+    for( unsigned int iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
+      sfVec(*jet_itr).push_back( SFs.at(iSyst).at(iJet) );
+
       if(m_debug){
-	Info( "execute", "===>>> Resulting SF (%s) (from tool) %f, (from object) %f",  sfName.c_str(), SF, sfVec(*jet_itr).back());
+	Info( "execute", "===>>> Resulting SF (%s) (from tool) %f, (from object) %f",  sysVariationNames->at(iSyst).c_str(), SFs.at(iSyst).at(iJet), sfVec(*jet_itr).back());
       }
+    }
 
-    } // close jet loop
-
-  } // close loop on systematics
+  } // close jet loop
 
   //
   // add list of sys names to TStore
   //
-  RETURN_CHECK( "BJetEfficiencyCorrector::execute()", m_store->record( sysVariationNames, m_outputSystName), "Failed to record vector of systematic names.");
+  RETURN_CHECK( "BJetEfficiencyCorrector::execute()", HelperFunctions::record( sysVariationNames, m_outputSystName, m_store ), "Failed to record vector of systematic names.");
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+EL::StatusCode BJetEfficiencyCorrector :: makeEffSFTool ( BTaggingEfficiencyTool*& effSFTool, const std::string& name )
+{
+  effSFTool = new BTaggingEfficiencyTool( name );
+  effSFTool->msg().setLevel( MSG::INFO ); // DEBUG, VERBOSE, INFO, ERROR
+
+  //
+  //  Configure the BJetEfficiencyCorrectionTool
+  //
+  RETURN_CHECK( "BJetEfficiencyCorrector::makeEffSFTool()", effSFTool->setProperty("TaggerName",          m_taggerName),"Failed to set property");
+  RETURN_CHECK( "BJetEfficiencyCorrector::makeEffSFTool()", effSFTool->setProperty("OperatingPoint",      m_operatingPt),"Failed to set property");
+  RETURN_CHECK( "BJetEfficiencyCorrector::makeEffSFTool()", effSFTool->setProperty("JetAuthor",           m_jetAuthor),"Failed to set property");
+  RETURN_CHECK( "BJetEfficiencyCorrector::makeEffSFTool()", effSFTool->setProperty("ScaleFactorFileName", m_corrFileName),"Failed to set property");
+  RETURN_CHECK( "BJetEfficiencyCorrector::makeEffSFTool()", effSFTool->setProperty("UseDevelopmentFile",  m_useDevelopmentFile), "Failed to set property");
+  RETURN_CHECK( "BJetEfficiencyCorrector::makeEffSFTool()", effSFTool->setProperty("ConeFlavourLabel",    m_coneFlavourLabel), "Failed to set property");
+  RETURN_CHECK( "BJetEfficiencyCorrector::makeEffSFTool()", effSFTool->initialize(), "Failed to properly initialize the BJetEfficiencyCorrectionTool");
 
   return EL::StatusCode::SUCCESS;
 }
@@ -335,10 +396,20 @@ EL::StatusCode BJetEfficiencyCorrector :: postExecute ()
 
 EL::StatusCode BJetEfficiencyCorrector :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   Info("finalize()", "Deleting tool instances...");
+  // the first of them is m_BJetEffSFTool
+  for(unsigned int iTool = 1; iTool < m_BJetEffSFTools.size(); ++iTool){
+    delete m_BJetEffSFTools.at(iTool);
+  }
+  m_BJetEffSFTools.clear();
   if(m_BJetEffSFTool){
     delete m_BJetEffSFTool; m_BJetEffSFTool = nullptr;
   }
+  if(m_systPool){
+    delete m_systPool; m_systPool = nullptr;
+  }
   return EL::StatusCode::SUCCESS;
 }
 
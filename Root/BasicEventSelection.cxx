@@ -25,6 +25,7 @@
 // package include(s):
 #include <xAODAnaHelpers/HelperFunctions.h>
 #include <xAODAnaHelpers/BasicEventSelection.h>
+#include <xAODAnaHelpers/TrigDecisionCache.h>
 
 #include <xAODAnaHelpers/tools/ReturnCheck.h>
 
@@ -45,6 +46,7 @@ BasicEventSelection :: BasicEventSelection () :
   m_pileuptool(nullptr),
   m_trigConfTool(nullptr),
   m_trigDecTool(nullptr),
+  m_trigCache(nullptr),
   m_histEventCount(nullptr),
   m_cutflowHist(nullptr),
   m_cutflowHistW(nullptr)
@@ -305,6 +307,8 @@ EL::StatusCode BasicEventSelection :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode BasicEventSelection :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -341,15 +345,11 @@ EL::StatusCode BasicEventSelection :: initialize ()
   // Trigger //
   if ( m_triggerSelection.size() > 0 ) {
     
-    m_trigConfTool = new TrigConf::xAODConfigTool( "xAODConfigTool" );
-    RETURN_CHECK("BasicEventSelection::initialize()", m_trigConfTool->initialize(), "");
-    ToolHandle< TrigConf::ITrigConfigTool > configHandle( m_trigConfTool );
+    // one pair of trigger tools for all the algorithms of the job
+    RETURN_CHECK("BasicEventSelection::initialize()", TrigDecisionCache::shareTools( m_trigDecTool, m_trigConfTool ), "");
 
-    m_trigDecTool = new Trig::TrigDecisionTool( "TrigDecisionTool" );
-    RETURN_CHECK("BasicEventSelection::initialize()", m_trigDecTool->setProperty( "ConfigTool", configHandle ), "");
-    RETURN_CHECK("BasicEventSelection::initialize()", m_trigDecTool->setProperty( "TrigDecisionKey", "xTrigDecision" ), "");
-    RETURN_CHECK("BasicEventSelection::initialize()", m_trigDecTool->setProperty( "OutputLevel", MSG::ERROR), "");
-    RETURN_CHECK("BasicEventSelection::initialize()", m_trigDecTool->initialize(), "");
+    // chain groups get resolved once here, and again only if the menu changes
+    m_trigCache = new TrigDecisionCache( m_trigDecTool, m_trigConfTool, m_triggerSelection );
 
   }
 
@@ -374,6 +374,8 @@ EL::StatusCode BasicEventSelection :: initialize ()
 
 EL::StatusCode BasicEventSelection :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -387,11 +389,10 @@ EL::StatusCode BasicEventSelection :: execute ()
 
   ++m_eventCounter;
 
-  //--------------------------
   //Print trigger's used for first event only
   if ( m_eventCounter == 1 && m_triggerSelection.size() > 0) {
-    auto printingTriggerChainGroup = m_trigDecTool->getChainGroup(m_triggerSelection);
-    std::vector<std::string> triggersUsed = printingTriggerChainGroup->getListOfTriggers();
+    m_trigCache->updateMenu();
+    const std::vector<std::string>& triggersUsed = m_trigCache->chains();
     printf("*** Triggers used are:\n");
     for ( unsigned int iTrigger = 0; iTrigger < triggersUsed.size(); ++iTrigger ) {
       printf("    %s\n", triggersUsed.at(iTrigger).c_str());
@@ -521,14 +522,14 @@ EL::StatusCode BasicEventSelection :: execute ()
 
   // Trigger //
   if ( m_triggerSelection.size() > 0 ) {
-    auto triggerChainGroup = m_trigDecTool->getChainGroup(m_triggerSelection);
-    //std::cout << m_triggerSelection << " " << triggerChainGroup->isPassed() << " " << triggerChainGroup->getPrescale() << std::endl;
-    if ( !triggerChainGroup->isPassed() ) {
+    // only for the events that got this far, evaluated once and decorated on EventInfo
+    m_trigCache->decide( eventInfo );
+    if ( !m_trigCache->passSelection() ) {
       wk()->skipEvent();
       return EL::StatusCode::SUCCESS;
     }
     static SG::AuxElement::Decorator< float > weight_prescale("weight_prescale");
-    weight_prescale(*eventInfo) = triggerChainGroup->getPrescale();
+    weight_prescale(*eventInfo) = m_trigCache->selectionPrescale();
     m_cutflowHist ->Fill( m_cutflow_trigger, 1 );
     m_cutflowHistW->Fill( m_cutflow_trigger, mcEvtWeight);
   }
@@ -555,6 +556,8 @@ EL::StatusCode BasicEventSelection :: postExecute ()
 
 EL::StatusCode BasicEventSelection :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -566,12 +569,14 @@ EL::StatusCode BasicEventSelection :: finalize ()
   // gets called on worker nodes that processed input events.
 
   Info("finalize()", "Number of processed events      = %i", m_eventCounter);
+  Info("finalize()", "retrieve() cache hits / misses  = %lu / %lu",
+       HelperFunctions::RetrieveCache::hits(), HelperFunctions::RetrieveCache::misses());
 
   if(m_grl) delete m_grl;
   if(m_pileuptool) delete m_pileuptool;
   if( m_triggerSelection.size() > 0){
-    if(m_trigDecTool) delete m_trigDecTool;
-    if(m_trigConfTool) delete m_trigConfTool;
+    if(m_trigCache) delete m_trigCache;
+    TrigDecisionCache::releaseTools( m_trigDecTool, m_trigConfTool );
   }
 
   return EL::StatusCode::SUCCESS;
@@ -0,0 +1,86 @@
+/******************************************
+ *
+ * Window cuts on all objects of a
+ * container at once.
+ *
+ ******************************************/
+
+// package include(s):
+#include <xAODAnaHelpers/BatchPreselection.h>
+
+// c++ include(s):
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+void BatchPreselection :: clear()
+{
+  m_windows.clear();
+  m_mask.clear();
+}
+
+bool BatchPreselection :: addWindow( const std::string& name, double min, double max, bool absolute, double disabled )
+{
+  if ( min == disabled && max == disabled ) { return false; }
+
+  Window window;
+  window.name     = name;
+  window.min      = ( min == disabled ) ? -std::numeric_limits<double>::infinity() : min;
+  window.max      = ( max == disabled ) ?  std::numeric_limits<double>::infinity() : max;
+  window.absolute = absolute;
+  m_windows.push_back( window );
+
+  return true;
+}
+
+double* BatchPreselection :: column( unsigned int window, unsigned int nObj )
+{
+  std::vector<double>& values = m_windows.at( window ).values;
+  if ( values.size() < nObj ) { values.resize( nObj ); }
+  return values.data();
+}
+
+void BatchPreselection :: evaluate( unsigned int nObj )
+{
+  m_mask.assign( ( nObj + 63 ) / 64, ~uint64_t(0) );
+
+  for ( const auto& window : m_windows ) {
+
+    const double* x = window.values.data();
+    unsigned int i(0);
+
+    // the lanes failing the window give a bit each, the objects come in groups of 4 (AVX) or 2 (SSE2)
+    // that never straddle two words of the mask
+#if defined(__AVX__)
+    const __m256d lo4  = _mm256_set1_pd( window.min );
+    const __m256d hi4  = _mm256_set1_pd( window.max );
+    const __m256d abs4 = window.absolute ? _mm256_castsi256_pd( _mm256_set1_epi64x( 0x7fffffffffffffffLL ) )
+                                         : _mm256_castsi256_pd( _mm256_set1_epi64x( -1LL ) );
+    for ( ; i + 4 <= nObj; i += 4 ) {
+      __m256d v     = _mm256_and_pd( _mm256_loadu_pd( x + i ), abs4 );
+      __m256d fail  = _mm256_or_pd( _mm256_cmp_pd( v, hi4, _CMP_GT_OQ ), _mm256_cmp_pd( v, lo4, _CMP_LT_OQ ) );
+      uint64_t bits = static_cast<uint64_t>( _mm256_movemask_pd( fail ) );
+      m_mask[ i >> 6 ] &= ~( bits << ( i & 63 ) );
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128d lo2  = _mm_set1_pd( window.min );
+    const __m128d hi2  = _mm_set1_pd( window.max );
+    const __m128d abs2 = window.absolute ? _mm_castsi128_pd( _mm_set1_epi64x( 0x7fffffffffffffffLL ) )
+                                         : _mm_castsi128_pd( _mm_set1_epi64x( -1LL ) );
+    for ( ; i + 2 <= nObj; i += 2 ) {
+      __m128d v     = _mm_and_pd( _mm_loadu_pd( x + i ), abs2 );
+      __m128d fail  = _mm_or_pd( _mm_cmpgt_pd( v, hi2 ), _mm_cmplt_pd( v, lo2 ) );
+      uint64_t bits = static_cast<uint64_t>( _mm_movemask_pd( fail ) );
+      m_mask[ i >> 6 ] &= ~( bits << ( i & 63 ) );
+    }
+#endif
+    for ( ; i < nObj; ++i ) {
+      double v = window.absolute ? std::fabs( x[i] ) : x[i];
+      if ( v > window.max || v < window.min ) { m_mask[ i >> 6 ] &= ~( uint64_t(1) << ( i & 63 ) ); }
+    }
+  }
+}
@@ -74,10 +74,10 @@ EL::StatusCode ContainerRecording :: execute ()
     Info("execute()", "Applied Pt=0 GeV to the shallow-copied jets.");
 
     // Third: store the ConstDataVector in TStore
-    RETURN_CHECK("ContainerRecording::execute()", m_store->record(in_aktJets_subset, outputContainer_CDV), "Failed to store CDV subset in Store." );
+    RETURN_CHECK("ContainerRecording::execute()", HelperFunctions::record( in_aktJets_subset, outputContainer_CDV, m_store ), "Failed to store CDV subset in Store." );
     // ....... and the shallow copy in TStore
-    RETURN_CHECK("ContainerRecording::execute()", m_store->record( in_aktJets_shallow.first, outputContainer_shallow ), "");
-    RETURN_CHECK("ContainerRecording::execute()", m_store->record( in_aktJets_shallow.second, outputContainer_shallow+"Aux." ), "");
+    RETURN_CHECK("ContainerRecording::execute()", HelperFunctions::record( in_aktJets_shallow.first, outputContainer_shallow, m_store ), "");
+    RETURN_CHECK("ContainerRecording::execute()", HelperFunctions::record( in_aktJets_shallow.second, outputContainer_shallow+"Aux.", m_store ), "");
     Info("execute()", "000000000000000000000000000000000000000000000000000");
 
     // Fourth: retrieve the object stored in multiple ways
@@ -8,7 +8,10 @@
  *********************************************/
 
 // c++ include(s):
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <set>
 
 // EL include(s):
 #include <EventLoop/Job.h>
@@ -44,7 +47,8 @@ ClassImp(ElectronCalibrator)
 
 
 ElectronCalibrator :: ElectronCalibrator () :
-  m_EgammaCalibrationAndSmearingTool(nullptr)
+  m_EgammaCalibrationAndSmearingTool(nullptr),
+  m_systPool(nullptr)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -80,6 +84,8 @@ EL::StatusCode  ElectronCalibrator :: configure ()
     m_systName		      = config->GetValue("SystName" , "" );
     m_systVal 		      = config->GetValue("SystVal" , 0. );
     m_runAllSyst              = (m_systName.find("All") != std::string::npos);
+    // number of threads (and of calibration tool instances) the variations are spread over
+    m_systThreads             = config->GetValue("SystThreads", static_cast<int>(m_systThreads));
 
     m_sort                    = config->GetValue("Sort",  false);
 
@@ -100,6 +106,11 @@ EL::StatusCode  ElectronCalibrator :: configure ()
   m_outSCContainerName      = m_outContainerName + "ShallowCopy";
   m_outSCAuxContainerName   = m_outSCContainerName + "Aux."; // the period is very important!
 
+  // the names of the containers of each systematic
+  m_outSCKeys               = SystematicKeys( m_outSCContainerName );
+  m_outSCAuxKeys            = SystematicKeys( m_outSCAuxContainerName );
+  m_outKeys                 = SystematicKeys( m_outContainerName );
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -130,6 +141,9 @@ EL::StatusCode ElectronCalibrator :: histInitialize ()
   // beginning on each worker node, e.g. create histograms and output
   // trees.  This method gets called before any input files are
   // connected.
+
+  // the systematic threads need ROOT to be thread safe before the input is read
+  if ( this->configValue( "SystThreads", static_cast<int>(m_systThreads) ) > 1 ) { xAH::Algorithm::enableThreadSafety(); }
   return EL::StatusCode::SUCCESS;
 }
 
@@ -156,6 +170,8 @@ EL::StatusCode ElectronCalibrator :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode ElectronCalibrator :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -182,20 +198,33 @@ EL::StatusCode ElectronCalibrator :: initialize ()
 
   // initialize the CP EgammaCalibrationAndSmearing tool
   std::string egcas_tool_name = std::string("EgammaCalibrationAndSmearingTool_") + m_name;
-  m_EgammaCalibrationAndSmearingTool = new CP::EgammaCalibrationAndSmearingTool( egcas_tool_name.c_str() );
-  m_EgammaCalibrationAndSmearingTool->msg().setLevel( MSG::ERROR ); // DEBUG, VERBOSE, INFO
-  RETURN_CHECK( "ElectronCalibrator::initialize()", m_EgammaCalibrationAndSmearingTool->setProperty("ESModel", "es2012c"),"Failed to set property ESModel");
-  RETURN_CHECK( "ElectronCalibrator::initialize()", m_EgammaCalibrationAndSmearingTool->setProperty("ResolutionType", "SigmaEff90"),"Failed to set property ResolutionType");
-  RETURN_CHECK( "ElectronCalibrator::initialize()", m_EgammaCalibrationAndSmearingTool->initialize(), "Failed to properly initialize the EgammaCalibrationAndSmearingTool");
-
-  // get a list of systematics
-  const CP::SystematicRegistry& systReg = CP::SystematicRegistry::getInstance();
-  const CP::SystematicSet& recSyst = (systReg.recommendedSystematics());
+  RETURN_CHECK( "ElectronCalibrator::initialize()", this->makeCalibTool( m_EgammaCalibrationAndSmearingTool, egcas_tool_name ), "");
+
+  // get a list of systematics - only the ones of this tool, the registry has
+  // those of every tool initialized so far and they would all give the nominal
+  const CP::SystematicSet recSyst = m_EgammaCalibrationAndSmearingTool->recommendedSystematics();
   Info("initialize()"," Initializing Electron Calibrator Systematics :");
   m_systList = HelperFunctions::getListofSystematics( recSyst, m_systName, m_systVal );
 
+  // discard photon systematics
+  for ( auto syst_it = m_systList.begin(); syst_it != m_systList.end(); ) {
+    if ( (syst_it->name()).find("PH_", 0) != std::string::npos ) { syst_it = m_systList.erase( syst_it ); }
+    else { ++syst_it; }
+  }
+
   if ( !m_systList.empty() ) { m_runSysts = true; }
 
+  // an instance of the tool for every further thread, no more than there are variations
+  m_EgammaCalibrationAndSmearingTools.assign( 1, m_EgammaCalibrationAndSmearingTool );
+  for ( unsigned int iTool = 1; iTool < m_systThreads && iTool < m_systList.size(); ++iTool ) {
+    CP::EgammaCalibrationAndSmearingTool* calibTool(nullptr);
+    RETURN_CHECK( "ElectronCalibrator::initialize()", this->makeCalibTool( calibTool, egcas_tool_name + "_" + std::to_string(iTool) ), "");
+    m_EgammaCalibrationAndSmearingTools.push_back( calibTool );
+  }
+
+  m_systPool = new TaskPool( m_EgammaCalibrationAndSmearingTools.size() );
+  if ( m_systPool->workers() > 1 ) { Warning("initialize()", "Evaluating the systematics with %u threads. This is experimental: the CP tools may still read the input from the threads", m_systPool->workers()); }
+
   // ****************************************************************** //
   // *
   // *
@@ -213,7 +242,7 @@ EL::StatusCode ElectronCalibrator :: initialize ()
   if ( m_systList.empty() || ( !m_systList.empty() && m_systName == "All" ) ) {
     m_systList.insert( m_systList.begin(), CP::SystematicSet() );
     const CP::SystematicVariation nullVar = CP::SystematicVariation(""); // blank = nominal
-    m_systList.back().insert(nullVar);
+    m_systList.begin()->insert(nullVar);
   }
 
   if ( m_debug ) {
@@ -222,9 +251,12 @@ EL::StatusCode ElectronCalibrator :: initialize ()
     }
   }
 
+  m_systIds.clear();
   for ( const auto& syst_it : m_systList ) {
     Info("initialize()"," Running with systematic : %s", (syst_it.name()).c_str());
+    m_systIds.push_back( SystematicIndex::instance().id( syst_it.name() ) );
   }
+  SystematicIndex::instance().declareList( m_outputAlgoSystNames, m_systIds );
 
   Info("initialize()", "ElectronCalibrator Interface succesfully initialized!" );
 
@@ -234,6 +266,8 @@ EL::StatusCode ElectronCalibrator :: initialize ()
 
 EL::StatusCode ElectronCalibrator :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -249,88 +283,80 @@ EL::StatusCode ElectronCalibrator :: execute ()
   const xAOD::ElectronContainer* inElectrons(nullptr);
   RETURN_CHECK("ElectronCalibrator::execute()", HelperFunctions::retrieve(inElectrons, m_inContainerName, m_event, m_store, m_debug) ,"");
 
-  // loop over available systematics - remember syst == EMPTY_STRING --> baseline
-  // prepare a vector of the names of CDV containers
-  // must be a pointer to be recorded in TStore
-  std::vector< std::string >* vecOutContainerNames = new std::vector< std::string >;
-
-  for ( const auto& syst_it : m_systList ) {
-
-    // discard photon systematics
-    if ( (syst_it.name()).find("PH_", 0) != std::string::npos ) { continue; }
-
-    std::string outSCContainerName(m_outSCContainerName);
-    std::string outSCAuxContainerName(m_outSCAuxContainerName);
-    std::string outContainerName(m_outContainerName);
-
-    // always append the name of the variation, including nominal which is an empty string
-    outSCContainerName    += syst_it.name();
-    outSCAuxContainerName += syst_it.name();
-    outContainerName      += syst_it.name();
-    vecOutContainerNames->push_back( syst_it.name() );
-
-    // apply syst
-    if ( m_runSysts ) {
-      if ( m_EgammaCalibrationAndSmearingTool->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
-        Error("initialize()", "Failed to configure EgammaCalibrationAndSmearingTool for systematic %s", syst_it.name().c_str());
-        return EL::StatusCode::FAILURE;
-      }
+  // create shallow copy for calibration - one per syst, the nominal included. The tool starts
+  // from the cluster and applies a systematic inside the full energy-scale and smearing
+  // computation, so each is calibrated from the input
+  // They are owned here until recorded, so that a failure on the way does not leak them
+  std::vector< std::pair< std::unique_ptr<xAOD::ElectronContainer>, std::unique_ptr<xAOD::ShallowAuxContainer> > > calibElectronsSC( m_systList.size() );
+  for ( unsigned int iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
+    std::pair< xAOD::ElectronContainer*, xAOD::ShallowAuxContainer* > electronsSC = xAOD::shallowCopyContainer( *inElectrons );
+    calibElectronsSC.at(iSyst).first.reset( electronsSC.first );
+    calibElectronsSC.at(iSyst).second.reset( electronsSC.second );
+    // TStore is not thread safe, the links are set here rather than by the threads
+    if ( !xAOD::setOriginalObjectLink(*inElectrons, *(calibElectronsSC.at(iSyst).first)) ) {
+      Error("execute()  ", "Failed to set original object links -- MET rebuilding cannot proceed.");
     }
+  }
 
-    // create shallow copy for calibration - one per syst
-    std::pair< xAOD::ElectronContainer*, xAOD::ShallowAuxContainer* > calibElectronsSC = xAOD::shallowCopyContainer( *inElectrons );
-    // create ConstDataVector to be eventually stored in TStore
-    ConstDataVector<xAOD::ElectronContainer>* calibElectronsCDV = new ConstDataVector<xAOD::ElectronContainer>(SG::VIEW_ELEMENTS);
-    calibElectronsCDV->reserve( calibElectronsSC.first->size() );
+  // the threads should not make TEvent read anything: what the calibration tool looks at,
+  // on the electrons and the clusters and tracks they link to, is read here
+  if ( m_systPool->workers() > 1 ) {
+    RETURN_CHECK("ElectronCalibrator::execute()", HelperFunctions::preloadEvent(m_event, m_store, m_debug), "");
+    std::set<const SG::AuxVectorData*> clusters, tracks;
+    for ( auto el_itr : *inElectrons ) {
+      if ( el_itr->caloCluster() )   { clusters.insert( el_itr->caloCluster()->container() ); }
+      if ( el_itr->trackParticle() ) { tracks.insert( el_itr->trackParticle()->container() ); }
+    }
+    HelperFunctions::preloadAux( inElectrons, { "pt", "eta", "phi", "m", "author" } );
+    HelperFunctions::preloadAux( clusters, { "calE", "calEta", "calPhi", "calM", "rawE", "rawEta", "rawPhi",
+                                             "altE", "altEta", "altPhi", "e_sampl", "eta_sampl", "phi_sampl" } );
+    HelperFunctions::preloadAux( tracks, { "qOverP", "theta", "phi" } );
+  }
 
-    // now calibrate!
-    unsigned int idx(0);
-    for ( auto elSC_itr : *(calibElectronsSC.first) ) {
+  // the variations are independent, each worker of the pool has its own calibration tool
+  bool systOk = m_systPool->run( m_systList.size(), [&]( unsigned int worker, unsigned int iSyst ) {
+    const CP::SystematicSet& syst_it = m_systList.at(iSyst);
+    CP::EgammaCalibrationAndSmearingTool* calibTool = m_EgammaCalibrationAndSmearingTools.at(worker);
 
-      // set smearing seeding if needed - no need for this after Base,2.1.26
-      // m_EgammaCalibrationAndSmearingTool->setRandomSeed(eventInfo->eventNumber() + 100 * idx);
+    if ( m_runSysts && calibTool->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
+      Error("execute()", "Failed to configure EgammaCalibrationAndSmearingTool for systematic %s", syst_it.name().c_str());
+      return false;
+    }
+    return this->calibrate( calibTool, calibElectronsSC.at(iSyst).first.get(), syst_it.name() ) == EL::StatusCode::SUCCESS;
+  });
+  if ( !systOk ) { return EL::StatusCode::FAILURE; }
 
-      if ( m_debug ) {
-        Info( "execute", "Checking electron %i, raw pt = %.2f GeV ", idx, (elSC_itr->pt() * 1e-3) );
-        if ( elSC_itr->pt() > 7e3 && !(elSC_itr->caloCluster()) ){
-	  Warning( "execute", "electron %i, raw pt = %.2f GeV, does not have caloCluster()! ", idx, (elSC_itr->pt() * 1e-3) );
-	}
-      }
+  // record in the order of the list, whichever thread finished first
+  for ( unsigned int iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
 
-      // apply calibration (w/ syst)
-      if ( elSC_itr->caloCluster() && elSC_itr->trackParticle() ) {  // NB: derivations might remove CC and tracks for low pt electrons
-        if ( m_EgammaCalibrationAndSmearingTool->applyCorrection( *elSC_itr ) != CP::CorrectionCode::Ok ) {
-          Error("execute()", "Problem in m_EgammaCalibrationAndSmearingTool->applyCorrection()");
-          return EL::StatusCode::FAILURE;
-        }
-      }
+    unsigned int systId = m_systIds.at(iSyst);
 
-      if ( m_debug ) { Info("execute()", "Calibrated pt with systematic: %s , pt = %.2f GeV", (syst_it).name().c_str(), (elSC_itr->pt() * 1e-3)); }
+    // add SC container to TStore, which owns it from then on
+    RETURN_CHECK( "ElectronCalibrator::execute()", HelperFunctions::record( calibElectronsSC.at(iSyst).first.get(), m_outSCKeys[systId], m_store ), "Failed to store container.");
+    xAOD::ElectronContainer* calibElectrons = calibElectronsSC.at(iSyst).first.release();
+    RETURN_CHECK( "ElectronCalibrator::execute()", HelperFunctions::record( calibElectronsSC.at(iSyst).second.get(), m_outSCAuxKeys[systId], m_store ), "Failed to store aux container.");
+    calibElectronsSC.at(iSyst).second.release();
+    m_numObject += calibElectrons->size();
 
-      ++idx;
-    } // close calibration loop
+    // create ConstDataVector to be eventually stored in TStore
+    ConstDataVector<xAOD::ElectronContainer>* calibElectronsCDV = new ConstDataVector<xAOD::ElectronContainer>(SG::VIEW_ELEMENTS);
+    calibElectronsCDV->reserve( calibElectrons->size() );
 
-    if ( !xAOD::setOriginalObjectLink(*inElectrons, *(calibElectronsSC.first)) ) {
-      Error("execute()  ", "Failed to set original object links -- MET rebuilding cannot proceed.");
-    }
+    // save pointers in ConstDataVector with same order
+    RETURN_CHECK( "ElectronCalibrator::execute()", HelperFunctions::makeSubsetCont(calibElectrons, calibElectronsCDV, "", ToolName::CALIBRATOR), "");
 
+    // can only sort the CDV - and only once it is filled
     if ( m_sort ) {
       std::sort( calibElectronsCDV->begin(), calibElectronsCDV->end(), HelperFunctions::sort_pt );
     }
 
-    // save pointers in ConstDataVector with same order
-    RETURN_CHECK( "ElectronCalibrator::execute()", HelperFunctions::makeSubsetCont(calibElectronsSC.first, calibElectronsCDV, "", ToolName::CALIBRATOR), "");
-
-    // add SC container to TStore
-    RETURN_CHECK( "ElectronCalibrator::execute()", m_store->record( calibElectronsSC.first,  outSCContainerName  ), "Failed to store container.");
-    RETURN_CHECK( "ElectronCalibrator::execute()", m_store->record( calibElectronsSC.second, outSCAuxContainerName ), "Failed to store aux container.");
     // add ConstDataVector to TStore
-    RETURN_CHECK( "ElectronCalibrator::execute()", m_store->record( calibElectronsCDV, outContainerName), "Failed to store const data container.");
+    RETURN_CHECK( "ElectronCalibrator::execute()", HelperFunctions::record( calibElectronsCDV, m_outKeys[systId], m_store ), "Failed to store const data container.");
 
   } // close loop on systematics
 
-  // add vector<string container_names_syst> to TStore
-  RETURN_CHECK( "ElectronCalibrator::execute()", m_store->record( vecOutContainerNames, m_outputAlgoSystNames), "Failed to record vector of output container names.");
+  // add the ids of the systematics to TStore
+  RETURN_CHECK( "ElectronCalibrator::execute()", SystematicIndex::instance().recordList( new std::vector< unsigned int >( m_systIds ), m_outputAlgoSystNames, m_store ), "Failed to record vector of systematic ids.");
 
   // look what do we have in TStore
   if ( m_debug ) { m_store->print(); }
@@ -338,6 +364,48 @@ EL::StatusCode ElectronCalibrator :: execute ()
   return EL::StatusCode::SUCCESS;
 }
 
+EL::StatusCode ElectronCalibrator :: makeCalibTool ( CP::EgammaCalibrationAndSmearingTool*& calibTool, const std::string& name )
+{
+  calibTool = new CP::EgammaCalibrationAndSmearingTool( name.c_str() );
+  calibTool->msg().setLevel( MSG::ERROR ); // DEBUG, VERBOSE, INFO
+  RETURN_CHECK( "ElectronCalibrator::makeCalibTool()", calibTool->setProperty("ESModel", "es2012c"),"Failed to set property ESModel");
+  RETURN_CHECK( "ElectronCalibrator::makeCalibTool()", calibTool->setProperty("ResolutionType", "SigmaEff90"),"Failed to set property ResolutionType");
+  RETURN_CHECK( "ElectronCalibrator::makeCalibTool()", calibTool->initialize(), "Failed to properly initialize the EgammaCalibrationAndSmearingTool");
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode ElectronCalibrator :: calibrate ( CP::EgammaCalibrationAndSmearingTool* calibTool, xAOD::ElectronContainer* electrons, const std::string& systName )
+{
+  unsigned int idx(0);
+  for ( auto elSC_itr : *electrons ) {
+
+    // set smearing seeding if needed - no need for this after Base,2.1.26
+    // calibTool->setRandomSeed(eventInfo->eventNumber() + 100 * idx);
+
+    if ( m_debug ) {
+      Info( "execute", "Checking electron %i, raw pt = %.2f GeV ", idx, (elSC_itr->pt() * 1e-3) );
+      if ( elSC_itr->pt() > 7e3 && !(elSC_itr->caloCluster()) ){
+        Warning( "execute", "electron %i, raw pt = %.2f GeV, does not have caloCluster()! ", idx, (elSC_itr->pt() * 1e-3) );
+      }
+    }
+
+    // apply calibration (w/ syst)
+    if ( elSC_itr->caloCluster() && elSC_itr->trackParticle() ) {  // NB: derivations might remove CC and tracks for low pt electrons
+      if ( calibTool->applyCorrection( *elSC_itr ) != CP::CorrectionCode::Ok ) {
+        Error("execute()", "Problem in EgammaCalibrationAndSmearingTool::applyCorrection()");
+        return EL::StatusCode::FAILURE;
+      }
+    }
+
+    if ( m_debug ) { Info("execute()", "Calibrated pt with systematic: %s , pt = %.2f GeV", systName.c_str(), (elSC_itr->pt() * 1e-3)); }
+
+    ++idx;
+  } // close calibration loop
+
+  return EL::StatusCode::SUCCESS;
+}
+
 EL::StatusCode ElectronCalibrator :: postExecute ()
 {
   // Here you do everything that needs to be done after the main event
@@ -353,6 +421,8 @@ EL::StatusCode ElectronCalibrator :: postExecute ()
 
 EL::StatusCode ElectronCalibrator :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -365,7 +435,13 @@ EL::StatusCode ElectronCalibrator :: finalize ()
 
   Info("finalize()", "Deleting tool instances...");
 
+  // the first of them is m_EgammaCalibrationAndSmearingTool
+  for ( unsigned int iTool = 1; iTool < m_EgammaCalibrationAndSmearingTools.size(); ++iTool ) {
+    delete m_EgammaCalibrationAndSmearingTools.at(iTool);
+  }
+  m_EgammaCalibrationAndSmearingTools.clear();
   if ( m_EgammaCalibrationAndSmearingTool ) { delete m_EgammaCalibrationAndSmearingTool; m_EgammaCalibrationAndSmearingTool = nullptr; }
+  if ( m_systPool ) { delete m_systPool; m_systPool = nullptr; }
 
   return EL::StatusCode::SUCCESS;
 }
@@ -9,6 +9,7 @@
 
 // c++ include(s):
 #include <iostream>
+#include <set>
 
 // EL include(s):
 #include <EventLoop/Job.h>
@@ -43,7 +44,8 @@ ClassImp(ElectronEfficiencyCorrector)
 
 
 ElectronEfficiencyCorrector :: ElectronEfficiencyCorrector () :
-  m_asgElectronEfficiencyCorrectionTool(nullptr)
+  m_asgElectronEfficiencyCorrectionTool(nullptr),
+  m_systPool(nullptr)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -78,6 +80,8 @@ EL::StatusCode  ElectronEfficiencyCorrector :: configure ()
     m_outputSystNames         = config->GetValue("OutputSystNames",  "ElectronEfficiencyCorrector_Syst");
     m_systVal 		      = config->GetValue("SystVal" , 0. );
     m_runAllSyst              = (m_systName.find("All") != std::string::npos);
+    // number of threads (and of efficiency tool instances) the systematics are spread over
+    m_systThreads             = config->GetValue("SystThreads", static_cast<int>(m_systThreads));
     // file(s) containing corrections
     m_corrFileName1           = config->GetValue("CorrectionFileName1" , "" );
     //m_corrFileName2         = config->GetValue("CorrectionFileName2" , "" );
@@ -94,6 +98,9 @@ EL::StatusCode  ElectronEfficiencyCorrector :: configure ()
     return EL::StatusCode::FAILURE;
   }
 
+  // the names of the containers of each systematic
+  m_inKeys = SystematicKeys( m_inContainerName );
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -124,6 +131,9 @@ EL::StatusCode ElectronEfficiencyCorrector :: histInitialize ()
   // beginning on each worker node, e.g. create histograms and output
   // trees.  This method gets called before any input files are
   // connected.
+
+  // the systematic threads need ROOT to be thread safe before the input is read
+  if ( this->configValue( "SystThreads", static_cast<int>(m_systThreads) ) > 1 ) { xAH::Algorithm::enableThreadSafety(); }
   return EL::StatusCode::SUCCESS;
 }
 
@@ -150,6 +160,8 @@ EL::StatusCode ElectronEfficiencyCorrector :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode ElectronEfficiencyCorrector :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -176,12 +188,7 @@ EL::StatusCode ElectronEfficiencyCorrector :: initialize ()
 
   // initialize the ElectronEfficiencyCorrectionTool
   std::string eec_tool_name = std::string("ElectronEfficiencyCorrectionTool_") + m_name;
-  m_asgElectronEfficiencyCorrectionTool = new AsgElectronEfficiencyCorrectionTool( eec_tool_name.c_str() );
-  m_asgElectronEfficiencyCorrectionTool->msg().setLevel( MSG::ERROR ); // DEBUG, VERBOSE, INFO
-  std::vector<std::string> inputFiles{ m_corrFileName1 } ; // initialise vector w/ all the files containing corrections
-  RETURN_CHECK( "ElectronEfficiencyCorrector::initialize()", m_asgElectronEfficiencyCorrectionTool->setProperty("CorrectionFileNameList",inputFiles),"Failed to set property CorrectionFileNameList");
-  RETURN_CHECK( "ElectronEfficiencyCorrector::initialize()", m_asgElectronEfficiencyCorrectionTool->setProperty("ForceDataType",1),"Failed to set property ForceDataType");
-  RETURN_CHECK( "ElectronEfficiencyCorrector::initialize()", m_asgElectronEfficiencyCorrectionTool->initialize(), "Failed to properly initialize the AsgElectronEfficiencyCorrectionTool");
+  RETURN_CHECK( "ElectronEfficiencyCorrector::initialize()", this->makeEffTool( m_asgElectronEfficiencyCorrectionTool, eec_tool_name ), "");
 
 
   // Get a list of systematics
@@ -200,6 +207,17 @@ EL::StatusCode ElectronEfficiencyCorrector :: initialize ()
     Info("initialize()"," Running with systematic : %s", (syst_it.name()).c_str());
   }
 
+  // an instance of the tool for every further thread, no more than there are systematics
+  m_asgElectronEfficiencyCorrectionTools.assign( 1, m_asgElectronEfficiencyCorrectionTool );
+  for ( unsigned int iTool = 1; iTool < m_systThreads && iTool < m_systList.size(); ++iTool ) {
+    AsgElectronEfficiencyCorrectionTool* effTool(nullptr);
+    RETURN_CHECK( "ElectronEfficiencyCorrector::initialize()", this->makeEffTool( effTool, eec_tool_name + "_" + std::to_string(iTool) ), "");
+    m_asgElectronEfficiencyCorrectionTools.push_back( effTool );
+  }
+
+  m_systPool = new TaskPool( m_asgElectronEfficiencyCorrectionTools.size() );
+  if ( m_systPool->workers() > 1 ) { Warning("initialize()", "Evaluating the systematics with %u threads. This is experimental: the CP tools may still read the input from the threads", m_systPool->workers()); }
+
   Info("initialize()", "ElectronEfficiencyCorrector Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -208,6 +226,8 @@ EL::StatusCode ElectronEfficiencyCorrector :: initialize ()
 
 EL::StatusCode ElectronEfficiencyCorrector :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -238,14 +258,14 @@ EL::StatusCode ElectronEfficiencyCorrector :: execute ()
   // if m_inputAlgo = NOT EMPTY --> you are retrieving syst varied containers from an upstream algo. This is the case of calibrators: one different SC
   // for each calibration syst applied
 
-	// get vector of string giving the syst names of the upstream algo m_inputAlgo (rememeber: 1st element is a blank string: nominal case!)
-        std::vector<std::string>* systNames(nullptr);
-        RETURN_CHECK("ElectronEfficiencyCorrector::execute()", HelperFunctions::retrieve(systNames, m_inputAlgoSystNames, 0, m_store, m_debug) ,"");
+	// get vector of the ids of the systematics of the upstream algo m_inputAlgo (see SystematicIndex, 0 is nominal)
+        std::vector<unsigned int>* systIds(nullptr);
+        RETURN_CHECK("ElectronEfficiencyCorrector::execute()", HelperFunctions::retrieve(systIds, SystematicIndex::idsKey( m_inputAlgoSystNames ), 0, m_store, m_debug) ,"");
 
     	// loop over systematic sets available
-    	for ( auto systName : *systNames ) {
+    	for ( auto systId : *systIds ) {
 
-           RETURN_CHECK("ElectronEfficiencyCorrector::execute()", HelperFunctions::retrieve(inputElectrons, m_inContainerName+systName, m_event, m_store, m_debug) ,"");
+           RETURN_CHECK("ElectronEfficiencyCorrector::execute()", HelperFunctions::retrieve(inputElectrons, m_inKeys[systId], m_event, m_store, m_debug) ,"");
 
     	   if ( m_debug ){
     	     unsigned int idx(0);
@@ -287,6 +307,8 @@ EL::StatusCode ElectronEfficiencyCorrector :: postExecute ()
 
 EL::StatusCode ElectronEfficiencyCorrector :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -299,9 +321,17 @@ EL::StatusCode ElectronEfficiencyCorrector :: finalize ()
 
   Info("finalize()", "Deleting tool instances...");
 
+  // the first of them is m_asgElectronEfficiencyCorrectionTool
+  for ( unsigned int iTool = 1; iTool < m_asgElectronEfficiencyCorrectionTools.size(); ++iTool ) {
+    delete m_asgElectronEfficiencyCorrectionTools.at(iTool);
+  }
+  m_asgElectronEfficiencyCorrectionTools.clear();
   if ( m_asgElectronEfficiencyCorrectionTool ) {
     delete m_asgElectronEfficiencyCorrectionTool; m_asgElectronEfficiencyCorrectionTool = nullptr;
   }
+  if ( m_systPool ) {
+    delete m_systPool; m_systPool = nullptr;
+  }
 
   return EL::StatusCode::SUCCESS;
 }
@@ -326,6 +356,18 @@ EL::StatusCode ElectronEfficiencyCorrector :: histFinalize ()
   return EL::StatusCode::SUCCESS;
 }
 
+EL::StatusCode ElectronEfficiencyCorrector :: makeEffTool ( AsgElectronEfficiencyCorrectionTool*& effTool, const std::string& name )
+{
+  effTool = new AsgElectronEfficiencyCorrectionTool( name.c_str() );
+  effTool->msg().setLevel( MSG::ERROR ); // DEBUG, VERBOSE, INFO
+  std::vector<std::string> inputFiles{ m_corrFileName1 } ; // initialise vector w/ all the files containing corrections
+  RETURN_CHECK( "ElectronEfficiencyCorrector::makeEffTool()", effTool->setProperty("CorrectionFileNameList",inputFiles),"Failed to set property CorrectionFileNameList");
+  RETURN_CHECK( "ElectronEfficiencyCorrector::makeEffTool()", effTool->setProperty("ForceDataType",1),"Failed to set property ForceDataType");
+  RETURN_CHECK( "ElectronEfficiencyCorrector::makeEffTool()", effTool->initialize(), "Failed to properly initialize the AsgElectronEfficiencyCorrectionTool");
+
+  return EL::StatusCode::SUCCESS;
+}
+
 EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronContainer* inputElectrons, unsigned int countSyst  )
 {
 
@@ -351,62 +393,103 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
     if(m_debug) Info("execute()", "SF decoration name is: %s", sfName.c_str());
     sysVariationNames->push_back(sfName);
 
-    // apply syst
-    if ( m_asgElectronEfficiencyCorrectionTool->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
-      Error("initialize()", "Failed to configure AsgElectronEfficiencyCorrectionTool for systematic %s", syst_it.name().c_str());
+  }
+
+  //
+  // the electrons that get a SF - the acceptance is the same for all systematics
+  //
+  std::vector< const xAOD::Electron* > sfElectrons;
+  unsigned int idx(0);
+  for ( auto el_itr : *(inputElectrons) ) {
+
+     if ( m_debug ) { Info( "execute", "Checking electron %i, pt = %.2f GeV ", idx, (el_itr->pt() * 1e-3) ); }
+     ++idx;
+
+     // NB: derivations might remove CC and tracks for low pt electrons
+     if ( !(el_itr->caloCluster() && el_itr->trackParticle()) ) {
+       if ( m_debug ) { Info( "execute", "Apply SF: skipping electron %i, it has no caloCluster or trackParticle info", idx); }
+       continue;
+     }
+
+     // skip electron if outside acceptance for SF calculation
+     if ( el_itr->pt() < 7e3 ) {
+       if ( m_debug ) { Info( "execute", "Apply SF: skipping electron %i, is outside pT acceptance", idx); }
+       continue;
+     }
+     if ( fabs( el_itr->caloCluster()->eta() ) > 2.47 ) {
+       if ( m_debug ) { Info( "execute", "Apply SF: skipping electron %i, is outside |eta| acceptance", idx); }
+       continue;
+     }
+
+     sfElectrons.push_back( el_itr );
+  }
+
+  //
+  // the threads should not make TEvent read anything: what the tool looks at, on the
+  // electrons and the clusters they link to (followed above), is read here
+  //
+  if ( m_systPool->workers() > 1 ) {
+    if ( !HelperFunctions::preloadEvent(m_event, m_store, m_debug).isSuccess() ) {
+      delete sysVariationNames;
       return EL::StatusCode::FAILURE;
     }
-    if ( m_debug ) { Info("execute()", "Successfully applied systematic: %s", m_asgElectronEfficiencyCorrectionTool->appliedSystematics().name().c_str()); }
-
-    // and now apply efficiency SF!
-    unsigned int idx(0);
-    for ( auto el_itr : *(inputElectrons) ) {
-
-       //
-       //  If SF decoration vector doesn't exist, create it (will be done only for the 1st systematic for *this* electron)
-       //
-       SG::AuxElement::Decorator< std::vector<double> > sfVec( m_outputSystNames );
-       if ( !sfVec.isAvailable( *el_itr ) ) {
-	 sfVec( *el_itr ) = std::vector<double>();
-       }
-
-       if ( m_debug ) { Info( "execute", "Checking electron %i, pt = %.2f GeV ", idx, (el_itr->pt() * 1e-3) ); }
-       ++idx;
-
-       // NB: derivations might remove CC and tracks for low pt electrons
-       if ( !(el_itr->caloCluster() && el_itr->trackParticle()) ) {
-         if ( m_debug ) { Info( "execute", "Apply SF: skipping electron %i, it has no caloCluster or trackParticle info", idx); }
-         continue;
-       }
-
-       // skip electron if outside acceptance for SF calculation
-       if ( el_itr->pt() < 7e3 ) {
-         if ( m_debug ) { Info( "execute", "Apply SF: skipping electron %i, is outside pT acceptance", idx); }
-         continue;
-       }
-       if ( fabs( el_itr->caloCluster()->eta() ) > 2.47 ) {
-         if ( m_debug ) { Info( "execute", "Apply SF: skipping electron %i, is outside |eta| acceptance", idx); }
-         continue;
-       }
-
-       //
-       // obtain efficiency SF
-       //
-       double SF(0.0);
-       if ( m_asgElectronEfficiencyCorrectionTool->getEfficiencyScaleFactor( *el_itr, SF ) != CP::CorrectionCode::Ok ) {
-         Error( "execute()", "Problem in getEfficiencyScaleFactor");
-         return EL::StatusCode::FAILURE;
-       }
-       //
-       // Add it to decoration vector
-       //
-       sfVec( *el_itr ).push_back(SF);
-
-       if ( m_debug ) { Info( "execute", "===>>> Resulting SF: %f for systematic: %s ", SF, syst_it.name().c_str()); }
-
-    } // close electron loop
-
-  }  // close loop on systematics
+    std::set<const SG::AuxVectorData*> electrons, clusters;
+    for ( auto el_itr : sfElectrons ) {
+      electrons.insert( el_itr->container() );
+      clusters.insert( el_itr->caloCluster()->container() );
+    }
+    HelperFunctions::preloadAux( electrons, { "pt", "eta", "phi", "m" } );
+    HelperFunctions::preloadAux( clusters, { "calE", "calEta", "calPhi", "e_sampl", "eta_sampl" } );
+  }
+
+  //
+  // obtain efficiency SF - the systematics are independent, each worker of the pool has its own tool
+  //
+  std::vector< std::vector<double> > SFs( m_systList.size(), std::vector<double>( sfElectrons.size(), 0.0 ) );
+  bool systOk = m_systPool->run( m_systList.size(), [&]( unsigned int worker, unsigned int iSyst ) {
+
+    const CP::SystematicSet& syst_it = m_systList.at(iSyst);
+    AsgElectronEfficiencyCorrectionTool* effTool = m_asgElectronEfficiencyCorrectionTools.at(worker);
+
+    // apply syst
+    if ( effTool->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
+      Error("execute()", "Failed to configure AsgElectronEfficiencyCorrectionTool for systematic %s", syst_it.name().c_str());
+      return false;
+    }
+    if ( m_debug ) { Info("execute()", "Successfully applied systematic: %s", effTool->appliedSystematics().name().c_str()); }
+
+    for ( unsigned int iEl = 0; iEl < sfElectrons.size(); ++iEl ) {
+      if ( effTool->getEfficiencyScaleFactor( *(sfElectrons.at(iEl)), SFs.at(iSyst).at(iEl) ) != CP::CorrectionCode::Ok ) {
+        Error( "execute()", "Problem in getEfficiencyScaleFactor");
+        return false;
+      }
+    }
+    return true;
+  });
+  if ( !systOk ) {
+    delete sysVariationNames;
+    return EL::StatusCode::FAILURE;
+  }
+
+  //
+  //  If SF decoration vector doesn't exist, create it - for all electrons, also those w/o SF
+  //
+  SG::AuxElement::Decorator< std::vector<double> > sfVec( m_outputSystNames );
+  for ( auto el_itr : *(inputElectrons) ) {
+    if ( !sfVec.isAvailable( *el_itr ) ) {
+      sfVec( *el_itr ) = std::vector<double>();
+    }
+  }
+
+  //
+  // Add them to the decoration vector, in the order of the systematics
+  //
+  for ( unsigned int iEl = 0; iEl < sfElectrons.size(); ++iEl ) {
+    for ( unsigned int iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
+      sfVec( *(sfElectrons.at(iEl)) ).push_back( SFs.at(iSyst).at(iEl) );
+      if ( m_debug ) { Info( "execute", "===>>> Resulting SF: %f for systematic: %s ", SFs.at(iSyst).at(iEl), m_systList.at(iSyst).name().c_str()); }
+    }
+  }
 
   //
   // add list of efficiency systematics names to TStore
@@ -417,7 +500,8 @@ EL::StatusCode ElectronEfficiencyCorrector :: executeSF (  const xAOD::ElectronC
   //
   // Use the counter defined in execute() to check this is done only once
   //
-  if ( countSyst == 0 ) { RETURN_CHECK( "ElectronEfficiencyCorrector::execute()", m_store->record( sysVariationNames, m_outputSystNames), "Failed to record vector of systematic names" ); }
+  if ( countSyst == 0 ) { RETURN_CHECK( "ElectronEfficiencyCorrector::execute()", HelperFunctions::record( sysVariationNames, m_outputSystNames, m_store ), "Failed to record vector of systematic names" ); }
+  else { delete sysVariationNames; }
 
   return EL::StatusCode::SUCCESS;
 }
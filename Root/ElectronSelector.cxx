@@ -47,6 +47,7 @@ ClassImp(ElectronSelector)
 ElectronSelector :: ElectronSelector () :
   m_cutflowHist(nullptr),
   m_cutflowHistW(nullptr),
+  m_passSelDecor(nullptr),
   m_IsolationSelectionTool(nullptr),
   m_ElectronIsolationSelectionTool(nullptr),
   m_el_LH_PIDManager(nullptr),
@@ -121,6 +122,12 @@ EL::StatusCode  ElectronSelector :: configure ()
     m_CutBasedOperatingPoint  = config->GetValue("CutBasedOperatingPoint", "IsEMLoose");
     m_CutBasedConfigYear      = config->GetValue("CutBasedConfigYear", "2012");
 
+    // the WPs tighter than the selected one to decorate (comma separated, all if empty), and whether
+    // to decorate them 0 w/o calling their tool once a looser one fails
+    m_LHDecorWPs              = config->GetValue("LHDecorWPs", "");
+    m_CutBasedDecorWPs        = config->GetValue("CutBasedDecorWPs", "");
+    m_PIDShortCircuit         = config->GetValue("PIDShortCircuit", true);
+
     // isolation stuff
     m_doIsolation             = config->GetValue("DoIsolationCut"    ,  false);
     m_IsoWP		      = config->GetValue("IsolationWP"       ,  "Tight");
@@ -135,6 +142,10 @@ EL::StatusCode  ElectronSelector :: configure ()
     m_passAuxDecorKeys        = config->GetValue("PassDecorKeys", "");
     m_failAuxDecorKeys        = config->GetValue("FailDecorKeys", "");
 
+    // run the cheapest cuts per rejected electron first, as measured on the first CutOrderWarmup electrons
+    m_adaptiveCutOrder        = config->GetValue("AdaptiveCutOrder", false);
+    m_cutOrderWarmup          = config->GetValue("CutOrderWarmup",   1000);
+
     config->Print();
 
     Info("configure()", "ElectronSelector Interface succesfully configured! ");
@@ -147,6 +158,10 @@ EL::StatusCode  ElectronSelector :: configure ()
     return EL::StatusCode::FAILURE;
   }
 
+  // the names of the containers of each systematic
+  m_inKeys  = SystematicKeys( m_inContainerName );
+  m_outKeys = SystematicKeys( m_outContainerName );
+
   m_outAuxContainerName     = m_outContainerName + "Aux."; // the period is very important!
   if ( m_LHOperatingPoint != "VeryLoose" &&
        m_LHOperatingPoint != "Loose"     &&
@@ -177,6 +192,32 @@ EL::StatusCode  ElectronSelector :: configure ()
     m_failKeys.push_back(token);
   }
 
+  ss.clear();
+  ss.str(m_LHDecorWPs);
+  while ( std::getline(ss, token, ',') ) {
+    LikeEnum::Menu menu;
+    if ( !HelperClasses::EnumParser<LikeEnum::Menu>::find( token, menu ) ) {
+      Error("configure()", "Unknown electron likelihood PID requested for decoration %s!", token.c_str());
+      return EL::StatusCode::FAILURE;
+    }
+    m_LHDecorWPList.push_back(token);
+  }
+
+  ss.clear();
+  ss.str(m_CutBasedDecorWPs);
+  while ( std::getline(ss, token, ',') ) {
+    egammaPID::PID pid;
+    if ( !HelperClasses::EnumParser<egammaPID::PID>::find( token, pid ) ) {
+      Error("configure()", "Unknown electron cut-based PID requested for decoration %s!", token.c_str());
+      return EL::StatusCode::FAILURE;
+    }
+    m_CutBasedDecorWPList.push_back(token);
+  }
+
+  m_passSelDecor = &AuxHandles<char>::decorator( "passSel" );
+
+  this->buildCuts();
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -250,6 +291,8 @@ EL::StatusCode ElectronSelector :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode ElectronSelector :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -287,13 +330,22 @@ EL::StatusCode ElectronSelector :: initialize ()
   std::string cutbasedWP = ( m_doCutBasedPIDcut ) ? m_CutBasedOperatingPoint : "IsEMLoose";
   m_el_CutBased_PIDManager = new ElectronCutBasedPIDManager( cutbasedWP );
   if ( m_debug ) { Info("initialize()", "Selected cut-based WP: %s", (m_el_CutBased_PIDManager->getSelectedWP()).c_str() ); }
-  RETURN_CHECK( "ElectronSelector::initialize()", m_el_CutBased_PIDManager->setupTools( confDir, m_CutBasedConfigYear ), "Failed to properly setup ElectronCutBasedPIDManager." );
+  RETURN_CHECK( "ElectronSelector::initialize()", m_el_CutBased_PIDManager->setupTools( confDir, m_CutBasedConfigYear, m_CutBasedDecorWPList ), "Failed to properly setup ElectronCutBasedPIDManager." );
+  m_el_CutBased_PIDManager->setShortCircuit( m_PIDShortCircuit );
 
   // if not using LH PID, make sure all the decorations will be set ... by choosing the loosest WP!
   std::string likelihoodWP = ( m_doLHPIDcut ) ? m_LHOperatingPoint : "VeryLoose";
   m_el_LH_PIDManager = new ElectronLHPIDManager( likelihoodWP );
   if ( m_debug ) { Info("initialize()", "Selected LH WP: %s", (m_el_LH_PIDManager->getSelectedWP()).c_str() ); }
-  RETURN_CHECK( "ElectronSelector::initialize()", m_el_LH_PIDManager->setupTools( confDir, m_LHConfigYear ), "Failed to properly setup ElectronLHPIDManager." );
+  RETURN_CHECK( "ElectronSelector::initialize()", m_el_LH_PIDManager->setupTools( confDir, m_LHConfigYear, m_LHDecorWPList ), "Failed to properly setup ElectronLHPIDManager." );
+  m_el_LH_PIDManager->setShortCircuit( m_PIDShortCircuit );
+
+  if ( m_debug ) {
+    const PIDWorkingPoints< AsgElectronIsEMSelector >& cutBasedWPs = m_el_CutBased_PIDManager->getWorkingPoints();
+    for ( unsigned int i = 0; i < cutBasedWPs.tools(); ++i ) { Info("initialize()", "Decorating electrons with decision for cut-based WP : %s", cutBasedWPs.decorName(i).c_str() ); }
+    const PIDWorkingPoints< AsgElectronLikelihoodTool >& likelihoodWPs = m_el_LH_PIDManager->getWorkingPoints();
+    for ( unsigned int i = 0; i < likelihoodWPs.tools(); ++i ) { Info("initialize()", "Decorating electrons with decision for LH WP : %s", likelihoodWPs.decorName(i).c_str() ); }
+  }
 
   // initialise IsolationSelectionTool ( and ElectronIsolationTool, for DC14 )
 
@@ -307,9 +359,8 @@ EL::StatusCode ElectronSelector :: initialize ()
   if ( m_IsoWP == "CutBasedDC14" ) {
 
     m_ElectronIsolationSelectionTool->msg().setLevel( MSG::ERROR); // ERROR, VERBOSE, DEBUG, INFO
-    HelperClasses::EnumParser<xAOD::Iso::IsolationType> isoParser;
-    RETURN_CHECK( "ElectronSelector::initialize()", m_ElectronIsolationSelectionTool->configureCutBasedIsolation( isoParser.parseEnum(m_CaloBasedIsoType),   static_cast<float>(m_CaloBasedIsoCut),  m_useRelativeIso ), "Failed to configure Calo-Based Isolation Cut");
-    RETURN_CHECK( "ElectronSelector::initialize()", m_ElectronIsolationSelectionTool->configureCutBasedIsolation( isoParser.parseEnum(m_TrackBasedIsoType),  static_cast<float>(m_TrackBasedIsoCut), m_useRelativeIso ), "Failed to configure Track-Based Isolation Cut");
+    RETURN_CHECK( "ElectronSelector::initialize()", m_ElectronIsolationSelectionTool->configureCutBasedIsolation( HelperClasses::EnumParser<xAOD::Iso::IsolationType>::parseEnum(m_CaloBasedIsoType),   static_cast<float>(m_CaloBasedIsoCut),  m_useRelativeIso ), "Failed to configure Calo-Based Isolation Cut");
+    RETURN_CHECK( "ElectronSelector::initialize()", m_ElectronIsolationSelectionTool->configureCutBasedIsolation( HelperClasses::EnumParser<xAOD::Iso::IsolationType>::parseEnum(m_TrackBasedIsoType),  static_cast<float>(m_TrackBasedIsoCut), m_useRelativeIso ), "Failed to configure Track-Based Isolation Cut");
 
     RETURN_CHECK( "ElectronSelector::initialize()", m_ElectronIsolationSelectionTool->initialize(), "Failed to properly initialize ElectronIsolationSelectionTool." );
 
@@ -330,6 +381,9 @@ EL::StatusCode ElectronSelector :: initialize ()
 
   }
 
+  // the systematics we pass on are some of those we get
+  if ( !m_inputAlgoSystNames.empty() ) { SystematicIndex::instance().forwardList( m_inputAlgoSystNames, m_outputAlgoSystNames ); }
+
   Info("initialize()", "ElectronSelector Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -337,6 +391,8 @@ EL::StatusCode ElectronSelector :: initialize ()
 
 EL::StatusCode ElectronSelector :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -381,7 +437,7 @@ EL::StatusCode ElectronSelector :: execute ()
     if ( m_createSelectedContainer) {
       if ( eventPass ) {
         // add ConstDataVector to TStore
-        RETURN_CHECK( "ElectronSelector::execute()", m_store->record( selectedElectrons, m_outContainerName ), "Failed to store const data container");
+        RETURN_CHECK( "ElectronSelector::execute()", HelperFunctions::record( selectedElectrons, m_outContainerName, m_store ), "Failed to store const data container");
       } else {
         // if the event does not pass the selection, CDV won't be ever recorded to TStore, so we have to delete it!
         delete selectedElectrons; selectedElectrons = nullptr;
@@ -390,22 +446,22 @@ EL::StatusCode ElectronSelector :: execute ()
 
   } else { // get the list of systematics to run over
 
-    // get vector of string giving the syst names of the upstream algo from TStore (rememeber: 1st element is a blank string: nominal case!)
-    std::vector< std::string >* systNames(nullptr);
-    RETURN_CHECK("ElectronSelector::execute()", HelperFunctions::retrieve(systNames, m_inputAlgoSystNames, 0, m_store, m_debug) ,"");
+    // get vector of the ids of the systematics of the upstream algo from TStore (see SystematicIndex, 0 is nominal)
+    std::vector< unsigned int >* systIds(nullptr);
+    RETURN_CHECK("ElectronSelector::execute()", HelperFunctions::retrieve(systIds, SystematicIndex::idsKey( m_inputAlgoSystNames ), 0, m_store, m_debug) ,"");
 
-    // prepare a vector of the names of CDV containers for usage by downstream algos
+    // prepare a vector of the ids of the CDV containers for usage by downstream algos
     // must be a pointer to be recorded in TStore
-    std::vector< std::string >* vecOutContainerNames = new std::vector< std::string >;
-    if ( m_debug ) { Info("execute()", " input list of syst size: %i ", static_cast<int>(systNames->size()) ); }
+    std::vector< unsigned int >* outSystIds = new std::vector< unsigned int >;
+    if ( m_debug ) { Info("execute()", " input list of syst size: %i ", static_cast<int>(systIds->size()) ); }
 
     // loop over systematic sets
     bool eventPassThisSyst(false);
-    for ( auto systName : *systNames ) {
+    for ( auto systId : *systIds ) {
 
-      if ( m_debug ) { Info("execute()", " syst name: %s  input container name: %s ", systName.c_str(), (m_inContainerName+systName).c_str() ); }
+      if ( m_debug ) { Info("execute()", " syst name: %s  input container name: %s ", SystematicIndex::instance().name(systId).c_str(), m_inKeys[systId].c_str() ); }
 
-      RETURN_CHECK("ElectronSelector::execute()", HelperFunctions::retrieve(inElectrons, m_inContainerName + systName, m_event, m_store, m_debug) ,"");
+      RETURN_CHECK("ElectronSelector::execute()", HelperFunctions::retrieve(inElectrons, m_inKeys[systId], m_event, m_store, m_debug) ,"");
 
       // create output container (if requested) - one for each systematic
       ConstDataVector<xAOD::ElectronContainer>* selectedElectrons(nullptr);
@@ -417,19 +473,19 @@ EL::StatusCode ElectronSelector :: execute ()
       if ( countPass ) { countPass = false; } // only count objects/events for 1st syst collection in iteration (i.e., nominal)
 
       if ( eventPassThisSyst ) {
-	// save the string of syst set under question if event is passing the selection
-	vecOutContainerNames->push_back( systName );
+	// save the id of syst set under question if event is passing the selection
+	outSystIds->push_back( systId );
       }
 
       // if for at least one syst set the event passes selection, this will remain true!
       eventPass = ( eventPass || eventPassThisSyst );
 
-      if ( m_debug ) { Info("execute()", " syst name: %s  output container name: %s ", systName.c_str(), (m_outContainerName+systName).c_str() ); }
+      if ( m_debug ) { Info("execute()", " syst name: %s  output container name: %s ", SystematicIndex::instance().name(systId).c_str(), m_outKeys[systId].c_str() ); }
 
       if ( m_createSelectedContainer ) {
         if ( eventPassThisSyst ) {
           // add ConstDataVector to TStore
-          RETURN_CHECK( "ElectronSelector::execute()", m_store->record( selectedElectrons, m_outContainerName+systName ), "Failed to store const data container");
+          RETURN_CHECK( "ElectronSelector::execute()", HelperFunctions::record( selectedElectrons, m_outKeys[systId], m_store ), "Failed to store const data container");
         } else {
           // if the event does not pass the selection for this syst, CDV won't be ever recorded to TStore, so we have to delete it!
           delete selectedElectrons; selectedElectrons = nullptr;
@@ -438,10 +494,10 @@ EL::StatusCode ElectronSelector :: execute ()
 
     } // close loop over syst sets
 
-    if ( m_debug ) {  Info("execute()", " output list of syst size: %i ", static_cast<int>(vecOutContainerNames->size()) ); }
+    if ( m_debug ) {  Info("execute()", " output list of syst size: %i ", static_cast<int>(outSystIds->size()) ); }
 
-    // record in TStore the list of systematics names that should be considered down stream
-    RETURN_CHECK( "ElectronSelector::execute()", m_store->record( vecOutContainerNames, m_outputAlgoSystNames), "Failed to record vector of output container names.");
+    // record in TStore the list of systematics that should be considered down stream
+    RETURN_CHECK( "ElectronSelector::execute()", SystematicIndex::instance().recordList( outSystIds, m_outputAlgoSystNames, m_store ), "Failed to record vector of systematic ids.");
 
   }
 
@@ -466,7 +522,7 @@ bool ElectronSelector :: executeSelection ( const xAOD::ElectronContainer* inEle
   const xAOD::Vertex *pvx = HelperFunctions::getPrimaryVertex(vertices);
 
   int nPass(0); int nObj(0);
-  static SG::AuxElement::Decorator< char > passSelDecor( "passSel" );
+  const SG::AuxElement::Decorator< char >& passSelDecor = *m_passSelDecor;
 
   for ( auto el_itr : *inElectrons ) { // duplicated of basic loop
 
@@ -534,6 +590,8 @@ EL::StatusCode ElectronSelector :: postExecute ()
 
 EL::StatusCode ElectronSelector :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -544,6 +602,8 @@ EL::StatusCode ElectronSelector :: finalize ()
   // merged.  This is different from histFinalize() in that it only
   // gets called on worker nodes that processed input events.
 
+  m_cuts.print( m_name );
+
   Info("finalize()", "Deleting tool instances...");
 
   if ( m_el_CutBased_PIDManager )         { delete m_el_CutBased_PIDManager; m_el_CutBased_PIDManager = nullptr; }
@@ -580,142 +640,114 @@ EL::StatusCode ElectronSelector :: histFinalize ()
   return EL::StatusCode::SUCCESS;
 }
 
-int ElectronSelector :: PassCuts( const xAOD::Electron* electron, const xAOD::Vertex *primaryVertex ) {
+void ElectronSelector :: buildCuts() {
 
-  // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/EGammaIdentificationRun2
+  typedef const xAOD::Electron* El;
+  typedef const xAOD::Vertex*   Vtx;
 
-  float et    = electron->pt();
-  float eta   = electron->eta();
+  m_cuts.clear();
 
-  int oq      = static_cast<int>( electron->auxdata<uint32_t>("OQ") & 1446 );
-
-  // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/InDetTrackingDC14
-
-  const xAOD::TrackParticle* tp  = electron->trackParticle();
-
-  float d0_significance = fabs( tp->d0() ) / sqrt(tp->definingParametersCovMatrix()(0,0) );
-  float z0sintheta      = ( tp->z0() + tp->vz() - primaryVertex->z() ) * sin( tp->theta() );
+  // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/EGammaIdentificationRun2
 
   // author cut
   if ( m_doAuthorCut ) {
-    if ( !( electron->author(xAOD::EgammaParameters::AuthorElectron) || electron->author(xAOD::EgammaParameters::AuthorAmbiguous) ) ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed author kinematic cut." ); }
-      return 0;
-    }
+    m_cuts.add( "author", []( El electron, Vtx ) {
+      return ( electron->author(xAOD::EgammaParameters::AuthorElectron) || electron->author(xAOD::EgammaParameters::AuthorAmbiguous) );
+    });
   }
   // Object Quality cut
   if ( m_doOQCut ) {
-    if ( !(oq == 0) ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed Object Quality cut." ); }
-      return 0;
-    }
+    const AuxHandles<uint32_t>::Accessor& oqAcc = AuxHandles<uint32_t>::accessor( "OQ" );
+    m_cuts.add( "Object Quality", [&oqAcc]( El electron, Vtx ) {
+      int oq = static_cast<int>( oqAcc( *electron ) & 1446 );
+      return ( oq == 0 );
+    }, false );
   }
   // pT max
   if ( m_pT_max != 1e8 ) {
-    if ( et > m_pT_max ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed pT max cut." ); }
-      return 0;
-    }
+    m_cuts.add( "pT max", [this]( El electron, Vtx ) { return !( electron->pt() > m_pT_max ); } );
   }
   // pT min
   if ( m_pT_min != 1e8 ) {
-    if ( et < m_pT_min ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed pT min cut." ); }
-      return 0;
-    }
+    m_cuts.add( "pT min", [this]( El electron, Vtx ) { return !( electron->pt() < m_pT_min ); } );
   }
   // |eta| max
   if ( m_eta_max != 1e8 ) {
-    if ( fabs(eta) > m_eta_max ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed |eta| max cut." ); }
-      return 0;
-    }
+    m_cuts.add( "|eta| max", [this]( El electron, Vtx ) { return !( fabs(electron->eta()) > m_eta_max ); } );
   }
   // |eta| crack veto
   if ( m_vetoCrack ) {
-    if ( electron->caloCluster() ){
-      if ( fabs( electron->caloCluster()->eta() ) > 1.37 && fabs( electron->caloCluster()->eta() ) < 1.52 ) {
-        if ( m_debug ) { Info("PassCuts()", "Electron failed |eta| crack veto cut." ); }
-        return 0;
-      }
-    }
+    m_cuts.add( "|eta| crack veto", []( El electron, Vtx ) {
+      if ( !electron->caloCluster() ) { return true; }
+      return !( fabs( electron->caloCluster()->eta() ) > 1.37 && fabs( electron->caloCluster()->eta() ) < 1.52 );
+    });
   }
+
+  // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/InDetTrackingDC14
+
   // d0 cut
-  if ( !( tp->d0() < m_d0_max ) ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed d0 cut."); }
-      return 0;
-  }
+  m_cuts.add( "d0", [this]( El electron, Vtx ) { return ( electron->trackParticle()->d0() < m_d0_max ); } );
   // d0sig cut
-  if ( !( d0_significance < m_d0sig_max ) ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed d0 significance cut."); }
-      return 0;
-  }
+  m_cuts.add( "d0 significance", [this]( El electron, Vtx ) {
+    const xAOD::TrackParticle* tp = electron->trackParticle();
+    float d0_significance = fabs( tp->d0() ) / sqrt(tp->definingParametersCovMatrix()(0,0) );
+    return ( d0_significance < m_d0sig_max );
+  });
   // z0*sin(theta) cut
-  if ( !( fabs(z0sintheta) < m_z0sintheta_max ) ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed z0*sin(theta) cut." ); }
-      return 0;
-  }
+  m_cuts.add( "z0*sin(theta)", [this]( El electron, Vtx primaryVertex ) {
+    const xAOD::TrackParticle* tp = electron->trackParticle();
+    float z0sintheta = ( tp->z0() + tp->vz() - primaryVertex->z() ) * sin( tp->theta() );
+    return ( fabs(z0sintheta) < m_z0sintheta_max );
+  }, false );
+
+  //
+  // PID and isolation decorate every electron that gets this far, so they
+  // keep their place at the end, in this order, whatever the order above
+  // (after the OQ and z0 cuts, which read a decoration and the vertex)
+  //
 
   //
   // likelihood PID
   //
+  m_cuts.add( "likelihood PID", [this]( El electron, Vtx ) {
 
-  // set default values for *this* electron decorations
-  m_el_LH_PIDManager->setDecorations( electron );
-
-  // retrieve only tools with WP >= selected WP, cut electrons if not satisfying selected WP, and decorate w/ tool decision all the others
-  
-  typedef std::multimap< std::string, AsgElectronLikelihoodTool* > LHToolsMap;
-  LHToolsMap myLHTools = m_el_LH_PIDManager->getValidTools();
-  
-  if ( m_doLHPIDcut && !( ( myLHTools.find( m_LHOperatingPoint )->second )->accept( *electron ) ) ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed likelihood PID cut." ); }
-      return 0;
-  }
-  
-  for ( auto it : (myLHTools) ) {
-    
-    const std::string decorWP = it.second->getOperatingPointName( );
-    
-    if ( m_debug ) { Info("PassCuts()", "Decorating electron with decison for LH WP : %s ", ( decorWP ).c_str() ); }
-    
-    electron->auxdecor<char>(decorWP) = static_cast<char>( it.second->accept( *electron ) );
-  }
+    // set default values for *this* electron decorations
+    m_el_LH_PIDManager->setDecorations( electron );
+
+    // cut electrons if not satisfying selected WP, and decorate w/ tool decision the tighter ones
+    return m_el_LH_PIDManager->evaluate( electron, m_doLHPIDcut );
+  }, false );
 
   //
   // cut-based PID
   //
-  
-  // set default values for *this* electron decorations
-  m_el_CutBased_PIDManager->setDecorations( electron );
-  
-  // retrieve only tools with WP >= selected WP, cut electrons if not satisfying selected WP, and decorate w/ tool decision all the others
-  
-  typedef std::multimap< std::string, AsgElectronIsEMSelector* > CutBasedToolsMap;
-  CutBasedToolsMap myCutBasedTools = m_el_CutBased_PIDManager->getValidTools();
-
-  if ( m_doCutBasedPIDcut && !( ( myCutBasedTools.find( m_CutBasedOperatingPoint )->second )->accept( *electron ) ) ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed cut-based PID cut." ); }
-      return 0;
-  }
+  m_cuts.add( "cut-based PID", [this]( El electron, Vtx ) {
 
-  for ( auto it : (myCutBasedTools) ) {
-    
-    const std::string decorWP = it.second->getOperatingPointName( );
-    
-    if ( m_debug ) { Info("PassCuts()", "Decorating electron with decison for cut-based WP : %s ", ( decorWP ).c_str() ); }
-    
-    electron->auxdecor<char>(decorWP) = static_cast<char>( it.second->accept( *electron ) );
-  }
+    // set default values for *this* electron decorations
+    m_el_CutBased_PIDManager->setDecorations( electron );
+
+    // cut electrons if not satisfying selected WP, and decorate w/ tool decision the tighter ones
+    return m_el_CutBased_PIDManager->evaluate( electron, m_doCutBasedPIDcut );
+  }, false );
 
   // isolation
-  static SG::AuxElement::Decorator< char > isIsoDecor("isIsolated");
-  bool passIso = ( m_IsolationSelectionTool->accept( *electron ) );
-  isIsoDecor( *electron ) = ( passIso ) ? 1 : 0;
+  m_cuts.add( "isolation", [this]( El electron, Vtx ) {
+    static SG::AuxElement::Decorator< char > isIsoDecor("isIsolated");
+    bool passIso = ( m_IsolationSelectionTool->accept( *electron ) );
+    isIsoDecor( *electron ) = ( passIso ) ? 1 : 0;
+
+    return !( m_doIsolation && !passIso );
+  }, false );
+
+  m_cuts.setAdaptive( m_adaptiveCutOrder, m_cutOrderWarmup );
+}
+
+int ElectronSelector :: PassCuts( const xAOD::Electron* electron, const xAOD::Vertex *primaryVertex ) {
 
-  if ( m_doIsolation && !passIso ) {
-      if ( m_debug ) { Info("PassCuts()", "Electron failed isolation cut." ); }
-      return 0;
+  int failed = m_cuts.firstFailed( electron, primaryVertex );
+  if ( failed >= 0 ) {
+    if ( m_debug ) { Info("PassCuts()", "Electron failed %s cut.", m_cuts.name( failed ).c_str()); }
+    return 0;
   }
 
   return 1;
@@ -13,10 +13,16 @@
 // package include(s):
 #include <xAODAnaHelpers/HelperFunctions.h>
 #include <xAODAnaHelpers/HelpTreeBase.h>
+#include <xAODAnaHelpers/AsyncTreeFiller.h>
+#include <xAODAnaHelpers/TrigDecisionCache.h>
 #include <xAODAnaHelpers/tools/ReturnCheck.h>
 
 #include "AsgTools/StatusCode.h"
 
+// ROOT include(s):
+#include "TBranch.h"
+#include "TRegexp.h"
+
 // needed? should it be here?
 #ifdef __MAKECINT__
 #pragma link C++ class vector<float>+;
@@ -28,22 +34,113 @@ HelpTreeBase::HelpTreeBase(xAOD::TEvent* event, TTree* tree, TFile* file, const
   m_elInfoSwitch(0),
   m_jetInfoSwitch(0),
   m_fatJetInfoSwitch(0),
-  m_tauInfoSwitch(0)
+  m_tauInfoSwitch(0),
+  m_asyncFiller(0),
+  m_autoTuneEntries(0),
+  m_autoTuneMemory(0),
+  m_nFilled(0),
+  m_trigMenuTree(0),
+  m_trigMenuVersion(0),
+  m_ownTrigCache(0),
+  m_jetColumns(0),
+  m_jet_ePerSampBranch(m_jet_ePerSamp),
+  m_jet_NTrkPt1000Branch(m_jet_NTrkPt1000),
+  m_jet_SumPtPt1000Branch(m_jet_SumPtPt1000),
+  m_jet_TrkWPt1000Branch(m_jet_TrkWPt1000),
+  m_jet_NTrkPt500Branch(m_jet_NTrkPt500),
+  m_jet_SumPtPt500Branch(m_jet_SumPtPt500),
+  m_jet_TrkWPt500Branch(m_jet_TrkWPt500),
+  m_jet_jvfBranch(m_jet_jvf),
+  m_jet_GhostTrack_ptBranch(m_jet_GhostTrack_pt),
+  m_jet_GhostTrack_etaBranch(m_jet_GhostTrack_eta),
+  m_jet_GhostTrack_phiBranch(m_jet_GhostTrack_phi),
+  m_jet_GhostTrack_eBranch(m_jet_GhostTrack_e),
+  m_elColumns(0)
 {
 
   m_units = units;
   m_debug = debug;
   m_DC14  = DC14;
   m_tree = tree;
+  // defined even for entries written before the first Fill*/Clear* of a collection
+  m_njet  = 0;
+  m_nmuon = 0;
+  m_nel   = 0;
+  m_ntau  = 0;
   m_tree->SetDirectory( file );
   Info("HelpTreeBase()", "HelpTreeBase setup");
 
 }
 
+HelpTreeBase::~HelpTreeBase() {
+  // writes the entry still in flight
+  if ( m_asyncFiller ) { AsyncTreeFiller::release( m_asyncFiller ); }
+  if ( m_ownTrigCache ) { delete m_ownTrigCache; }
+  if ( m_jetColumns ) { delete m_jetColumns; }
+  if ( m_elColumns  ) { delete m_elColumns;  }
+}
+
+void HelpTreeBase::NewInputFile() {
+  if ( m_jetColumns ) { m_jetColumns->newInputFile(); }
+  if ( m_elColumns  ) { m_elColumns->newInputFile();  }
+}
+
 void HelpTreeBase::Fill() {
+  if ( m_autoTuneEntries > 0 && m_nFilled++ == m_autoTuneEntries ) {
+    // the buffers already hold the next entry, only the tree is touched here
+    this->WaitForFill();
+    m_tree->OptimizeBaskets( m_autoTuneMemory, 1.1, "" );
+    Info("Fill()", "Resized the baskets of %s after %lld entries", m_tree->GetName(), m_autoTuneEntries);
+  }
+  if ( m_asyncFiller ) { m_asyncFiller->fill( m_tree ); return; }
+  // another tree of the file may be written in the background
+  AsyncTreeFiller::waitFor( m_tree->GetCurrentFile() );
   m_tree->Fill();
 }
 
+void HelpTreeBase::EnableAsyncFill() {
+  if ( m_asyncFiller ) { return; }
+  Info("EnableAsyncFill()", "Filling %s on a background thread", m_tree->GetName());
+  m_asyncFiller = AsyncTreeFiller::acquire( m_tree->GetCurrentFile() );
+}
+
+void HelpTreeBase::WaitForFill() {
+  // whichever tree of the file is being written
+  AsyncTreeFiller::waitFor( m_tree->GetCurrentFile() );
+}
+
+int HelpTreeBase::SetCompression( const std::string& branches, int settings ) {
+  TRegexp pattern( branches.c_str(), kTRUE );
+  int nMatched(0);
+  TIter next( m_tree->GetListOfBranches() );
+  while ( TBranch* branch = static_cast<TBranch*>( next() ) ) {
+    // the whole name has to match, not just a part of it
+    TString name( branch->GetName() );
+    Ssiz_t len(0);
+    if ( name.Index( pattern, &len ) != 0 || len != name.Length() ) { continue; }
+    branch->SetCompressionSettings( settings );
+    ++nMatched;
+  }
+  return nMatched;
+}
+
+void HelpTreeBase::SetBasketSize( const std::string& branches, Int_t size ) {
+  m_tree->SetBasketSize( branches.c_str(), size );
+}
+
+void HelpTreeBase::SetAutoFlush( Long64_t autoFlush ) {
+  m_tree->SetAutoFlush( autoFlush );
+}
+
+void HelpTreeBase::AutoTuneBaskets( Long64_t nEntries, Long64_t maxMemory ) {
+  m_autoTuneEntries = nEntries;
+  m_autoTuneMemory  = maxMemory;
+}
+
+void HelpTreeBase::AddFriend( HelpTreeBase* friendTree, const std::string& alias ) {
+  m_tree->AddFriend( friendTree->m_tree, alias.c_str() );
+}
+
 /*********************
  *
  *   EVENT
@@ -221,12 +318,35 @@ void HelpTreeBase::AddTrigger( const std::string detailStr ) {
     m_tree->Branch("allTriggers",      &m_allTriggers    );   // vector of strings for trigger names
     m_tree->Branch("allTriggerDec",    &m_allTriggerDec  );   // vector of integer for trigger decisions
   }
+
+  // Same information, but the trigger names go to a separate tree once per menu
+  //   triggerBits bit i <-> the <tree>_triggerMenu entry with the event's MasterKey/L1PSKey/HLTPSKey, triggerNames[i]
+  //   the keys survive hadd, unlike an entry number. See xAODAnaHelpers/TriggerMenuReader.h to read it back
+  if ( m_trigInfoSwitch->m_triggerBits ) {
+    m_tree->Branch("triggerBits",      &m_triggerBits     );
+    if ( !m_trigInfoSwitch->m_menuKeys ) {
+      m_tree->Branch("MasterKey",       &m_masterKey,    "MasterKey/I" );
+      m_tree->Branch("L1PSKey",         &m_L1PSKey,      "L1PSKey/I"   );
+      m_tree->Branch("HLTPSKey",        &m_HLTPSKey,     "HLTPSKey/I"  );
+    }
+
+    std::string menuTreeName = std::string( m_tree->GetName() ) + "_triggerMenu";
+    m_trigMenuTree = new TTree( menuTreeName.c_str(), menuTreeName.c_str() );
+    m_trigMenuTree->SetDirectory( m_tree->GetDirectory() );
+    // same leaf types as the keys of the event tree
+    m_trigMenuTree->Branch("MasterKey",    &m_masterKey,    "MasterKey/I" );
+    m_trigMenuTree->Branch("L1PSKey",      &m_L1PSKey,      "L1PSKey/I"   );
+    m_trigMenuTree->Branch("HLTPSKey",     &m_HLTPSKey,     "HLTPSKey/I"  );
+    m_trigMenuTree->Branch("triggerNames", &m_trigMenuNames );
+  }
   
   this->AddTriggerUser();
 }
 
 // Fill the information in the trigger branches
-void HelpTreeBase::FillTrigger( TrigConf::xAODConfigTool* trigConfTool, Trig::TrigDecisionTool* trigDecTool, std::string trigs ) {
+//   the chain groups are resolved once per menu by the TrigDecisionCache
+//   and it has already evaluated this event, so nothing here touches a regex
+void HelpTreeBase::FillTrigger( TrigDecisionCache* trigCache ) {
 
   if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Filling trigger info"); }
 
@@ -239,9 +359,9 @@ void HelpTreeBase::FillTrigger( TrigConf::xAODConfigTool* trigConfTool, Trig::Tr
 
     if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Switch: m_trigInfoSwitch->m_basic"); }
   
-    m_passAny = trigDecTool->isPassed(".*");
-    m_passL1  = trigDecTool->isPassed("L1_.*");
-    m_passHLT = trigDecTool->isPassed("HLT_.*");
+    m_passAny = trigCache->passAny();
+    m_passL1  = trigCache->passL1();
+    m_passHLT = trigCache->passHLT();
   }
     
   // If detailed menu information about the configuration keys, turn this on.
@@ -250,9 +370,9 @@ void HelpTreeBase::FillTrigger( TrigConf::xAODConfigTool* trigConfTool, Trig::Tr
 
     if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Switch: m_trigInfoSwitch->m_menuKeys"); }
 
-    m_masterKey = trigConfTool->masterKey();
-    m_L1PSKey   = trigConfTool->lvl1PrescaleKey();
-    m_HLTPSKey  = trigConfTool->hltPrescaleKey();
+    m_masterKey = trigCache->masterKey();
+    m_L1PSKey   = trigCache->L1PSKey();
+    m_HLTPSKey  = trigCache->HLTPSKey();
   }
   
   // If super detailed information about each and every trigger is desired, use this
@@ -261,21 +381,56 @@ void HelpTreeBase::FillTrigger( TrigConf::xAODConfigTool* trigConfTool, Trig::Tr
 
     if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Switch: m_trigInfoSwitch->m_allTriggers"); }
 
-    if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Only saving information about triggers: %s" , trigs.c_str()); }
+    const std::vector<std::string>& chains = trigCache->chains();
+    for ( unsigned int iChain = 0; iChain < chains.size(); ++iChain ) {
+      m_allTriggers.push_back   ( chains.at(iChain) );
+      m_allTriggerDec.push_back ( trigCache->passChain(iChain) );
+    }
+  }
+
+  if ( m_trigInfoSwitch->m_triggerBits ) {
+
+    if ( m_debug ) { Info("HelpTreeBase::FillTrigger()", "Switch: m_trigInfoSwitch->m_triggerBits"); }
 
-    auto chainGroup = trigDecTool->getChainGroup(trigs);
-    for (auto &trigName : chainGroup->getListOfTriggers()) {
-      auto trigChain = trigDecTool->getChainGroup( trigName );
-      
-      m_allTriggers.push_back   ( trigName );
-      m_allTriggerDec.push_back ( trigChain->isPassed() );
+    // the keys of every event point into the menu tree
+    m_masterKey = trigCache->masterKey();
+    m_L1PSKey   = trigCache->L1PSKey();
+    m_HLTPSKey  = trigCache->HLTPSKey();
+
+    // a menu we have not written yet: write its names once
+    if ( trigCache->menuVersion() != m_trigMenuVersion ) {
+      m_trigMenuVersion = trigCache->menuVersion();
+      if ( m_trigMenuWritten.insert( std::make_tuple( m_masterKey, m_L1PSKey, m_HLTPSKey ) ).second ) {
+        m_trigMenuNames = trigCache->chains();
+        m_trigMenuTree->Fill();
+      }
     }
+
+    m_triggerBits = trigCache->bits();
   }
   
 }
 
+// Fill the trigger branches with the tools directly
+//   the chain groups of trigs are resolved once per menu in a cache of our own,
+//   made again if we are handed other tools or another selection
+void HelpTreeBase::FillTrigger( TrigConf::xAODConfigTool* trigConfTool, Trig::TrigDecisionTool* trigDecTool, std::string trigs ) {
+
+  if ( !m_ownTrigCache || m_ownTrigCache->trigConfTool() != trigConfTool || m_ownTrigCache->trigDecTool() != trigDecTool || m_ownTrigCache->selection() != trigs ) {
+    if ( m_ownTrigCache ) { delete m_ownTrigCache; }
+    m_ownTrigCache = new TrigDecisionCache( trigDecTool, trigConfTool, trigs );
+    // the menu versions of the new cache start again
+    m_trigMenuVersion = 0;
+  }
+
+  m_ownTrigCache->decide( 0 );
+  this->FillTrigger( m_ownTrigCache );
+}
+
 // Clear Trigger
 void HelpTreeBase::ClearTrigger() {
+
+  this->WaitForFill();
   
   m_passAny = -1;
   m_passL1  = -1;
@@ -287,6 +442,7 @@ void HelpTreeBase::ClearTrigger() {
   
   m_allTriggers.clear();
   m_allTriggerDec.clear();
+  m_triggerBits.clear();
   
 }
 
@@ -358,12 +514,15 @@ void HelpTreeBase::FillMuons( const xAOD::MuonContainer* muons, const xAOD::Vert
   this->ClearMuons();
   this->ClearMuonsUser();
 
+  // the switches in one word, so the per-object blocks test a local rather than reload the flags
+  const uint32_t mask = m_muInfoSwitch->m_mask;
+
   m_nmuon = 0;
   for ( auto muon_itr : *(muons) ) {
 
     if ( m_debug ) { Info("HelpTreeBase::FillMuons()", "Filling muon w/ pT = %2f", muon_itr->pt() / m_units ); }
 
-    if ( m_muInfoSwitch->m_kinematic ) {
+    if ( mask & HelperClasses::MuonInfoSwitch::KINEMATIC ) {
       m_muon_pt.push_back ( muon_itr->pt() / m_units  );
       m_muon_eta.push_back( muon_itr->eta() );
       m_muon_phi.push_back( muon_itr->phi() );
@@ -372,7 +531,7 @@ void HelpTreeBase::FillMuons( const xAOD::MuonContainer* muons, const xAOD::Vert
 
     const xAOD::TrackParticle* trk = muon_itr->primaryTrackParticle();
 
-    if ( m_muInfoSwitch->m_trackparams ) {
+    if ( mask & HelperClasses::MuonInfoSwitch::TRACKPARAMS ) {
       if ( trk ) {
         //
 	// NB.:
@@ -405,7 +564,7 @@ void HelpTreeBase::FillMuons( const xAOD::MuonContainer* muons, const xAOD::Vert
       }
     }
 
-    if ( m_muInfoSwitch->m_trackhitcont ) {
+    if ( mask & HelperClasses::MuonInfoSwitch::TRACKHITCONT ) {
       uint8_t nPixHits(-1), nPixHoles(-1), nSCTHits(-1), nSCTHoles(-1), nTRTHits(-1), nTRTHoles(-1), nBLayerHits(-1), nInnermostPixLayHits(-1);
       float pixdEdX(-1.0);
       if ( trk ) {
@@ -452,6 +611,7 @@ void HelpTreeBase::AddElectrons(const std::string detailStr) {
   Info("AddElectrons()", "Adding electron variables: %s", detailStr.c_str());
   
   m_elInfoSwitch = new HelperClasses::ElectronInfoSwitch( detailStr );
+  m_elColumns    = new TreeColumns( m_tree, m_units );
 
   // always
   m_tree->Branch("nel",    &m_nel,"nel/I");
@@ -463,19 +623,20 @@ void HelpTreeBase::AddElectrons(const std::string detailStr) {
     m_tree->Branch("el_m",   &m_el_m);
   }
 
+  // decorated by ElectronSelector, and only on the electrons it got to
   if ( m_elInfoSwitch->m_isolation ) {
-    m_tree->Branch("el_isIsolated",  &m_el_isIsolated);
+    m_elColumns->addDecoration<int, char>(m_el_isIsolated, "el_isIsolated",  "isIsolated",  false, -1);
   }
-  
+
   if ( m_elInfoSwitch->m_PID ) {
-    m_tree->Branch("el_LHVeryLoose",  &m_el_LHVeryLoose);
-    m_tree->Branch("el_LHLoose",      &m_el_LHLoose);
-    m_tree->Branch("el_LHMedium",     &m_el_LHMedium);
-    m_tree->Branch("el_LHTight",      &m_el_LHTight);
-    m_tree->Branch("el_LHVeryTight",  &m_el_LHVeryTight);
-    m_tree->Branch("el_IsEMLoose",    &m_el_IsEMLoose);
-    m_tree->Branch("el_IsEMMedium",   &m_el_IsEMMedium);
-    m_tree->Branch("el_IsEMTight",    &m_el_IsEMTight);
+    m_elColumns->addDecoration<int, char>(m_el_LHVeryLoose, "el_LHVeryLoose",  "LHVeryLoose", false, -1);
+    m_elColumns->addDecoration<int, char>(m_el_LHLoose,     "el_LHLoose",      "LHLoose",     false, -1);
+    m_elColumns->addDecoration<int, char>(m_el_LHMedium,    "el_LHMedium",     "LHMedium",    false, -1);
+    m_elColumns->addDecoration<int, char>(m_el_LHTight,     "el_LHTight",      "LHTight",     false, -1);
+    m_elColumns->addDecoration<int, char>(m_el_LHVeryTight, "el_LHVeryTight",  "LHVeryTight", false, -1);
+    m_elColumns->addDecoration<int, char>(m_el_IsEMLoose,   "el_IsEMLoose",    "Loose",       false, -1);
+    m_elColumns->addDecoration<int, char>(m_el_IsEMMedium,  "el_IsEMMedium",   "Medium",      false, -1);
+    m_elColumns->addDecoration<int, char>(m_el_IsEMTight,   "el_IsEMTight",    "Tight",       false, -1);
   }
 
   if ( m_elInfoSwitch->m_trackparams ) {
@@ -512,6 +673,11 @@ void HelpTreeBase::FillElectrons( const xAOD::ElectronContainer* electrons, cons
   this->ClearElectrons();
   this->ClearElectronsUser();
 
+  m_elColumns->reserve( electrons->size() );
+
+  // the switches in one word, so the per-object blocks test a local rather than reload the flags
+  const uint32_t mask = m_elInfoSwitch->m_mask;
+
   m_nel = 0;
 
   for ( auto el_itr : *(electrons) ) {
@@ -520,42 +686,17 @@ void HelpTreeBase::FillElectrons( const xAOD::ElectronContainer* electrons, cons
 
     const xAOD::TrackParticle* trk = el_itr->trackParticle();
 
-    if ( m_elInfoSwitch->m_kinematic ) {
+    if ( mask & HelperClasses::ElectronInfoSwitch::KINEMATIC ) {
       m_el_pt.push_back ( (el_itr)->pt() / m_units );
       m_el_eta.push_back( (el_itr)->eta() );
       m_el_phi.push_back( (el_itr)->phi() );
       m_el_m.push_back  ( (el_itr)->m() / m_units );
     }
   
-    if ( m_elInfoSwitch->m_isolation ) {
-      static SG::AuxElement::Accessor<char> isIsoAcc ("isIsolated");
-      if ( isIsoAcc.isAvailable( *el_itr ) ) { m_el_isIsolated.push_back( isIsoAcc( *el_itr ) ); } else { m_el_isIsolated.push_back( -1 ); }
-    }
-    
-    if ( m_elInfoSwitch->m_PID ) {
-      
-      static SG::AuxElement::Accessor<char> LHVeryLooseAcc ("LHVeryLoose");
-      static SG::AuxElement::Accessor<char> LHLooseAcc ("LHLoose");
-      static SG::AuxElement::Accessor<char> LHMediumAcc ("LHMedium");
-      static SG::AuxElement::Accessor<char> LHTightAcc ("LHTight");
-      static SG::AuxElement::Accessor<char> LHVeryTightAcc ("LHVeryTight");
-
-      static SG::AuxElement::Accessor<char> EMLooseAcc ("Loose");
-      static SG::AuxElement::Accessor<char> EMMediumAcc ("Medium");
-      static SG::AuxElement::Accessor<char> EMTightAcc ("Tight");
-
-      if ( LHVeryLooseAcc.isAvailable( *el_itr ) ) { m_el_LHVeryLoose.push_back( LHVeryLooseAcc( *el_itr ) ); } else { m_el_LHVeryLoose.push_back( -1 ); }
-      if ( LHLooseAcc.isAvailable( *el_itr ) )     { m_el_LHLoose.push_back( LHLooseAcc( *el_itr ) );         } else { m_el_LHLoose.push_back( -1 ); }
-      if ( LHMediumAcc.isAvailable( *el_itr ) )    { m_el_LHMedium.push_back( LHMediumAcc( *el_itr ) );       } else { m_el_LHMedium.push_back( -1 ); }
-      if ( LHTightAcc.isAvailable( *el_itr ) )     { m_el_LHTight.push_back( LHTightAcc( *el_itr ) );         } else { m_el_LHTight.push_back( -1 ); }
-      if ( LHVeryTightAcc.isAvailable( *el_itr ) ) { m_el_LHVeryTight.push_back( LHVeryTightAcc( *el_itr ) ); } else { m_el_LHVeryTight.push_back( -1 ); }
-      
-      if ( EMLooseAcc.isAvailable( *el_itr ) )         { m_el_IsEMLoose.push_back( EMLooseAcc( *el_itr ) );   } else { m_el_IsEMLoose.push_back( -1 ); }
-      if ( EMMediumAcc.isAvailable( *el_itr ) )        { m_el_IsEMMedium.push_back( EMMediumAcc( *el_itr ) ); } else { m_el_IsEMMedium.push_back( -1 ); }
-      if ( EMTightAcc.isAvailable( *el_itr ) )         { m_el_IsEMTight.push_back( EMTightAcc( *el_itr ) );   } else { m_el_IsEMTight.push_back( -1 ); }
-    }
+    // isolation and PID
+    m_elColumns->fill( *el_itr );
 
-    if ( m_elInfoSwitch->m_trackparams ) {
+    if ( mask & HelperClasses::ElectronInfoSwitch::TRACKPARAMS ) {
       if ( trk ) {
         //
 	// NB.:
@@ -588,7 +729,7 @@ void HelpTreeBase::FillElectrons( const xAOD::ElectronContainer* electrons, cons
       }
     }
 
-    if ( m_elInfoSwitch->m_trackhitcont ) {
+    if ( mask & HelperClasses::ElectronInfoSwitch::TRACKHITCONT ) {
       uint8_t nPixHits(-1), nPixHoles(-1), nSCTHits(-1), nSCTHoles(-1), nTRTHits(-1), nTRTHoles(-1), nBLayerHits(-1), nInnermostPixLayHits(-1);
       float pixdEdX(-1.0);
       if ( trk ) {
@@ -636,6 +777,10 @@ void HelpTreeBase::AddJets(const std::string detailStr)
   Info("AddJets()", "Adding jet variables: %s", detailStr.c_str());
 
   m_jetInfoSwitch = new HelperClasses::JetInfoSwitch( detailStr );
+  m_jetColumns    = new TreeColumns( m_tree, m_units );
+
+  // per-jet lists as one value array + offsets instead of vector<vector>
+  bool flat = m_jetInfoSwitch->m_flatVectors;
 
   // always
   m_tree->Branch("njets",    &m_njet,"njets/I");
@@ -648,46 +793,46 @@ void HelpTreeBase::AddJets(const std::string detailStr)
   }
 
   if( m_jetInfoSwitch->m_clean ) {
-    m_tree->Branch("jet_Timing",              &m_jet_time               );
-    m_tree->Branch("jet_LArQuality",          &m_jet_LArQuality         );
-    m_tree->Branch("jet_HECQuality",          &m_jet_hecq               );
-    m_tree->Branch("jet_NegativeE",           &m_jet_negE               );
-    m_tree->Branch("jet_AverageLArQF",        &m_jet_avLArQF            );
-    m_tree->Branch("jet_BchCorrCell",         &m_jet_bchCorrCell        );
-    m_tree->Branch("jet_N90Constituents",     &m_jet_N90Const           );
-    m_tree->Branch("jet_LArBadHVEFracnergyFrac", &m_jet_LArBadHVEFrac   );
-    m_tree->Branch("jet_LArBadHVNCell",       &m_jet_LArBadHVNCell  	  );
-    m_tree->Branch("jet_OotFracClusters5",    &m_jet_OotFracClus5  	    );
-    m_tree->Branch("jet_OotFracClusters10",   &m_jet_OotFracClus10  	  );
-    m_tree->Branch("jet_LeadingClusterPt",              &m_jet_LeadingClusterPt  	            );
-    m_tree->Branch("jet_LeadingClusterSecondLambda",    &m_jet_LeadingClusterSecondLambda  	  );
-    m_tree->Branch("jet_LeadingClusterCenterLambda",    &m_jet_LeadingClusterCenterLambda  	  );
-    m_tree->Branch("jet_LeadingClusterSecondR",         &m_jet_LeadingClusterSecondR  	      );
+    m_jetColumns->add<float>(m_jet_time,                       "jet_Timing",                      "Timing"                     );
+    m_jetColumns->add<float>(m_jet_LArQuality,                 "jet_LArQuality",                  "LArQuality"                 );
+    m_jetColumns->add<float>(m_jet_hecq,                       "jet_HECQuality",                  "HECQuality"                 );
+    m_jetColumns->add<float>(m_jet_negE,                       "jet_NegativeE",                   "NegativeE",            true );
+    m_jetColumns->add<float>(m_jet_avLArQF,                    "jet_AverageLArQF",                "AverageLArQF"               );
+    m_jetColumns->add<float>(m_jet_bchCorrCell,                "jet_BchCorrCell",                 "BchCorrCell"                );
+    m_jetColumns->add<float>(m_jet_N90Const,                   "jet_N90Constituents",             "N90Constituents"            );
+    m_jetColumns->add<float>(m_jet_LArBadHVEFrac,              "jet_LArBadHVEFracnergyFrac",      "LArBadHVEnergyFrac"         );
+    m_jetColumns->add<int>  (m_jet_LArBadHVNCell,              "jet_LArBadHVNCell",               "LArBadHVNCell"              );
+    m_jetColumns->add<float>(m_jet_OotFracClus5,               "jet_OotFracClusters5",            "OotFracClusters5"           );
+    m_jetColumns->add<float>(m_jet_OotFracClus10,              "jet_OotFracClusters10",           "OotFracClusters10"          );
+    m_jetColumns->add<float>(m_jet_LeadingClusterPt,           "jet_LeadingClusterPt",            "LeadingClusterPt"           );
+    m_jetColumns->add<float>(m_jet_LeadingClusterSecondLambda, "jet_LeadingClusterSecondLambda",  "LeadingClusterSecondLambda" );
+    m_jetColumns->add<float>(m_jet_LeadingClusterCenterLambda, "jet_LeadingClusterCenterLambda",  "LeadingClusterCenterLambda" );
+    m_jetColumns->add<float>(m_jet_LeadingClusterSecondR,      "jet_LeadingClusterSecondR",       "LeadingClusterSecondR"      );
   }
 
   if ( m_jetInfoSwitch->m_energy ) {
-    m_tree->Branch("jet_HECFrac", 	            &m_jet_HECf	    );
-    m_tree->Branch("jet_EMFrac",  	            &m_jet_EMf	    );
-    m_tree->Branch("jet_CentroidR",	            &m_jet_centroidR      );
-    m_tree->Branch("jet_FracSamplingMax",       &m_jet_fracSampMax    );
-    m_tree->Branch("jet_FracSamplingMaxIndex",  &m_jet_fracSampMaxIdx );
-    m_tree->Branch("jet_LowEtConstituentsFrac", &m_jet_lowEtFrac      );
-    m_tree->Branch("jet_GhostMuonSegmentCount", &m_jet_muonSegCount   );
-    m_tree->Branch("jet_Width",                 &m_jet_width          );
+    m_jetColumns->add<float>     (m_jet_HECf,           "jet_HECFrac",                "HECFrac"               );
+    m_jetColumns->add<float>     (m_jet_EMf,            "jet_EMFrac",                 "EMFrac"                );
+    m_jetColumns->add<float>     (m_jet_centroidR,      "jet_CentroidR",              "CentroidR"             );
+    m_jetColumns->add<float>     (m_jet_fracSampMax,    "jet_FracSamplingMax",        "FracSamplingMax"       );
+    m_jetColumns->add<float, int>(m_jet_fracSampMaxIdx, "jet_FracSamplingMaxIndex",   "FracSamplingMaxIndex"  );
+    m_jetColumns->add<float>     (m_jet_lowEtFrac,      "jet_LowEtConstituentsFrac",  "LowEtConstituentsFrac" );
+    m_jetColumns->add<float, int>(m_jet_muonSegCount,   "jet_GhostMuonSegmentCount",  "GhostMuonSegmentCount" );
+    m_jetColumns->add<float>     (m_jet_width,          "jet_Width",                  "Width"                 );
   }
 
   if ( m_jetInfoSwitch->m_layer ) {
-    m_tree->Branch("jet_EnergyPerSampling",     &m_jet_ePerSamp   );
+    m_jet_ePerSampBranch.branch( m_tree, "jet_EnergyPerSampling", flat );
   }
 
   if ( m_jetInfoSwitch->m_trackAll ) {
-    m_tree->Branch("jet_NumTrkPt1000",	    &m_jet_NTrkPt1000   );
-    m_tree->Branch("jet_SumPtTrkPt1000",    &m_jet_SumPtPt1000  );
-    m_tree->Branch("jet_TrackWidthPt1000",  &m_jet_TrkWPt1000   );
-    m_tree->Branch("jet_NumTrkPt500",	      &m_jet_NTrkPt500    );
-    m_tree->Branch("jet_SumPtTrkPt500",	    &m_jet_SumPtPt500   );
-    m_tree->Branch("jet_TrackWidthPt500",   &m_jet_TrkWPt500    );
-    m_tree->Branch("jet_JVF",		            &m_jet_jvf	        );
+    m_jet_NTrkPt1000Branch.branch( m_tree, "jet_NumTrkPt1000", flat );
+    m_jet_SumPtPt1000Branch.branch( m_tree, "jet_SumPtTrkPt1000", flat );
+    m_jet_TrkWPt1000Branch.branch( m_tree, "jet_TrackWidthPt1000", flat );
+    m_jet_NTrkPt500Branch.branch( m_tree, "jet_NumTrkPt500", flat );
+    m_jet_SumPtPt500Branch.branch( m_tree, "jet_SumPtTrkPt500", flat );
+    m_jet_TrkWPt500Branch.branch( m_tree, "jet_TrackWidthPt500", flat );
+    m_jet_jvfBranch.branch( m_tree, "jet_JVF", flat );
     //m_tree->Branch("jet_JVFLoose",          &m_jet_jvfloose     );
     // HigestJVFLooseVtx  Vertex
     // JVT  Jvt, JvtRpt, JvtJvfcorr float JVT, etc., see Twiki
@@ -709,10 +854,10 @@ void HelpTreeBase::AddJets(const std::string detailStr)
   if ( m_jetInfoSwitch->m_allTrack ) {
     m_tree->Branch("jet_GhostTrackCount",  &m_jet_GhostTrackCount );
     m_tree->Branch("jet_GhostTrackPt",     &m_jet_GhostTrackPt    );
-    m_tree->Branch("jet_GhostTrack_pt",    &m_jet_GhostTrack_pt   );
-    m_tree->Branch("jet_GhostTrack_eta",   &m_jet_GhostTrack_eta  );
-    m_tree->Branch("jet_GhostTrack_phi",   &m_jet_GhostTrack_phi  );
-    m_tree->Branch("jet_GhostTrack_e",     &m_jet_GhostTrack_e    );
+    m_jet_GhostTrack_ptBranch.branch( m_tree, "jet_GhostTrack_pt", flat );
+    m_jet_GhostTrack_etaBranch.branch( m_tree, "jet_GhostTrack_eta", flat );
+    m_jet_GhostTrack_phiBranch.branch( m_tree, "jet_GhostTrack_phi", flat );
+    m_jet_GhostTrack_eBranch.branch( m_tree, "jet_GhostTrack_e", flat );
   }
 
   if( m_jetInfoSwitch->m_flavTag ) {
@@ -728,14 +873,13 @@ void HelpTreeBase::AddJets(const std::string detailStr)
   }
 
   if ( m_jetInfoSwitch->m_truth ) {
-    m_tree->Branch("jet_ConeTruthLabelID",   &m_jet_truthConeLabelID );
-    m_tree->Branch("jet_TruthCount",         &m_jet_truthCount     );
-//    m_tree->Branch("jet_TruthPt",            &m_jet_truthPt        );
-    m_tree->Branch("jet_TruthLabelDeltaR_B", &m_jet_truthDr_B      );
-    m_tree->Branch("jet_TruthLabelDeltaR_C", &m_jet_truthDr_C      );
-    m_tree->Branch("jet_TruthLabelDeltaR_T", &m_jet_truthDr_T      );
-    m_tree->Branch("jet_PartonTruthLabelID", &m_jet_partonTruthID  );
-    m_tree->Branch("jet_GhostTruthAssociationFraction", &m_jet_ghostTruthAssFrac);
+    m_jetColumns->add<int>  (m_jet_truthConeLabelID,  "jet_ConeTruthLabelID",               "ConeTruthLabelID"              );
+    m_jetColumns->add<int>  (m_jet_truthCount,        "jet_TruthCount",                     "TruthCount"                    );
+    m_jetColumns->add<float>(m_jet_truthDr_B,         "jet_TruthLabelDeltaR_B",             "TruthLabelDeltaR_B"            );
+    m_jetColumns->add<float>(m_jet_truthDr_C,         "jet_TruthLabelDeltaR_C",             "TruthLabelDeltaR_C"            );
+    m_jetColumns->add<float>(m_jet_truthDr_T,         "jet_TruthLabelDeltaR_T",             "TruthLabelDeltaR_T"            );
+    m_jetColumns->add<int>  (m_jet_partonTruthID,     "jet_PartonTruthLabelID",             "PartonTruthLabelID"            );
+    m_jetColumns->add<float>(m_jet_ghostTruthAssFrac, "jet_GhostTruthAssociationFraction",  "GhostTruthAssociationFraction" );
     m_tree->Branch("jet_truth_E",   &m_jet_truth_E);
     m_tree->Branch("jet_truth_pt",  &m_jet_truth_pt);
     m_tree->Branch("jet_truth_phi", &m_jet_truth_phi);
@@ -743,22 +887,22 @@ void HelpTreeBase::AddJets(const std::string detailStr)
   }
 
   if ( m_jetInfoSwitch->m_truthDetails ) {
-    m_tree->Branch("jet_GhostBHadronsFinalCount",   &m_jet_truthCount_BhadFinal );
-    m_tree->Branch("jet_GhostBHadronsInitialCount", &m_jet_truthCount_BhadInit  );
-    m_tree->Branch("jet_GhostBQuarksFinalCount",    &m_jet_truthCount_BQFinal   );
-    m_tree->Branch("jet_GhostBHadronsFinalPt",      &m_jet_truthPt_BhadFinal    );
-    m_tree->Branch("jet_GhostBHadronsInitialPt",    &m_jet_truthPt_BhadInit     );
-    m_tree->Branch("jet_GhostBQuarksFinalPt",       &m_jet_truthPt_BQFinal      );
-
-    m_tree->Branch("jet_GhostCHadronsFinalCount",   &m_jet_truthCount_ChadFinal );
-    m_tree->Branch("jet_GhostCHadronsInitialCount", &m_jet_truthCount_ChadInit  );
-    m_tree->Branch("jet_GhostCQuarksFinalCount",    &m_jet_truthCount_CQFinal   );
-    m_tree->Branch("jet_GhostCHadronsFinalPt",      &m_jet_truthPt_ChadFinal    );
-    m_tree->Branch("jet_GhostCHadronsInitialPt",    &m_jet_truthPt_ChadInit     );
-    m_tree->Branch("jet_GhostCQuarksFinalPt",       &m_jet_truthPt_CQFinal      );
-
-    m_tree->Branch("jet_GhostTausFinalCount",       &m_jet_truthCount_TausFinal );
-    m_tree->Branch("jet_GhostTausFinalPt",          &m_jet_truthPt_TausFinal    );
+    m_jetColumns->add<int>  (m_jet_truthCount_BhadFinal, "jet_GhostBHadronsFinalCount",    "GhostBHadronsFinalCount"   );
+    m_jetColumns->add<int>  (m_jet_truthCount_BhadInit,  "jet_GhostBHadronsInitialCount",  "GhostBHadronsInitialCount" );
+    m_jetColumns->add<int>  (m_jet_truthCount_BQFinal,   "jet_GhostBQuarksFinalCount",     "GhostBQuarksFinalCount"    );
+    m_jetColumns->add<float>(m_jet_truthPt_BhadFinal,    "jet_GhostBHadronsFinalPt",       "GhostBHadronsFinalPt"      );
+    m_jetColumns->add<float>(m_jet_truthPt_BhadInit,     "jet_GhostBHadronsInitialPt",     "GhostBHadronsInitialPt"    );
+    m_jetColumns->add<float>(m_jet_truthPt_BQFinal,      "jet_GhostBQuarksFinalPt",        "GhostBQuarksFinalPt"       );
+
+    m_jetColumns->add<int>  (m_jet_truthCount_ChadFinal, "jet_GhostCHadronsFinalCount",    "GhostCHadronsFinalCount"   );
+    m_jetColumns->add<int>  (m_jet_truthCount_ChadInit,  "jet_GhostCHadronsInitialCount",  "GhostCHadronsInitialCount" );
+    m_jetColumns->add<int>  (m_jet_truthCount_CQFinal,   "jet_GhostCQuarksFinalCount",     "GhostCQuarksFinalCount"    );
+    m_jetColumns->add<float>(m_jet_truthPt_ChadFinal,    "jet_GhostCHadronsFinalPt",       "GhostCHadronsFinalPt"      );
+    m_jetColumns->add<float>(m_jet_truthPt_ChadInit,     "jet_GhostCHadronsInitialPt",     "GhostCHadronsInitialPt"    );
+    m_jetColumns->add<float>(m_jet_truthPt_CQFinal,      "jet_GhostCQuarksFinalPt",        "GhostCQuarksFinalPt"       );
+
+    m_jetColumns->add<int>  (m_jet_truthCount_TausFinal, "jet_GhostTausFinalCount",  "GhostTausFinalCount"       );
+    m_jetColumns->add<float>(m_jet_truthPt_TausFinal,    "jet_GhostTausFinalPt",     "GhostTausFinalPt"          );
 
     m_tree->Branch("jet_truth_pdgId", &m_jet_truth_pdgId);
     m_tree->Branch("jet_truth_partonPt", &m_jet_truth_partonPt);
@@ -773,208 +917,80 @@ void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation ) {
   this->ClearJets();
   this->ClearJetsUser();
 
+  m_jetColumns->reserve( jets->size() );
+  m_jetAttributes.setContainer( jets, pvLocation );
+
+  // the switches in one word, so the per-object blocks test a local rather than reload the flags
+  const uint32_t mask = m_jetInfoSwitch->m_mask;
+
   for( auto jet_itr : *jets ) {
 
-    if( m_jetInfoSwitch->m_kinematic ){
+    if ( mask & HelperClasses::JetInfoSwitch::KINEMATIC ){
       m_jet_pt.push_back ( jet_itr->pt() / m_units );
       m_jet_eta.push_back( jet_itr->eta() );
       m_jet_phi.push_back( jet_itr->phi() );
       m_jet_E.push_back  ( jet_itr->e() / m_units );
     }
 
-    if (m_jetInfoSwitch->m_clean) {
-
-      static SG::AuxElement::ConstAccessor<float> jetTime ("Timing");
-      if ( jetTime.isAvailable( *jet_itr ) ) {
-        m_jet_time.push_back( jetTime( *jet_itr ) );
-      } else { m_jet_time.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> LArQuality ("LArQuality");
-      if ( LArQuality.isAvailable( *jet_itr ) ) {
-        m_jet_LArQuality.push_back( LArQuality( *jet_itr ) );
-      } else { m_jet_LArQuality.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> hecq ("HECQuality");
-      if ( hecq.isAvailable( *jet_itr ) ) {
-        m_jet_hecq.push_back( hecq( *jet_itr ) );
-      } else { m_jet_hecq.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> negE ("NegativeE");
-      if ( negE.isAvailable( *jet_itr ) ) {
-        m_jet_negE.push_back( negE( *jet_itr ) / m_units );
-      } else { m_jet_negE.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> avLArQF ("AverageLArQF");
-      if ( avLArQF.isAvailable( *jet_itr ) ) {
-        m_jet_avLArQF.push_back( avLArQF( *jet_itr ) );
-      } else { m_jet_avLArQF.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> bchCorrCell ("BchCorrCell");
-      if ( bchCorrCell.isAvailable( *jet_itr ) ) {
-        m_jet_bchCorrCell.push_back( bchCorrCell( *jet_itr ) );
-      } else { m_jet_bchCorrCell.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> N90Const ("N90Constituents");
-      if ( N90Const.isAvailable( *jet_itr ) ) {
-        m_jet_N90Const.push_back( N90Const( *jet_itr ) );
-      } else { m_jet_N90Const.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> LArBadHVEFrac ("LArBadHVEnergyFrac");
-      if ( LArBadHVEFrac.isAvailable( *jet_itr ) ) {
-        m_jet_LArBadHVEFrac.push_back( LArBadHVEFrac( *jet_itr ) );
-      } else { m_jet_LArBadHVEFrac.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<int> LArBadHVNCell ("LArBadHVNCell");
-      if ( LArBadHVNCell.isAvailable( *jet_itr ) ) {
-        m_jet_LArBadHVNCell.push_back( LArBadHVNCell( *jet_itr ) );
-      } else { m_jet_LArBadHVNCell.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> OotFracClus5 ("OotFracClusters5");
-      if ( OotFracClus5.isAvailable( *jet_itr ) ) {
-        m_jet_OotFracClus5.push_back( OotFracClus5( *jet_itr ) );
-      } else { m_jet_OotFracClus5.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> OotFracClus10 ("OotFracClusters10");
-      if ( OotFracClus10.isAvailable( *jet_itr ) ) {
-        m_jet_OotFracClus10.push_back( OotFracClus10( *jet_itr ) );
-      } else { m_jet_OotFracClus10.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> leadClusPt ("LeadingClusterPt");
-      if ( leadClusPt.isAvailable( *jet_itr ) ) {
-        m_jet_LeadingClusterPt.push_back( leadClusPt( *jet_itr ) );
-      } else { m_jet_LeadingClusterPt.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> leadClusSecondLambda ("LeadingClusterSecondLambda");
-      if ( leadClusSecondLambda.isAvailable( *jet_itr ) ) {
-        m_jet_LeadingClusterSecondLambda.push_back( leadClusSecondLambda( *jet_itr ) );
-      } else { m_jet_LeadingClusterSecondLambda.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> leadClusCenterLambda ("LeadingClusterCenterLambda");
-      if ( leadClusCenterLambda.isAvailable( *jet_itr ) ) {
-        m_jet_LeadingClusterCenterLambda.push_back( leadClusCenterLambda( *jet_itr ) );
-      } else { m_jet_LeadingClusterCenterLambda.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> leadClusSecondR ("LeadingClusterSecondR");
-      if ( leadClusSecondR.isAvailable( *jet_itr ) ) {
-        m_jet_LeadingClusterSecondR.push_back( leadClusSecondR( *jet_itr ) );
-      } else { m_jet_LeadingClusterSecondR.push_back( -999 ); }
-
-    } // clean
-
-    if ( m_jetInfoSwitch->m_energy ) {
-
-      static SG::AuxElement::ConstAccessor<float> HECf ("HECFrac");
-      if ( HECf.isAvailable( *jet_itr ) ) {
-        m_jet_HECf.push_back( HECf( *jet_itr ) );
-      } else { m_jet_HECf.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> EMf ("EMFrac");
-      if ( EMf.isAvailable( *jet_itr ) ) {
-        m_jet_EMf.push_back( EMf( *jet_itr ) );
-      } else { m_jet_EMf.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> centroidR ("CentroidR");
-      if ( centroidR.isAvailable( *jet_itr ) ) {
-        m_jet_centroidR.push_back( centroidR( *jet_itr ) );
-      } else { m_jet_centroidR.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> fracSampMax ("FracSamplingMax");
-      if ( fracSampMax.isAvailable( *jet_itr ) ) {
-        m_jet_fracSampMax.push_back( fracSampMax( *jet_itr ) );
-      } else { m_jet_fracSampMax.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<int> fracSampMaxIdx ("FracSamplingMaxIndex");
-      if ( fracSampMaxIdx.isAvailable( *jet_itr ) ) {
-        m_jet_fracSampMaxIdx.push_back( fracSampMaxIdx( *jet_itr ) );
-      } else { m_jet_fracSampMaxIdx.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> lowEtFrac ("LowEtConstituentsFrac");
-      if ( lowEtFrac.isAvailable( *jet_itr ) ) {
-        m_jet_lowEtFrac.push_back( lowEtFrac( *jet_itr ) );
-      } else { m_jet_lowEtFrac.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<int> muonSegCount ("GhostMuonSegmentCount");
-      if ( muonSegCount.isAvailable( *jet_itr ) ) {
-        m_jet_muonSegCount.push_back( muonSegCount( *jet_itr ) );
-      } else { m_jet_muonSegCount.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> width ("Width");
-      if ( width.isAvailable( *jet_itr ) ) {
-        m_jet_width.push_back( width( *jet_itr ) );
-      } else { m_jet_width.push_back( -999 ); }
-
-    } // energy
-
-    if ( m_jetInfoSwitch->m_layer ) {
+    // clean, energy and the plain truth variables
+    m_jetColumns->fill( *jet_itr );
+
+    if ( mask & HelperClasses::JetInfoSwitch::LAYER ) {
       static SG::AuxElement::ConstAccessor< std::vector<float> > ePerSamp ("EnergyPerSampling");
       if ( ePerSamp.isAvailable( *jet_itr ) ) {
-        m_jet_ePerSamp.push_back( ePerSamp( *jet_itr ) );
-        m_jet_ePerSamp.back();
-        std::transform((m_jet_ePerSamp.back()).begin(),
-            (m_jet_ePerSamp.back()).end(),
-            (m_jet_ePerSamp.back()).begin(),
-            std::bind2nd(std::divides<float>(), m_units));
+        m_jet_ePerSampBranch.push_back( ePerSamp( *jet_itr ), m_units );
       } else {
         // could push back a vector of 24...
         // ... waste of space vs prevention of out of range down stream
-        std::vector<float> junk(1,-999);
-        m_jet_ePerSamp.push_back( junk );
+        m_jet_ePerSampBranch.newRow();
+        m_jet_ePerSampBranch.append( -999 );
       }
     }
 
-    if ( m_jetInfoSwitch->m_trackAll || m_jetInfoSwitch->m_trackPV ) {
+    if ( mask & ( HelperClasses::JetInfoSwitch::TRACK_ALL | HelperClasses::JetInfoSwitch::TRACK_PV ) ) {
       static SG::AuxElement::ConstAccessor< std::vector<int> >   nTrk1000("NumTrkPt1000");
       static SG::AuxElement::ConstAccessor< std::vector<float> > sumPt1000("SumPtTrkPt1000");
       static SG::AuxElement::ConstAccessor< std::vector<float> > trkWidth1000("TrackWidthPt1000");
       static SG::AuxElement::ConstAccessor< std::vector<int> >   nTrk500 ("NumTrkPt500");
       static SG::AuxElement::ConstAccessor< std::vector<float> > sumPt500 ("SumPtTrkPt500");
       static SG::AuxElement::ConstAccessor< std::vector<float> > trkWidth500 ("TrackWidthPt500");
-      static SG::AuxElement::ConstAccessor< std::vector<float> > jvf("JVF");
 
-      if ( m_jetInfoSwitch->m_trackAll ) {
+      if ( mask & HelperClasses::JetInfoSwitch::TRACK_ALL ) {
 
-        std::vector<int> junkInt(1,-999);
-        std::vector<float> junkFlt(1,-999);
+        static const std::vector<int> junkInt(1,-999);
+        static const std::vector<float> junkFlt(1,-999);
 
         if ( nTrk1000.isAvailable( *jet_itr ) ) {
-          m_jet_NTrkPt1000.push_back( nTrk1000( *jet_itr ) );
-        } else { m_jet_NTrkPt1000.push_back( junkInt ); }
+          m_jet_NTrkPt1000Branch.push_back( nTrk1000( *jet_itr ) );
+        } else { m_jet_NTrkPt1000Branch.push_back( junkInt ); }
 
         if ( sumPt1000.isAvailable( *jet_itr ) ) {
-          m_jet_SumPtPt1000.push_back( sumPt1000( *jet_itr ) );
-          std::transform((m_jet_SumPtPt1000.back()).begin(),
-              (m_jet_SumPtPt1000.back()).end(),
-              (m_jet_SumPtPt1000.back()).begin(),
-              std::bind2nd(std::divides<float>(), m_units));
-        } else { m_jet_SumPtPt1000.push_back( junkFlt ); }
+          m_jet_SumPtPt1000Branch.push_back( sumPt1000( *jet_itr ), m_units );
+        } else { m_jet_SumPtPt1000Branch.push_back( junkFlt ); }
 
         if ( trkWidth1000.isAvailable( *jet_itr ) ) {
-          m_jet_TrkWPt1000.push_back( trkWidth1000( *jet_itr ) );
-        } else { m_jet_TrkWPt1000.push_back( junkFlt ); }
+          m_jet_TrkWPt1000Branch.push_back( trkWidth1000( *jet_itr ) );
+        } else { m_jet_TrkWPt1000Branch.push_back( junkFlt ); }
 
         if ( nTrk500.isAvailable( *jet_itr ) ) {
-          m_jet_NTrkPt500.push_back( nTrk500( *jet_itr ) );
-        } else { m_jet_NTrkPt500.push_back( junkInt ); }
+          m_jet_NTrkPt500Branch.push_back( nTrk500( *jet_itr ) );
+        } else { m_jet_NTrkPt500Branch.push_back( junkInt ); }
 
         if ( sumPt500.isAvailable( *jet_itr ) ) {
-          m_jet_SumPtPt500.push_back( sumPt500( *jet_itr ) );
-          std::transform((m_jet_SumPtPt500.back()).begin(),
-              (m_jet_SumPtPt500.back()).end(),
-              (m_jet_SumPtPt500.back()).begin(),
-              std::bind2nd(std::divides<float>(), m_units));
-        } else { m_jet_SumPtPt500.push_back( junkFlt ); }
+          m_jet_SumPtPt500Branch.push_back( sumPt500( *jet_itr ), m_units );
+        } else { m_jet_SumPtPt500Branch.push_back( junkFlt ); }
 
         if ( trkWidth500.isAvailable( *jet_itr ) ) {
-          m_jet_TrkWPt500.push_back( trkWidth500( *jet_itr ) );
-        } else { m_jet_TrkWPt500.push_back( junkFlt ); }
+          m_jet_TrkWPt500Branch.push_back( trkWidth500( *jet_itr ) );
+        } else { m_jet_TrkWPt500Branch.push_back( junkFlt ); }
 
-        if ( jvf.isAvailable( *jet_itr ) ) {
-          m_jet_jvf.push_back( jvf( *jet_itr ) );
-        } else { m_jet_jvf.push_back( junkFlt ); }
+        if ( m_jetAttributes.hasJVF( *jet_itr ) ) {
+          m_jet_jvfBranch.push_back( m_jetAttributes.jvf( *jet_itr ) );
+        } else { m_jet_jvfBranch.push_back( junkFlt ); }
 
       }
 
-      if ( m_jetInfoSwitch->m_trackPV && pvLocation >= 0 ) {
+      if ( ( mask & HelperClasses::JetInfoSwitch::TRACK_PV ) && pvLocation >= 0 ) {
 
         if ( nTrk1000.isAvailable( *jet_itr ) ) {
           m_jet_NTrkPt1000PV.push_back( nTrk1000( *jet_itr )[pvLocation] );
@@ -1000,15 +1016,15 @@ void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation ) {
           m_jet_TrkWPt500PV.push_back( trkWidth500( *jet_itr )[pvLocation] );
         } else { m_jet_TrkWPt500PV.push_back( -999 ); }
 
-        if ( jvf.isAvailable( *jet_itr ) ) {
-          m_jet_jvfPV.push_back( jvf( *jet_itr )[pvLocation] );
+        if ( m_jetAttributes.hasJVF( *jet_itr ) ) {
+          m_jet_jvfPV.push_back( m_jetAttributes.jvf( *jet_itr )[pvLocation] );
         } else { m_jet_jvfPV.push_back( -999 ); }
 
       }
 
     }
 
-    if ( m_jetInfoSwitch->m_allTrack ) {
+    if ( mask & HelperClasses::JetInfoSwitch::ALL_TRACK ) {
       static SG::AuxElement::ConstAccessor< int > ghostTrackCount("GhostTrackCount");
       if ( ghostTrackCount.isAvailable( *jet_itr ) ) {
         m_jet_GhostTrackCount.push_back( ghostTrackCount( *jet_itr ) );
@@ -1017,10 +1033,10 @@ void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation ) {
       if ( ghostTrackPt.isAvailable( *jet_itr ) ) {
         m_jet_GhostTrackPt.push_back( ghostTrackPt( *jet_itr ) / m_units );
       } else { m_jet_GhostTrackPt.push_back( -999 ); }
-      std::vector<float> pt;
-      std::vector<float> eta;
-      std::vector<float> phi;
-      std::vector<float> e;
+      m_jet_GhostTrack_ptBranch. newRow();
+      m_jet_GhostTrack_etaBranch.newRow();
+      m_jet_GhostTrack_phiBranch.newRow();
+      m_jet_GhostTrack_eBranch.  newRow();
       static SG::AuxElement::ConstAccessor< std::vector<ElementLink<DataVector<xAOD::IParticle> > > >ghostTrack ("GhostTrack");
       if ( ghostTrack.isAvailable( *jet_itr ) ) {
         std::vector<ElementLink<DataVector<xAOD::IParticle> > > trackLinks = ghostTrack( *jet_itr );
@@ -1029,19 +1045,15 @@ void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation ) {
           if( !link_itr.isValid() ) { continue; }
           const xAOD::IParticle* trk = *link_itr;
           //std::cout << "\t" << trk->pt() << std::endl;
-          pt. push_back( trk->pt() / m_units );
-          eta.push_back( trk->eta() );
-          phi.push_back( trk->phi() );
-          e.  push_back( trk->e()  / m_units );
+          m_jet_GhostTrack_ptBranch. append( trk->pt() / m_units );
+          m_jet_GhostTrack_etaBranch.append( trk->eta() );
+          m_jet_GhostTrack_phiBranch.append( trk->phi() );
+          m_jet_GhostTrack_eBranch.  append( trk->e()  / m_units );
         }
       } // if ghostTrack available
-      m_jet_GhostTrack_pt. push_back( pt  );
-      m_jet_GhostTrack_eta.push_back( eta );
-      m_jet_GhostTrack_phi.push_back( phi );
-      m_jet_GhostTrack_e.  push_back( e   );
     } // allTrack switch
 
-    if ( m_jetInfoSwitch->m_flavTag) {
+    if ( mask & HelperClasses::JetInfoSwitch::FLAVOR_TAG ) {
       const xAOD::BTagging * myBTag = jet_itr->btagging();
       if ( !m_DC14 ) {
         m_jet_sv0.push_back(     myBTag -> SV0_significance3D()       );
@@ -1060,48 +1072,7 @@ void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation ) {
 
     }
 
-    if ( m_jetInfoSwitch->m_truth ) {
-
-      static SG::AuxElement::ConstAccessor<int> ConeTruthLabelID ("ConeTruthLabelID");
-      if ( ConeTruthLabelID.isAvailable( *jet_itr) ) {
-        m_jet_truthConeLabelID.push_back( ConeTruthLabelID( *jet_itr) );
-      } else { m_jet_truthConeLabelID.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<int> TruthCount ("TruthCount");
-      if ( TruthCount.isAvailable( *jet_itr) ) {
-        m_jet_truthCount.push_back( TruthCount( *jet_itr) );
-      } else { m_jet_truthCount.push_back( -999 ); }
-
-//    seems to be empty
-//      static SG::AuxElement::ConstAccessor<float> TruthPt ("TruthPt");
-//      if ( TruthPt.isAvailable( *jet_itr) ) {
-//        m_jet_truthPt.push_back( TruthPt( *jet_itr)/1000 );
-//      } else { m_jet_truthPt.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_B ("TruthLabelDeltaR_B");
-      if ( TruthLabelDeltaR_B.isAvailable( *jet_itr) ) {
-        m_jet_truthDr_B.push_back( TruthLabelDeltaR_B( *jet_itr) );
-      } else { m_jet_truthDr_B.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_C ("TruthLabelDeltaR_C");
-      if ( TruthLabelDeltaR_C.isAvailable( *jet_itr) ) {
-        m_jet_truthDr_C.push_back( TruthLabelDeltaR_C( *jet_itr) );
-      } else { m_jet_truthDr_C.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> TruthLabelDeltaR_T ("TruthLabelDeltaR_T");
-      if ( TruthLabelDeltaR_T.isAvailable( *jet_itr) ) {
-        m_jet_truthDr_T.push_back( TruthLabelDeltaR_T( *jet_itr) );
-      } else { m_jet_truthDr_T.push_back( -999 ) ; }
-
-      static SG::AuxElement::ConstAccessor<int> partonLabel("PartonTruthLabelID");
-      if ( partonLabel.isAvailable( *jet_itr) ) {
-        m_jet_partonTruthID.push_back( partonLabel( *jet_itr) );
-      } else { m_jet_partonTruthID.push_back( -999 ) ; }
-
-      static SG::AuxElement::ConstAccessor<float> ghostTruthAssFrac("GhostTruthAssociationFraction");
-      if ( ghostTruthAssFrac.isAvailable( *jet_itr) ) {
-        m_jet_ghostTruthAssFrac.push_back( ghostTruthAssFrac( *jet_itr) );
-      } else { m_jet_ghostTruthAssFrac.push_back( -999 ) ; }
+    if ( mask & HelperClasses::JetInfoSwitch::TRUTH ) {
 
       const xAOD::Jet* truthJet = HelperFunctions::getLink<xAOD::Jet>( jet_itr, "GhostTruthAssociationLink" );
       if(truthJet) {
@@ -1118,91 +1089,7 @@ void HelpTreeBase::FillJets( const xAOD::JetContainer* jets, int pvLocation ) {
 
     }
 
-    if ( m_jetInfoSwitch->m_truthDetails ) {
-
-      //
-      // B-Hadron Details
-      //
-      static SG::AuxElement::ConstAccessor<int> GhostBHadronsFinalCount ("GhostBHadronsFinalCount");
-      if ( GhostBHadronsFinalCount.isAvailable( *jet_itr) ) {
-        m_jet_truthCount_BhadFinal.push_back( GhostBHadronsFinalCount( *jet_itr) );
-      } else { m_jet_truthCount_BhadFinal.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<int> GhostBHadronsInitialCount ("GhostBHadronsInitialCount");
-      if ( GhostBHadronsInitialCount.isAvailable( *jet_itr) ) {
-        m_jet_truthCount_BhadInit.push_back( GhostBHadronsInitialCount( *jet_itr) );
-      } else { m_jet_truthCount_BhadInit.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<int> GhostBQuarksFinalCount ("GhostBQuarksFinalCount");
-      if ( GhostBQuarksFinalCount.isAvailable( *jet_itr) ) {
-        m_jet_truthCount_BQFinal.push_back( GhostBQuarksFinalCount( *jet_itr) );
-      } else { m_jet_truthCount_BQFinal.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> GhostBHadronsFinalPt ("GhostBHadronsFinalPt");
-      if ( GhostBHadronsFinalPt.isAvailable( *jet_itr) ) {
-        m_jet_truthPt_BhadFinal.push_back( GhostBHadronsFinalPt( *jet_itr) );
-      } else { m_jet_truthPt_BhadFinal.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> GhostBHadronsInitialPt ("GhostBHadronsInitialPt");
-      if ( GhostBHadronsInitialPt.isAvailable( *jet_itr) ) {
-        m_jet_truthPt_BhadInit.push_back( GhostBHadronsInitialPt( *jet_itr) );
-      } else { m_jet_truthPt_BhadInit.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> GhostBQuarksFinalPt ("GhostBQuarksFinalPt");
-      if ( GhostBQuarksFinalPt.isAvailable( *jet_itr) ) {
-        m_jet_truthPt_BQFinal.push_back( GhostBQuarksFinalPt( *jet_itr) );
-      } else { m_jet_truthPt_BQFinal.push_back( -999 ); }
-
-
-      //
-      // C-Hadron Details
-      //
-      static SG::AuxElement::ConstAccessor<int> GhostCHadronsFinalCount ("GhostCHadronsFinalCount");
-      if ( GhostCHadronsFinalCount.isAvailable( *jet_itr) ) {
-        m_jet_truthCount_ChadFinal.push_back( GhostCHadronsFinalCount( *jet_itr) );
-      } else { m_jet_truthCount_ChadFinal.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<int> GhostCHadronsInitialCount ("GhostCHadronsInitialCount");
-      if ( GhostCHadronsInitialCount.isAvailable( *jet_itr) ) {
-        m_jet_truthCount_ChadInit.push_back( GhostCHadronsInitialCount( *jet_itr) );
-      } else { m_jet_truthCount_ChadInit.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<int> GhostCQuarksFinalCount ("GhostCQuarksFinalCount");
-      if ( GhostCQuarksFinalCount.isAvailable( *jet_itr) ) {
-        m_jet_truthCount_CQFinal.push_back( GhostCQuarksFinalCount( *jet_itr) );
-      } else { m_jet_truthCount_CQFinal.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> GhostCHadronsFinalPt ("GhostCHadronsFinalPt");
-      if ( GhostCHadronsFinalPt.isAvailable( *jet_itr) ) {
-        m_jet_truthPt_ChadFinal.push_back( GhostCHadronsFinalPt( *jet_itr) );
-      } else { m_jet_truthPt_ChadFinal.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> GhostCHadronsInitialPt ("GhostCHadronsInitialPt");
-      if ( GhostCHadronsInitialPt.isAvailable( *jet_itr) ) {
-        m_jet_truthPt_ChadInit.push_back( GhostCHadronsInitialPt( *jet_itr) );
-      } else { m_jet_truthPt_ChadInit.push_back( -999 ); }
-
-      static SG::AuxElement::ConstAccessor<float> GhostCQuarksFinalPt ("GhostCQuarksFinalPt");
-      if ( GhostCQuarksFinalPt.isAvailable( *jet_itr) ) {
-        m_jet_truthPt_CQFinal.push_back( GhostCQuarksFinalPt( *jet_itr) );
-      } else { m_jet_truthPt_CQFinal.push_back( -999 ); }
-
-
-      //
-      // Tau Details
-      //
-      static SG::AuxElement::ConstAccessor<int> GhostTausFinalCount ("GhostTausFinalCount");
-      if ( GhostTausFinalCount.isAvailable( *jet_itr) ) {
-        m_jet_truthCount_TausFinal.push_back( GhostTausFinalCount( *jet_itr) );
-      } else { m_jet_truthCount_TausFinal.push_back( -999 ); }
-
-
-      /* THE ONLY UN-OFFICIAL PIECE OF CODE HERE USE WITH CAUTION */
-      static SG::AuxElement::ConstAccessor<float> GhostTausFinalPt ("GhostTausFinalPt");
-      if ( GhostTausFinalPt.isAvailable( *jet_itr) ) {
-        m_jet_truthPt_TausFinal.push_back( GhostTausFinalPt( *jet_itr) );
-      } else { m_jet_truthPt_TausFinal.push_back( -999 ); }
-
+    if ( mask & HelperClasses::JetInfoSwitch::TRUTH_DETAILS ) {
 
       // light quark(1,2,3) , gluon (21 or 9), charm(4) and b(5)
       // GhostPartons should select for these pdgIds only
@@ -1245,6 +1132,8 @@ void HelpTreeBase::AddFatJets(std::string detailStr) {
 void HelpTreeBase::FillFatJets( const xAOD::JetContainer* /*fatJets*/ ) { }
 
 void HelpTreeBase::ClearEvent() {
+
+  this->WaitForFill();
   m_runNumber = m_eventNumber = m_mcEventNumber = m_mcChannelNumber = -999;
   m_mcEventWeight = 1.;
   // pileup
@@ -1293,12 +1182,15 @@ void HelpTreeBase::FillTaus( const xAOD::TauJetContainer* taus ) {
   this->ClearTaus();
   this->ClearTausUser();
 
+  // the switches in one word, so the per-object blocks test a local rather than reload the flags
+  const uint32_t mask = m_tauInfoSwitch->m_mask;
+
   m_ntau = 0;
   for ( auto tau_itr : *(taus) ) {
 
     if ( m_debug ) { Info("HelpTreeBase::FillTaus()", "Filling tau w/ pT = %2f", tau_itr->pt() / m_units ); }
 
-    if ( m_tauInfoSwitch->m_kinematic ) {
+    if ( mask & HelperClasses::TauInfoSwitch::KINEMATIC ) {
       m_tau_pt.push_back ( tau_itr->pt() / m_units  );
       m_tau_eta.push_back( tau_itr->eta() );
       m_tau_phi.push_back( tau_itr->phi() );
@@ -1315,6 +1207,8 @@ void HelpTreeBase::FillTaus( const xAOD::TauJetContainer* taus ) {
 
 void HelpTreeBase::ClearMuons() {
 
+  this->WaitForFill();
+
   m_nmuon = 0;
 
   if ( m_muInfoSwitch->m_kinematic ){
@@ -1354,6 +1248,8 @@ void HelpTreeBase::ClearMuons() {
 
 void HelpTreeBase::ClearElectrons() {
 
+  this->WaitForFill();
+
   m_nel = 0;
 
   if ( m_elInfoSwitch->m_kinematic ){
@@ -1363,20 +1259,8 @@ void HelpTreeBase::ClearElectrons() {
     m_el_m.clear();
   }
 
-  if ( m_elInfoSwitch->m_isolation ) {
-    m_el_isIsolated.clear();
-  }
-  
-  if ( m_elInfoSwitch->m_PID ) {
-    m_el_LHVeryLoose.clear();
-    m_el_LHLoose.clear();
-    m_el_LHMedium.clear();
-    m_el_LHTight.clear();
-    m_el_LHVeryTight.clear();
-    m_el_IsEMLoose.clear();
-    m_el_IsEMMedium.clear();
-    m_el_IsEMTight.clear();
-  }
+  // isolation and PID
+  m_elColumns->clear();
 
   if ( m_elInfoSwitch->m_trackparams ) {
     m_el_trkd0.clear();
@@ -1409,57 +1293,31 @@ void HelpTreeBase::ClearElectrons() {
 
 void HelpTreeBase::ClearJets() {
 
+  this->WaitForFill();
+
   m_njet = 0;
   m_jet_pt.clear();
   m_jet_eta.clear();
   m_jet_phi.clear();
   m_jet_E.clear();
 
-  // clean
-  if( m_jetInfoSwitch->m_clean ) {
-    m_jet_time.clear();
-    m_jet_LArQuality.clear();
-    m_jet_hecq.clear();
-    m_jet_negE.clear();
-    m_jet_avLArQF.clear();
-    m_jet_bchCorrCell.clear();
-    m_jet_N90Const.clear();
-    m_jet_LArBadHVEFrac.clear();
-    m_jet_LArBadHVNCell.clear();
-    m_jet_OotFracClus5.clear();
-    m_jet_OotFracClus10.clear();
-    m_jet_LeadingClusterPt.clear();
-    m_jet_LeadingClusterSecondLambda.clear();
-    m_jet_LeadingClusterCenterLambda.clear();
-    m_jet_LeadingClusterSecondR.clear();
-  }
-
-  // energy
-  if ( m_jetInfoSwitch->m_energy ) {
-    m_jet_HECf.clear();
-    m_jet_EMf.clear();
-    m_jet_centroidR.clear();
-    m_jet_fracSampMax.clear();
-    m_jet_fracSampMaxIdx.clear();
-    m_jet_lowEtFrac.clear();
-    m_jet_muonSegCount.clear();
-    m_jet_width.clear();
-  }
+  // clean, energy and the plain truth variables
+  m_jetColumns->clear();
 
   // layer
   if ( m_jetInfoSwitch->m_layer ) {
-    m_jet_ePerSamp.clear();
+    m_jet_ePerSampBranch.clear();
   }
 
   // trackAll
   if ( m_jetInfoSwitch->m_trackAll ) {
-    m_jet_NTrkPt1000.clear();
-    m_jet_SumPtPt1000.clear();
-    m_jet_TrkWPt1000.clear();
-    m_jet_NTrkPt500.clear();
-    m_jet_SumPtPt500.clear();
-    m_jet_TrkWPt500.clear();
-    m_jet_jvf.clear();
+    m_jet_NTrkPt1000Branch.clear();
+    m_jet_SumPtPt1000Branch.clear();
+    m_jet_TrkWPt1000Branch.clear();
+    m_jet_NTrkPt500Branch.clear();
+    m_jet_SumPtPt500Branch.clear();
+    m_jet_TrkWPt500Branch.clear();
+    m_jet_jvfBranch.clear();
     //m_jet_jvfloose.clear();
   }
 
@@ -1478,10 +1336,10 @@ void HelpTreeBase::ClearJets() {
   if ( m_jetInfoSwitch->m_allTrack ) {
     m_jet_GhostTrackCount.clear();
     m_jet_GhostTrackPt.clear();
-    m_jet_GhostTrack_pt.clear();
-    m_jet_GhostTrack_eta.clear();
-    m_jet_GhostTrack_phi.clear();
-    m_jet_GhostTrack_e.clear();
+    m_jet_GhostTrack_ptBranch.clear();
+    m_jet_GhostTrack_etaBranch.clear();
+    m_jet_GhostTrack_phiBranch.clear();
+    m_jet_GhostTrack_eBranch.clear();
   }
 
   // flavor tag
@@ -1497,14 +1355,7 @@ void HelpTreeBase::ClearJets() {
 
   // truth
   if ( m_jetInfoSwitch->m_truth ) {
-    m_jet_truthConeLabelID.clear();
-    m_jet_truthCount.clear();
     m_jet_truthPt.clear();
-    m_jet_truthDr_B.clear();
-    m_jet_truthDr_C.clear();
-    m_jet_truthDr_T.clear();
-    m_jet_partonTruthID.clear();
-    m_jet_ghostTruthAssFrac.clear();
     m_jet_truth_pt.clear();
     m_jet_truth_eta.clear();
     m_jet_truth_phi.clear();
@@ -1513,20 +1364,6 @@ void HelpTreeBase::ClearJets() {
 
   // truth_detail
   if ( m_jetInfoSwitch->m_truthDetails ) {
-    m_jet_truthCount_BhadFinal.clear();
-    m_jet_truthCount_BhadInit.clear();
-    m_jet_truthCount_BQFinal.clear();
-    m_jet_truthPt_BhadFinal.clear();
-    m_jet_truthPt_BhadInit.clear();
-    m_jet_truthPt_BQFinal.clear();
-    m_jet_truthCount_ChadFinal.clear();
-    m_jet_truthCount_ChadInit.clear();
-    m_jet_truthCount_CQFinal.clear();
-    m_jet_truthPt_ChadFinal.clear();
-    m_jet_truthPt_ChadInit.clear();
-    m_jet_truthPt_CQFinal.clear();
-    m_jet_truthCount_TausFinal.clear();
-    m_jet_truthPt_TausFinal.clear();
     m_jet_truth_pdgId.clear();
     m_jet_truth_partonPt.clear();
     m_jet_truth_partonDR.clear();
@@ -1536,6 +1373,8 @@ void HelpTreeBase::ClearJets() {
 
 void HelpTreeBase::ClearTaus() {
 
+  this->WaitForFill();
+
   m_ntau = 0;
 
   if ( m_tauInfoSwitch->m_kinematic ){
@@ -1551,9 +1390,11 @@ void HelpTreeBase::ClearTaus() {
 
 
 bool HelpTreeBase::writeTo( TFile* file ) {
+  this->WaitForFill();
   file->cd(); // necessary?
   int status( m_tree->Write() );
   if ( status == 0 ) { return false; }
+  if ( m_trigMenuTree && m_trigMenuTree->Write() == 0 ) { return false; }
   return true;
 }
 
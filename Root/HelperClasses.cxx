@@ -4,76 +4,103 @@
 #include "ElectronPhotonSelectorTools/AsgElectronLikelihoodTool.h"
 #include "ElectronPhotonSelectorTools/egammaPIDdefs.h"
 
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
 
 namespace HelperClasses{
 
   /* parser for electron isolation enum */
   template <>
-  EnumParser<xAOD::Iso::IsolationType>::EnumParser()
+  const std::pair<const char*, xAOD::Iso::IsolationType>* EnumParser<xAOD::Iso::IsolationType>::entries()
   {
-
-    std::string etcone20("etcone20");         enumMap.insert(std::make_pair(etcone20,      xAOD::Iso::etcone20));
-    std::string topoetcone20("topoetcone20"); enumMap.insert(std::make_pair(topoetcone20,  xAOD::Iso::topoetcone20));
-    std::string topoetcone30("topoetcone30"); enumMap.insert(std::make_pair(topoetcone30,  xAOD::Iso::topoetcone30));
-    std::string ptcone20("ptcone20");         enumMap.insert(std::make_pair(ptcone20,      xAOD::Iso::ptcone20));
-    std::string ptcone30("ptcone30");         enumMap.insert(std::make_pair(ptcone30,      xAOD::Iso::ptcone30));
+    static const std::pair<const char*, xAOD::Iso::IsolationType> table[] = {
+      { "etcone20",     xAOD::Iso::etcone20     },
+      { "topoetcone20", xAOD::Iso::topoetcone20 },
+      { "topoetcone30", xAOD::Iso::topoetcone30 },
+      { "ptcone20",     xAOD::Iso::ptcone20     },
+      { "ptcone30",     xAOD::Iso::ptcone30     },
+      { nullptr,        xAOD::Iso::etcone20     }
+    };
+    return table;
   }
 
   /* parser for electron likelihood PID enum */
   template <>
-  EnumParser<LikeEnum::Menu>::EnumParser()
+  const std::pair<const char*, LikeEnum::Menu>* EnumParser<LikeEnum::Menu>::entries()
   {
-    std::string VeryLoose("VeryLoose");         enumMap.insert(std::make_pair(VeryLoose  , LikeEnum::VeryLoose));
-    std::string Loose("Loose");                 enumMap.insert(std::make_pair(Loose      , LikeEnum::Loose));
-    std::string Medium("Medium");               enumMap.insert(std::make_pair(Medium     , LikeEnum::Medium));
-    std::string Tight("Tight");                 enumMap.insert(std::make_pair(Tight      , LikeEnum::Tight));
-    std::string VeryTight("VeryTight");         enumMap.insert(std::make_pair(VeryTight  , LikeEnum::VeryTight));
-    std::string LooseRelaxed("LooseRelaxed");   enumMap.insert(std::make_pair(LooseRelaxed      , LikeEnum::LooseRelaxed));
+    static const std::pair<const char*, LikeEnum::Menu> table[] = {
+      { "VeryLoose",    LikeEnum::VeryLoose    },
+      { "Loose",        LikeEnum::Loose        },
+      { "Medium",       LikeEnum::Medium       },
+      { "Tight",        LikeEnum::Tight        },
+      { "VeryTight",    LikeEnum::VeryTight    },
+      { "LooseRelaxed", LikeEnum::LooseRelaxed },
+      { nullptr,        LikeEnum::VeryLoose    }
+    };
+    return table;
   }
 
   /* parser for electron cut-based PID enum */
   /* Apparently this won't be useful for non-Athena users...  */
   template <>
-  EnumParser<egammaPID::egammaIDQuality>::EnumParser()
+  const std::pair<const char*, egammaPID::egammaIDQuality>* EnumParser<egammaPID::egammaIDQuality>::entries()
   {
-    std::string ElectronIDLoosePP("ElectronIDLoosePP");       enumMap.insert(std::make_pair(ElectronIDLoosePP  , egammaPID::ElectronIDLoosePP));
-    std::string ElectronIDLoose1("ElectronIDLoose1");         enumMap.insert(std::make_pair(ElectronIDLoose1   , egammaPID::ElectronIDLoose1));
-    std::string ElectronIDLooseHLT("ElectronIDLooseHLT");     enumMap.insert(std::make_pair(ElectronIDLooseHLT , egammaPID::ElectronIDLooseHLT));
-    std::string ElectronIDMediumPP("ElectronIDMediumPP");     enumMap.insert(std::make_pair(ElectronIDMediumPP , egammaPID::ElectronIDMediumPP));
-    std::string ElectronIDMedium1("ElectronIDMedium1");       enumMap.insert(std::make_pair(ElectronIDMedium1  , egammaPID::ElectronIDMedium1));
-    std::string ElectronIDMediumHLT("ElectronIDMediumHLT");   enumMap.insert(std::make_pair(ElectronIDMediumHLT, egammaPID::ElectronIDMediumHLT));
-    std::string ElectronIDTightPP("ElectronIDTightPP");       enumMap.insert(std::make_pair(ElectronIDTightPP  , egammaPID::ElectronIDTightPP));
-    std::string ElectronIDTight1("ElectronIDTight1");         enumMap.insert(std::make_pair(ElectronIDTight1   , egammaPID::ElectronIDTight1));
-    std::string ElectronIDTightHLT("ElectronIDTightHLT");     enumMap.insert(std::make_pair(ElectronIDTightHLT , egammaPID::ElectronIDTightHLT));
+    static const std::pair<const char*, egammaPID::egammaIDQuality> table[] = {
+      { "ElectronIDLoosePP",   egammaPID::ElectronIDLoosePP   },
+      { "ElectronIDLoose1",    egammaPID::ElectronIDLoose1    },
+      { "ElectronIDLooseHLT",  egammaPID::ElectronIDLooseHLT  },
+      { "ElectronIDMediumPP",  egammaPID::ElectronIDMediumPP  },
+      { "ElectronIDMedium1",   egammaPID::ElectronIDMedium1   },
+      { "ElectronIDMediumHLT", egammaPID::ElectronIDMediumHLT },
+      { "ElectronIDTightPP",   egammaPID::ElectronIDTightPP   },
+      { "ElectronIDTight1",    egammaPID::ElectronIDTight1    },
+      { "ElectronIDTightHLT",  egammaPID::ElectronIDTightHLT  },
+      { nullptr,               egammaPID::ElectronIDLoosePP   }
+    };
+    return table;
   }
   template <>
-  EnumParser<egammaPID::PID>::EnumParser()
+  const std::pair<const char*, egammaPID::PID>* EnumParser<egammaPID::PID>::entries()
   {
-    std::string IsEMLoose("IsEMLoose");     enumMap.insert(std::make_pair( IsEMLoose , egammaPID::IsEMLoose));
-    std::string IsEMMedium("IsEMMedium");   enumMap.insert(std::make_pair( IsEMMedium, egammaPID::IsEMMedium));
-    std::string IsEMTight("IsEMTight");     enumMap.insert(std::make_pair( IsEMTight , egammaPID::IsEMTight));
+    static const std::pair<const char*, egammaPID::PID> table[] = {
+      { "IsEMLoose",  egammaPID::IsEMLoose  },
+      { "IsEMMedium", egammaPID::IsEMMedium },
+      { "IsEMTight",  egammaPID::IsEMTight  },
+      { nullptr,      egammaPID::IsEMLoose  }
+    };
+    return table;
   }
 
 
   /* parser for muon quality enum */
   template <>
-  EnumParser<xAOD::Muon::Quality>::EnumParser()
+  const std::pair<const char*, xAOD::Muon::Quality>* EnumParser<xAOD::Muon::Quality>::entries()
   {
-    std::string VeryLoose("VeryLoose");       enumMap.insert(std::make_pair(VeryLoose    , xAOD::Muon::VeryLoose));
-    std::string Loose("Loose");               enumMap.insert(std::make_pair(Loose        , xAOD::Muon::Loose));
-    std::string Medium("Medium");             enumMap.insert(std::make_pair(Medium       , xAOD::Muon::Medium));
-    std::string Tight("Tight");               enumMap.insert(std::make_pair(Tight        , xAOD::Muon::Tight));
+    static const std::pair<const char*, xAOD::Muon::Quality> table[] = {
+      { "VeryLoose", xAOD::Muon::VeryLoose },
+      { "Loose",     xAOD::Muon::Loose     },
+      { "Medium",    xAOD::Muon::Medium    },
+      { "Tight",     xAOD::Muon::Tight     },
+      { nullptr,     xAOD::Muon::VeryLoose }
+    };
+    return table;
   }
 
   /* parser for muon type enum */
   template <>
-  EnumParser<xAOD::Muon::MuonType>::EnumParser()
+  const std::pair<const char*, xAOD::Muon::MuonType>* EnumParser<xAOD::Muon::MuonType>::entries()
   {
-    std::string Combined("Combined");       				        enumMap.insert(std::make_pair(Combined    		      , xAOD::Muon::Combined));
-    std::string MuonStandAlone("MuonStandAlone");               	        enumMap.insert(std::make_pair(MuonStandAlone        	      , xAOD::Muon::MuonStandAlone));
-    std::string SegmentTagged("SegmentTagged");             		        enumMap.insert(std::make_pair(SegmentTagged       	      , xAOD::Muon::SegmentTagged));
-    std::string CaloTagged("CaloTagged");                                       enumMap.insert(std::make_pair(CaloTagged        	      , xAOD::Muon::CaloTagged));
-    std::string SiliconAssociatedForwardMuon("SiliconAssociatedForwardMuon");   enumMap.insert(std::make_pair(SiliconAssociatedForwardMuon , xAOD::Muon::SiliconAssociatedForwardMuon));
+    static const std::pair<const char*, xAOD::Muon::MuonType> table[] = {
+      { "Combined",                     xAOD::Muon::Combined                     },
+      { "MuonStandAlone",               xAOD::Muon::MuonStandAlone               },
+      { "SegmentTagged",                xAOD::Muon::SegmentTagged                },
+      { "CaloTagged",                   xAOD::Muon::CaloTagged                   },
+      { "SiliconAssociatedForwardMuon", xAOD::Muon::SiliconAssociatedForwardMuon },
+      { nullptr,                        xAOD::Muon::Combined                     }
+    };
+    return table;
   }
 
 
@@ -87,69 +114,83 @@ namespace HelperClasses{
    *  turn a set on
    *
    **************************************/
-  bool InfoSwitch::parse(const std::string flag)
+  InfoSwitch::InfoSwitch(const std::string configStr) :
+    m_configStr(configStr),
+    m_mask(0)
+  {
+    std::stringstream ss(m_configStr);
+    std::string token;
+    while( ss >> token ) { m_configTokens.insert(token); }
+  }
+
+  bool InfoSwitch::parse(const std::string flag, uint32_t bit)
   {
-    return m_configStr.find(flag) != std::string::npos;
+    if( m_configTokens.find(flag) == m_configTokens.end() ) { return false; }
+    m_mask |= bit;
+    return true;
   }
 
   void EventInfoSwitch::initialize(){
-    m_pileup        = parse("pileup");
-    m_shapeEM       = parse("shapeEM");
-    m_shapeLC       = parse("shapeLC");
-    m_truth         = parse("truth");
+    m_pileup        = parse("pileup", PILEUP);
+    m_shapeEM       = parse("shapeEM", SHAPE_EM);
+    m_shapeLC       = parse("shapeLC", SHAPE_LC);
+    m_truth         = parse("truth", TRUTH);
   }
   
   void TriggerInfoSwitch::initialize(){
-    m_basic         = parse("basic");
-    m_menuKeys      = parse("menuKeys");
-    m_allTriggers   = parse("allTriggers");
+    m_basic         = parse("basic", BASIC);
+    m_menuKeys      = parse("menuKeys", MENU_KEYS);
+    m_allTriggers   = parse("allTriggers", ALL_TRIGGERS);
+    m_triggerBits   = parse("triggerBits", TRIGGER_BITS);
   }
   
   void JetTriggerInfoSwitch::initialize(){
-    m_kinematic     = parse("kinematic");
-    m_clean         = parse("clean");
+    m_kinematic     = parse("kinematic", KINEMATIC);
+    m_clean         = parse("clean", CLEAN);
   }
 
   void MuonInfoSwitch::initialize(){
-    m_kinematic     = parse("kinematic");
-    m_trackparams   = parse("trackparams");
-    m_trackhitcont  = parse("trackhitcont");
+    m_kinematic     = parse("kinematic", KINEMATIC);
+    m_trackparams   = parse("trackparams", TRACKPARAMS);
+    m_trackhitcont  = parse("trackhitcont", TRACKHITCONT);
   }
 
   void ElectronInfoSwitch::initialize(){
-    m_kinematic     = parse("kinematic");
-    m_isolation     = parse("isolation");
-    m_PID           = parse("PID");
-    m_trackparams   = parse("trackparams");
-    m_trackhitcont  = parse("trackhitcont");
+    m_kinematic     = parse("kinematic", KINEMATIC);
+    m_isolation     = parse("isolation", ISOLATION);
+    m_PID           = parse("PID", PID);
+    m_trackparams   = parse("trackparams", TRACKPARAMS);
+    m_trackhitcont  = parse("trackhitcont", TRACKHITCONT);
   }
 
   void JetInfoSwitch::initialize(){
-    m_kinematic     = parse("kinematic");
-    m_clean         = parse("clean");
-    m_energy        = parse("energy");
-    m_resolution    = parse("resolution");
-    m_truth         = parse("truth");
-    m_truthDetails  = parse("truth_details");
-    m_layer         = parse("layer");
-    m_trackPV       = parse("trackPV");
-    m_trackAll      = parse("trackAll");
-    m_allTrack      = parse("allTrack");
-    m_flavTag       = parse("flavorTag");
-    if( parse("LeadingJets") ){
-      m_numLeadingJets = std::atoi( (m_configStr.substr( m_configStr.find("LeadingJets")-2 , 2)).c_str() );
-      if (m_numLeadingJets == 0){ //Perhaps infoSwitches are combined and Njets < 10
-        m_numLeadingJets = std::atoi( (m_configStr.substr( m_configStr.find("LeadingJets")-1 , 1)).c_str() );
-      }
-    }else{
-      m_numLeadingJets = 0;
+    m_kinematic     = parse("kinematic", KINEMATIC);
+    m_clean         = parse("clean", CLEAN);
+    m_energy        = parse("energy", ENERGY);
+    m_resolution    = parse("resolution", RESOLUTION);
+    m_truth         = parse("truth", TRUTH);
+    m_truthDetails  = parse("truth_details", TRUTH_DETAILS);
+    m_layer         = parse("layer", LAYER);
+    m_trackPV       = parse("trackPV", TRACK_PV);
+    m_trackAll      = parse("trackAll", TRACK_ALL);
+    m_allTrack      = parse("allTrack", ALL_TRACK);
+    m_flavTag       = parse("flavorTag", FLAVOR_TAG);
+    m_flatVectors   = parse("flatVectors", FLAT_VECTORS);
+    // "<N>LeadingJets", e.g. "kinematic 4LeadingJets"
+    m_numLeadingJets = 0;
+    for( const auto& token : m_configTokens ){
+      std::size_t pos = token.find("LeadingJets");
+      if( pos == std::string::npos || pos == 0 || pos + 11 != token.size() ) { continue; }
+      bool isNumber = true;
+      for( std::size_t k = 0; k < pos; ++k ) { isNumber = isNumber && std::isdigit( token.at(k) ); }
+      if( isNumber ) { m_numLeadingJets = std::atoi( token.substr(0, pos).c_str() ); }
     }
   }
   
   void TauInfoSwitch::initialize(){
-    m_kinematic     = parse("kinematic");
-    m_trackparams   = parse("trackparams");
-    m_trackhitcont  = parse("trackhitcont");
+    m_kinematic     = parse("kinematic", KINEMATIC);
+    m_trackparams   = parse("trackparams", TRACKPARAMS);
+    m_trackhitcont  = parse("trackhitcont", TRACKHITCONT);
   }
 
 } // close namespace HelperClasses
@@ -1,6 +1,8 @@
 #include "xAODAnaHelpers/HelperFunctions.h"
 #include <xAODAnaHelpers/tools/ReturnCheck.h>
 
+#include "RVersion.h"
+
 // jet reclustering
 #include <fastjet/PseudoJet.hh>
 #include <fastjet/ClusterSequence.hh>
@@ -9,6 +11,53 @@
 #include <fastjet/tools/Filter.hh>
 #include <JetEDM/JetConstituentFiller.h>
 
+#include <map>
+#include <mutex>
+
+#include "xAODRootAccess/tools/TIncident.h"
+#include "AthContainers/AuxTypeRegistry.h"
+
+namespace {
+  // what we know about the primary vertices of the current event
+  struct PrimaryVertexSummary {
+    const xAOD::VertexContainer* container = nullptr;
+    unsigned long generation = 0;
+    int location = -1;
+    std::map<int, int> npv; // NPV keyed by the minimum number of tracks
+  };
+
+  // the summary is shared by all the algorithms, and maybe their threads
+  std::mutex primaryVertexMutex;
+
+  // call with primaryVertexMutex held
+  PrimaryVertexSummary& primaryVertexSummary(const xAOD::VertexContainer* vertexContainer)
+  {
+    static PrimaryVertexSummary summary;
+
+    unsigned long generation = HelperFunctions::RetrieveCache::generation();
+    bool valid = generation != 0 && summary.container == vertexContainer && summary.generation == generation;
+    if ( valid ) return summary;
+
+    summary.container  = vertexContainer;
+    summary.generation = generation;
+    summary.npv.clear();
+    summary.location   = -1;
+    int location(0);
+    for( auto vtx_itr : *vertexContainer )
+    {
+      if(vtx_itr->vertexType() == xAOD::VxType::VertexType::PriVtx) {
+        summary.location = location;
+        break;
+      }
+      location++;
+    }
+    // without event boundaries we cannot tell when this goes stale, so never reuse it
+    if ( generation == 0 ) summary.container = nullptr;
+
+    return summary;
+  }
+}
+
 // Get Number of Vertices with at least Ntracks
 bool HelperFunctions::passPrimaryVertexSelection(const xAOD::VertexContainer* vertexContainer, int Ntracks)
 {
@@ -23,6 +72,11 @@ bool HelperFunctions::passPrimaryVertexSelection(const xAOD::VertexContainer* ve
 int HelperFunctions::countPrimaryVertices(const xAOD::VertexContainer* vertexContainer, int Ntracks)
 {
 
+  std::lock_guard<std::mutex> lock( primaryVertexMutex );
+  PrimaryVertexSummary& summary = primaryVertexSummary( vertexContainer );
+  auto found = summary.npv.find( Ntracks );
+  if ( found != summary.npv.end() ) { return found->second; }
+
   int NPV = 0;
 
   // Loop over vertices in the container
@@ -32,21 +86,15 @@ int HelperFunctions::countPrimaryVertices(const xAOD::VertexContainer* vertexCon
     NPV++;
   }
 
+  summary.npv[Ntracks] = NPV;
   return NPV;
 
 }
 
 int HelperFunctions::getPrimaryVertexLocation(const xAOD::VertexContainer* vertexContainer)
 {
-  int location(0);
-  for( auto vtx_itr : *vertexContainer )
-  {
-    if(vtx_itr->vertexType() == xAOD::VxType::VertexType::PriVtx) {
-      return location;
-    }
-    location++;
-  }
-  return -1;
+  std::lock_guard<std::mutex> lock( primaryVertexMutex );
+  return primaryVertexSummary( vertexContainer ).location;
 }
 
 std::string HelperFunctions::replaceString(std::string subject, const std::string& search, const std::string& replace)
@@ -60,6 +108,36 @@ std::string HelperFunctions::replaceString(std::string subject, const std::strin
 }
 
 
+int HelperFunctions::compressionSettings(const std::string& algorithm, int level)
+{
+  // the values of ROOT::ECompressionAlgorithm, spelled out since the newer ones
+  // are not in the header of older ROOT versions. LZ4 is only usable from 6.10
+  // and ZSTD from 6.20: with an older ROOT they fall back to ZLIB, the fastest
+  // of the ones it has
+  int code(-1);
+  if      ( algorithm == "ZLIB" ) { code = 1; }
+  else if ( algorithm == "LZMA" ) { code = 2; }
+  else if ( algorithm == "LZ4"  ) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+    code = 4;
+#else
+    Warning("HelperFunctions::compressionSettings()", "LZ4 needs ROOT 6.10 or newer, writing ZLIB instead");
+    code = 1;
+#endif
+  }
+  else if ( algorithm == "ZSTD" ) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+    code = 5;
+#else
+    Warning("HelperFunctions::compressionSettings()", "ZSTD needs ROOT 6.20 or newer, writing ZLIB instead");
+    code = 1;
+#endif
+  }
+  if ( code < 0 || level < 0 || level > 9 ) { return -1; }
+  return 100*code + level;
+}
+
+
 StatusCode HelperFunctions::isAvailableMetaData(TTree* metaData){
     if ( !metaData ) {
       Info("HelperFunctions::isAvailableMetaData()", "MetaData tree missing from input file. Aborting ");
@@ -217,13 +295,9 @@ const xAOD::Vertex* HelperFunctions::getPrimaryVertex(const xAOD::VertexContaine
 {
   // vertex types are listed on L328 of
   // https://svnweb.cern.ch/trac/atlasoff/browser/Event/xAOD/xAODTracking/trunk/xAODTracking/TrackingPrimitives.h
-  for( auto vtx_itr : *vertexContainer )
-  {
-    if(vtx_itr->vertexType() != xAOD::VxType::VertexType::PriVtx) { continue; }
-    return vtx_itr;
-  }
-
-  return 0;
+  int location = getPrimaryVertexLocation( vertexContainer );
+  if ( location < 0 ) { return 0; }
+  return vertexContainer->at( location );
 }
 
 bool HelperFunctions::sort_pt(xAOD::IParticle* partA, xAOD::IParticle* partB){
@@ -279,3 +353,130 @@ std::vector< CP::SystematicSet > HelperFunctions::getListofSystematics(const CP:
   } // loop over recommended systematics
   return systList;
 }
+
+std::mutex HelperFunctions::RetrieveCache::s_mutex;
+std::map< const xAOD::TEvent*, HelperFunctions::RetrieveCache* > HelperFunctions::RetrieveCache::s_caches;
+std::atomic<unsigned long> HelperFunctions::RetrieveCache::s_generation(0);
+std::atomic<unsigned long> HelperFunctions::RetrieveCache::s_hits(0);
+std::atomic<unsigned long> HelperFunctions::RetrieveCache::s_misses(0);
+
+HelperFunctions::RetrieveCache::RetrieveCache() :
+  m_listening(false),
+  m_entry(0),
+  m_cachedEntry(0)
+{}
+
+HelperFunctions::RetrieveCache* HelperFunctions::RetrieveCache::forEvent(xAOD::TEvent* event){
+  if ( !event ) return nullptr;
+
+  std::lock_guard<std::mutex> lock(s_mutex);
+  auto it = s_caches.find(event);
+  if ( it != s_caches.end() ) return it->second;
+
+  // the caches live as long as the process, only their content is dropped
+  RetrieveCache* cache = new RetrieveCache();
+  cache->m_listening = event->addListener(cache).isSuccess();
+  if ( !cache->m_listening ) {
+    Warning("HelperFunctions::RetrieveCache", "Cannot listen to the incidents of the TEvent, retrieve() will not cache its objects");
+  }
+  s_caches[event] = cache;
+  return cache;
+}
+
+void HelperFunctions::RetrieveCache::open(xAOD::TEvent* event){
+  if ( !event ) return;
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    auto it = s_caches.find(event);
+    if ( it != s_caches.end() ) {
+      RetrieveCache* cache = it->second;
+      bool listening(false);
+      {
+        std::lock_guard<std::mutex> cacheLock(cache->m_mutex);
+        // the job has not loaded an entry yet, so one that heard of entries was left by an
+        // earlier TEvent at this address, gone without a finalize
+        if ( cache->m_listening && !cache->m_entry ) return;
+        listening = cache->m_listening;
+        cache->m_listening = false;
+        cache->m_cache.clear();
+      }
+      s_caches.erase(it);
+      // one still listening is never freed, it may be on the listener list of that TEvent
+      if ( !listening ) delete cache;
+    }
+  }
+  forEvent(event);
+}
+
+void HelperFunctions::RetrieveCache::recorded(const std::string& name){
+  std::lock_guard<std::mutex> lock(s_mutex);
+  for ( auto& it : s_caches ) {
+    std::lock_guard<std::mutex> cacheLock(it.second->m_mutex);
+    it.second->m_cache.erase(name);
+  }
+}
+
+void HelperFunctions::RetrieveCache::release(xAOD::TEvent* event){
+  std::lock_guard<std::mutex> lock(s_mutex);
+  auto it = s_caches.find(event);
+  if ( it == s_caches.end() ) return;
+  RetrieveCache* cache = it->second;
+  std::lock_guard<std::mutex> cacheLock(cache->m_mutex);
+  if ( !cache->m_listening ) return;
+  event->removeListener(cache).ignore();
+  cache->m_listening = false;
+  cache->m_cache.clear();
+}
+
+void HelperFunctions::RetrieveCache::handle(const xAOD::TIncident& inc){
+  if ( inc.type() != xAOD::IncidentType::BeginEvent ) return;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_entry;
+  ++s_generation;
+}
+
+StatusCode HelperFunctions::preloadEvent(xAOD::TEvent* event, xAOD::TStore* store, bool debug){
+  const xAOD::EventInfo* eventInfo(nullptr);
+  if ( !retrieve(eventInfo, "EventInfo", event, store, debug).isSuccess() ) {
+    Error("HelperFunctions::preloadEvent()", "Failed to retrieve EventInfo");
+    return StatusCode::FAILURE;
+  }
+  preloadAux(eventInfo, { "runNumber", "eventNumber", "mcChannelNumber", "eventTypeBitmask",
+                         "averageInteractionsPerCrossing", "actualInteractionsPerCrossing", "RandomRunNumber" });
+
+  // not in every derivation, the tools that need it fail on their own
+  const xAOD::VertexContainer* vertices(nullptr);
+  if ( ( store && store->contains<const xAOD::VertexContainer>("PrimaryVertices") ) || ( event && event->contains<const xAOD::VertexContainer>("PrimaryVertices") ) ) {
+    if ( !retrieve(vertices, "PrimaryVertices", event, store, debug).isSuccess() ) {
+      Error("HelperFunctions::preloadEvent()", "Failed to retrieve PrimaryVertices");
+      return StatusCode::FAILURE;
+    }
+    preloadAux(vertices, { "vertexType", "trackParticleLinks", "z" });
+  }
+
+  return StatusCode::SUCCESS;
+}
+
+void HelperFunctions::preloadAux(const std::set<const SG::AuxVectorData*>& containers, const std::vector<std::string>& variables){
+  // the ids of the variables are known once any input container having them was connected
+  std::vector<SG::auxid_t> auxids;
+  for ( const std::string& name : variables ) {
+    SG::auxid_t auxid = SG::AuxTypeRegistry::instance().findAuxID(name);
+    if ( auxid != SG::null_auxid ) auxids.push_back(auxid);
+  }
+
+  for ( const SG::AuxVectorData* cont : containers ) {
+    const SG::IConstAuxStore* auxStore = cont ? cont->getConstStore() : nullptr;
+    if ( !auxStore ) continue;
+    const SG::auxid_set_t& available = auxStore->getAuxIDs();
+    // getData() is what makes TAuxStore read the variable of the current entry
+    for ( SG::auxid_t auxid : auxids ) {
+      if ( available.count(auxid) ) auxStore->getData(auxid);
+    }
+  }
+}
+
+void HelperFunctions::preloadAux(const SG::AuxElement* obj, const std::vector<std::string>& variables){
+  if ( !obj ) return;
+  preloadAux(std::set<const SG::AuxVectorData*>{ obj->container() }, variables);
+}
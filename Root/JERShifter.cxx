@@ -115,6 +115,8 @@ EL::StatusCode JERShifter :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode JERShifter :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -157,6 +159,8 @@ EL::StatusCode JERShifter :: initialize ()
 
 EL::StatusCode JERShifter :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -185,8 +189,8 @@ EL::StatusCode JERShifter :: execute ()
   }
 
   // add shallow copy to TStore
-  RETURN_CHECK( "JERShifter::execute()", m_store->record( smearedJets.first, m_outContainerName ), "Failed to store container");
-  RETURN_CHECK( "JERShifter::execute()", m_store->record( smearedJets.second, m_outAuxContainerName ), "Failed to store aux container");
+  RETURN_CHECK( "JERShifter::execute()", HelperFunctions::record( smearedJets.first, m_outContainerName, m_store ), "Failed to store container");
+  RETURN_CHECK( "JERShifter::execute()", HelperFunctions::record( smearedJets.second, m_outAuxContainerName, m_store ), "Failed to store aux container");
 
   return EL::StatusCode::SUCCESS;
 }
@@ -204,6 +208,8 @@ EL::StatusCode JERShifter :: postExecute ()
 
 EL::StatusCode JERShifter :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   if(m_JERTool) delete m_JERTool;
   if(m_JERSmearing) delete m_JERSmearing;
 
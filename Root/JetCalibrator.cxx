@@ -8,7 +8,9 @@
  ******************************************/
 
 // c++ include(s):
+#include <algorithm>
 #include <iostream>
+#include <memory>
 
 // EL include(s):
 #include <EventLoop/Job.h>
@@ -44,7 +46,8 @@ JetCalibrator :: JetCalibrator () :
   m_runSysts(false),          // gets set later is syst applies to this tool
   m_jetCalibration(nullptr),  // JetCalibrationTool
   m_jetCleaning(nullptr),     // JetCleaningTool
-  m_jetUncert(nullptr)        // JetUncertaintiesTool
+  m_jetUncert(nullptr),       // JetUncertaintiesTool
+  m_systPool(nullptr)         // threads for the systematics
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -90,6 +93,8 @@ EL::StatusCode  JetCalibrator :: configure ()
 
     // CONFIG parameters for JetUncertaintiesTool
     m_uncertConfig            = config->GetValue("JetUncertConfig", "");
+    // number of threads (and of JetUncertaintiesTool instances) the variations are spread over
+    m_systThreads             = config->GetValue("SystThreads", static_cast<int>(m_systThreads));
     // calibrator uses TopoEM or TopoLC while the uncertainity tool uses EMTopo and LCTopo
     // calibrator should switch at some point
     // "fix" the name here so the user never knows the difference
@@ -123,6 +128,11 @@ EL::StatusCode  JetCalibrator :: configure ()
   m_outSCContainerName      = m_outContainerName + "ShallowCopy";
   m_outSCAuxContainerName   = m_outSCContainerName + "Aux."; // the period is very important!
 
+  // the names of the containers of each systematic
+  m_outSCKeys               = SystematicKeys( m_outSCContainerName );
+  m_outSCAuxKeys            = SystematicKeys( m_outSCAuxContainerName );
+  m_outKeys                 = SystematicKeys( m_outContainerName );
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -153,6 +163,9 @@ EL::StatusCode JetCalibrator :: histInitialize ()
   // beginning on each worker node, e.g. create histograms and output
   // trees.  This method gets called before any input files are
   // connected.
+
+  // the systematic threads need ROOT to be thread safe before the input is read
+  if ( this->configValue( "SystThreads", static_cast<int>(m_systThreads) ) > 1 ) { xAH::Algorithm::enableThreadSafety(); }
   return EL::StatusCode::SUCCESS;
 }
 
@@ -179,6 +192,8 @@ EL::StatusCode JetCalibrator :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode JetCalibrator :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -262,12 +277,7 @@ EL::StatusCode JetCalibrator :: initialize ()
     m_uncertConfig = gSystem->ExpandPathName( m_uncertConfig.c_str() );
     Info("initialize()","Initialize JES UNCERT with %s", m_uncertConfig.c_str());
     std::string ju_tool_name = std::string("JESProvider_") + m_name;
-    m_jetUncert = new JetUncertaintiesTool( ju_tool_name.c_str() );
-    RETURN_CHECK("JetCalibrator::initialize()", m_jetUncert->setProperty("JetDefinition",m_jetUncertAlgo), "");
-    RETURN_CHECK("JetCalibrator::initialize()", m_jetUncert->setProperty("MCType","MC12"), "");
-    RETURN_CHECK("JetCalibrator::initialize()", m_jetUncert->setProperty("ConfigFile", m_uncertConfig), "");
-    RETURN_CHECK("JetCalibrator::initialize()", m_jetUncert->initialize(), "");
-    m_jetUncert->msg().setLevel( MSG::ERROR ); // VERBOSE, INFO, DEBUG
+    RETURN_CHECK("JetCalibrator::initialize()", this->makeUncertTool( m_jetUncert, ju_tool_name ), "");
     const CP::SystematicSet recSysts = m_jetUncert->recommendedSystematics();
 
     Info("initialize()"," Initializing Jet Systematics :");
@@ -283,13 +293,25 @@ EL::StatusCode JetCalibrator :: initialize ()
         return EL::StatusCode::FAILURE;
       }
     }
+
+    // an instance of the tool for every further thread, no more than there are variations
+    m_jetUncertTools.assign( 1, m_jetUncert );
+    for ( unsigned int iTool = 1; iTool < m_systThreads && iTool < m_systList.size(); ++iTool ) {
+      JetUncertaintiesTool* jetUncert(nullptr);
+      RETURN_CHECK("JetCalibrator::initialize()", this->makeUncertTool( jetUncert, ju_tool_name + "_" + std::to_string(iTool) ), "");
+      m_jetUncertTools.push_back( jetUncert );
+    }
   } // running systematics
   else {
     Info("initialize()", "No uncertainities considered");
     // m_jetUncert not streamed so have to do this
     m_runSysts = false; m_jetUncert = nullptr;
+    m_jetUncertTools.clear();
   }
 
+  m_systPool = new TaskPool( std::max<unsigned int>( m_jetUncertTools.size(), 1 ) );
+  if ( m_systPool->workers() > 1 ) { Warning("initialize()", "Evaluating the systematics with %u threads. This is experimental: the CP tools may still read the input from the threads", m_systPool->workers()); }
+
   // if not running systematics, need the nominal
   // if running systematics, and running them all, need the nominal
   // add it to the front!
@@ -299,9 +321,12 @@ EL::StatusCode JetCalibrator :: initialize ()
     m_systList.begin()->insert(nullVar);
   }
 
-  for ( const auto& syst_it : m_systList ){
+  m_systIds.clear();
+  for ( const auto& syst_it : m_systList ) {
     Info("initialize()"," Running with systematic : %s", (syst_it.name()).c_str());
+    m_systIds.push_back( SystematicIndex::instance().id( syst_it.name() ) );
   }
+  SystematicIndex::instance().declareList( m_outputAlgo, m_systIds );
 
   return EL::StatusCode::SUCCESS;
 }
@@ -309,6 +334,8 @@ EL::StatusCode JetCalibrator :: initialize ()
 
 EL::StatusCode JetCalibrator :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -322,62 +349,96 @@ EL::StatusCode JetCalibrator :: execute ()
   const xAOD::JetContainer* inJets(nullptr);
   RETURN_CHECK("JetCalibrator::execute()", HelperFunctions::retrieve(inJets, m_inContainerName, m_event, m_store, m_debug) ,"");
 
-  // loop over available systematics - remember syst == "Nominal" --> baseline
-  std::vector< std::string >* vecOutContainerNames = new std::vector< std::string >;
-  for ( const auto& syst_it : m_systList ) {
-
-    std::string outSCContainerName(m_outSCContainerName);
-    std::string outSCAuxContainerName(m_outSCAuxContainerName);
-    std::string outContainerName(m_outContainerName);
+  // calibrate once - the nominal shallow copy is the base of all variations
+  std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > nominalJetsSC = xAOD::shallowCopyContainer( *inJets );
+  for ( auto jet_itr : *(nominalJetsSC.first) ) {
+    if ( m_jetCalibration->applyCorrection( *jet_itr ) == CP::CorrectionCode::Error ) {
+      Error("execute()", "JetCalibration tool reported a CP::CorrectionCode::Error");
+      Error("execute()", "%s", m_name.c_str());
+      return StatusCode::FAILURE;
+    }
+  }
 
-    // always append the name of the variation, including nominal which is an empty string
-    outSCContainerName    += syst_it.name();
-    outSCAuxContainerName += syst_it.name();
-    outContainerName      += syst_it.name();
-    vecOutContainerNames->push_back( syst_it.name() );
+  if ( !xAOD::setOriginalObjectLink(*inJets, *(nominalJetsSC.first)) ) {
+    Error("execute()  ", "Failed to set original object links -- MET rebuilding cannot proceed.");
+  }
 
-    if ( m_runSysts ) {
-      if( m_debug ) { std::cout << "Configure for systematic variation : " << syst_it.name() << std::endl; }
-      if ( m_jetUncert->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
-        Error("execute()", "Cannot configure JetUncertaintiesTool for systematic %s", m_systName.c_str());
-        return EL::StatusCode::FAILURE;
-      }
+  // recorded even if nominal is not in the list, the variations read through to it
+  RETURN_CHECK( "JetCalibrator::execute()", HelperFunctions::record( nominalJetsSC.first, m_outSCContainerName, m_store ), "Failed to record shallow copy container.");
+  RETURN_CHECK( "JetCalibrator::execute()", HelperFunctions::record( nominalJetsSC.second, m_outSCAuxContainerName, m_store ), "Failed to record shallow copy aux container.");
+
+  // a variation is a shallow copy of the calibrated nominal: its own aux store only holds what
+  // is written on it (the four-momentum by the uncertainty tool, the cleaning below, the
+  // decorations of later algorithms), everything else - the calibration scale momenta included -
+  // is read from the nominal. Nothing written on a variation goes back to the nominal
+  // They are owned here until recorded, so that a failure on the way does not leak them
+  std::vector< std::pair< std::unique_ptr<xAOD::JetContainer>, std::unique_ptr<xAOD::ShallowAuxContainer> > > systJetsSC( m_systList.size() );
+  for ( unsigned int iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
+    if ( m_systIds.at(iSyst) == 0 ) { continue; }
+    std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > jetsSC = xAOD::shallowCopyContainer( *(nominalJetsSC.first) );
+    systJetsSC.at(iSyst).first.reset( jetsSC.first );
+    systJetsSC.at(iSyst).second.reset( jetsSC.second );
+    // TStore is not thread safe, the links are set here rather than by the threads
+    if ( !xAOD::setOriginalObjectLink(*inJets, *(systJetsSC.at(iSyst).first)) ) {
+      Error("execute()  ", "Failed to set original object links -- MET rebuilding cannot proceed.");
     }
+  }
 
-    // create shallow copy;
-    std::pair< xAOD::JetContainer*, xAOD::ShallowAuxContainer* > calibJetsSC = xAOD::shallowCopyContainer( *inJets );
-    ConstDataVector<xAOD::JetContainer>* calibJetsCDV = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
-    calibJetsCDV->reserve( calibJetsSC.first->size() );
+  // the threads should not make TEvent read anything: what the uncertainty tool looks at is read here
+  if ( m_systPool->workers() > 1 ) {
+    RETURN_CHECK("JetCalibrator::execute()", HelperFunctions::preloadEvent(m_event, m_store, m_debug), "");
+    HelperFunctions::preloadAux( inJets, { "pt", "eta", "phi", "m", "TruthLabelID", "PartonTruthLabelID", "ConeTruthLabelID", "GhostMuonSegmentCount" } );
+  }
 
-    // calibrate and decorate with cleaning decision
-    for ( auto jet_itr : *(calibJetsSC.first) ) {
-      m_numObject++;
+  // the variations are independent, each worker of the pool has its own uncertainty tool
+  bool systOk = m_systPool->run( m_systList.size(), [&]( unsigned int worker, unsigned int iSyst ) {
+    if ( !systJetsSC.at(iSyst).first ) { return true; }
+
+    const CP::SystematicSet& syst_it = m_systList.at(iSyst);
+    JetUncertaintiesTool* jetUncert = m_jetUncertTools.at(worker);
 
-      if ( m_jetCalibration->applyCorrection( *jet_itr ) == CP::CorrectionCode::Error ) {
-        Error("execute()", "JetCalibration tool reported a CP::CorrectionCode::Error");
+    if ( m_debug ) { Info("execute()", "Configure for systematic variation : %s", syst_it.name().c_str()); }
+    if ( jetUncert->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
+      Error("execute()", "Cannot configure JetUncertaintiesTool for systematic %s", syst_it.name().c_str());
+      return false;
+    }
+
+    for ( auto jet_itr : *(systJetsSC.at(iSyst).first) ) {
+      if ( jetUncert->applyCorrection( *jet_itr ) == CP::CorrectionCode::Error ) {
+        Error("execute()", "JetUncertaintiesTool reported a CP::CorrectionCode::Error");
         Error("execute()", "%s", m_name.c_str());
-        return StatusCode::FAILURE;
       }
+    }
+    return true;
+  });
+  if ( !systOk ) { return EL::StatusCode::FAILURE; }
 
-      if ( m_runSysts ) {
-        if ( m_jetUncert->applyCorrection( *jet_itr ) == CP::CorrectionCode::Error ) {
-          Error("execute()", "JetUncertaintiesTool reported a CP::CorrectionCode::Error");
-          Error("execute()", "%s", m_name.c_str());
-        }
-      }
+  // record in the order of the list, whichever thread finished first
+  for ( unsigned int iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
 
-      // decorate with cleaning decision
-      static SG::AuxElement::Decorator< char > isCleanDecor( "cleanJet" );
-      isCleanDecor( *jet_itr ) = m_jetCleaning->accept( *jet_itr );
+    unsigned int systId = m_systIds.at(iSyst);
 
-    }
+    xAOD::JetContainer* calibJets = nominalJetsSC.first;
 
-    if ( !xAOD::setOriginalObjectLink(*inJets, *(calibJetsSC.first)) ) {
-      Error("execute()  ", "Failed to set original object links -- MET rebuilding cannot proceed.");
+    if ( systId != 0 ) {
+
+      // add shallow copy to TStore, which owns it from then on
+      RETURN_CHECK( "JetCalibrator::execute()", HelperFunctions::record( systJetsSC.at(iSyst).first.get(), m_outSCKeys[systId], m_store ), "Failed to record shallow copy container.");
+      calibJets = systJetsSC.at(iSyst).first.release();
+      RETURN_CHECK( "JetCalibrator::execute()", HelperFunctions::record( systJetsSC.at(iSyst).second.get(), m_outSCAuxKeys[systId], m_store ), "Failed to record shallow copy aux container.");
+      systJetsSC.at(iSyst).second.release();
     }
 
-    // save pointers in ConstDataVector with same order
-    for ( auto jet_itr : *(calibJetsSC.first) ) {
+    ConstDataVector<xAOD::JetContainer>* calibJetsCDV = new ConstDataVector<xAOD::JetContainer>(SG::VIEW_ELEMENTS);
+    calibJetsCDV->reserve( calibJets->size() );
+
+    // decorate with cleaning decision - per variation, it depends on the jet pt
+    // and save pointers in ConstDataVector with same order
+    for ( auto jet_itr : *calibJets ) {
+      m_numObject++;
+
+      static SG::AuxElement::Decorator< char > isCleanDecor( "cleanJet" );
+      isCleanDecor( *jet_itr ) = m_jetCleaning->accept( *jet_itr );
       calibJetsCDV->push_back( jet_itr );
     }
 
@@ -386,16 +447,12 @@ EL::StatusCode JetCalibrator :: execute ()
       std::sort( calibJetsCDV->begin(), calibJetsCDV->end(), HelperFunctions::sort_pt );
     }
 
-    // add shallow copy to TStore
-    RETURN_CHECK( "JetCalibrator::execute()", m_store->record( calibJetsSC.first, outSCContainerName), "Failed to record shallow copy container.");
-    RETURN_CHECK( "JetCalibrator::execute()", m_store->record( calibJetsSC.second, outSCAuxContainerName), "Failed to record shallow copy aux container.");
-
     // add ConstDataVector to TStore
-    RETURN_CHECK( "JetCalibrator::execute()", m_store->record( calibJetsCDV, outContainerName), "Failed to record const data container.");
+    RETURN_CHECK( "JetCalibrator::execute()", HelperFunctions::record( calibJetsCDV, m_outKeys[systId], m_store ), "Failed to record const data container.");
   }
 
-  // add vector of systematic names to TStore
-  RETURN_CHECK( "JetCalibrator::execute()", m_store->record( vecOutContainerNames, m_outputAlgo), "Failed to record vector of output container names.");
+  // add the ids of the systematics to TStore
+  RETURN_CHECK( "JetCalibrator::execute()", SystematicIndex::instance().recordList( new std::vector< unsigned int >( m_systIds ), m_outputAlgo, m_store ), "Failed to record vector of systematic ids.");
 
   // look what do we have in TStore
   if ( m_debug ) { m_store->print(); }
@@ -405,6 +462,20 @@ EL::StatusCode JetCalibrator :: execute ()
 
 
 
+EL::StatusCode JetCalibrator :: makeUncertTool ( JetUncertaintiesTool*& jetUncert, const std::string& name )
+{
+  jetUncert = new JetUncertaintiesTool( name.c_str() );
+  RETURN_CHECK("JetCalibrator::makeUncertTool()", jetUncert->setProperty("JetDefinition",m_jetUncertAlgo), "");
+  RETURN_CHECK("JetCalibrator::makeUncertTool()", jetUncert->setProperty("MCType","MC12"), "");
+  RETURN_CHECK("JetCalibrator::makeUncertTool()", jetUncert->setProperty("ConfigFile", m_uncertConfig), "");
+  RETURN_CHECK("JetCalibrator::makeUncertTool()", jetUncert->initialize(), "");
+  jetUncert->msg().setLevel( MSG::ERROR ); // VERBOSE, INFO, DEBUG
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
+
 EL::StatusCode JetCalibrator :: postExecute ()
 {
   // Here you do everything that needs to be done after the main event
@@ -420,6 +491,8 @@ EL::StatusCode JetCalibrator :: postExecute ()
 
 EL::StatusCode JetCalibrator :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -438,9 +511,17 @@ EL::StatusCode JetCalibrator :: finalize ()
   if ( m_jetCleaning ) {
     delete m_jetCleaning; m_jetCleaning = nullptr;
   }
+  // the first of them is m_jetUncert
+  for ( unsigned int iTool = 1; iTool < m_jetUncertTools.size(); ++iTool ) {
+    delete m_jetUncertTools.at(iTool);
+  }
+  m_jetUncertTools.clear();
   if ( m_jetUncert ) {
     delete m_jetUncert; m_jetUncert = nullptr;
   }
+  if ( m_systPool ) {
+    delete m_systPool; m_systPool = nullptr;
+  }
 
   return EL::StatusCode::SUCCESS;
 }
@@ -233,6 +233,9 @@ StatusCode JetHists::execute( const xAOD::JetContainer* jets, float eventWeight,
 
 StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int pvLoc ) {
 
+  // the switches in one word, so the blocks below test a local rather than reload the flags
+  const uint32_t mask = m_infoSwitch->m_mask;
+
   //basic
   m_jetPt ->        Fill( jet->pt()/1e3,    eventWeight );
   m_jetEta->        Fill( jet->eta(),       eventWeight );
@@ -242,14 +245,14 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int pvLoc
   m_jetRapidity->   Fill( jet->rapidity(),  eventWeight );
 
   // kinematic
-  if( m_infoSwitch->m_kinematic ) {
+  if ( mask & HelperClasses::JetInfoSwitch::KINEMATIC ) {
     m_jetPx->  Fill( jet->px()/1e3,  eventWeight );
     m_jetPy->  Fill( jet->py()/1e3,  eventWeight );
     m_jetPz->  Fill( jet->pz()/1e3,  eventWeight );
   } // fillKinematic
 
   // clean
-  if( m_infoSwitch->m_clean ) {
+  if ( mask & HelperClasses::JetInfoSwitch::CLEAN ) {
 
     static SG::AuxElement::ConstAccessor<float> jetTime ("Timing");
     if( jetTime.isAvailable( *jet ) ) {
@@ -303,7 +306,7 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int pvLoc
   } // fillClean
 
   // energy
-  if( m_infoSwitch->m_energy ) {
+  if ( mask & HelperClasses::JetInfoSwitch::ENERGY ) {
 
     static SG::AuxElement::ConstAccessor<float> HECf ("HECFrac");
     if( HECf.isAvailable( *jet ) ) {
@@ -348,7 +351,7 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int pvLoc
 
   }
 
-  if( m_infoSwitch->m_layer ){
+  if ( mask & HelperClasses::JetInfoSwitch::LAYER ){
     static SG::AuxElement::ConstAccessor< std::vector<float> > ePerSamp ("EnergyPerSampling");
     if( ePerSamp.isAvailable( *jet ) ) {
       std::vector<float> ePerSampVals = ePerSamp( *jet );
@@ -487,7 +490,7 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int pvLoc
  // 0042       TruthMF,
  // 0043       TruthMFindex,
 
-  if( m_infoSwitch->m_truth ) {
+  if ( mask & HelperClasses::JetInfoSwitch::TRUTH ) {
 
     static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
     if( TruthLabelID.isAvailable( *jet ) ) {
@@ -527,7 +530,7 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int pvLoc
   }
 
 
-  if( m_infoSwitch->m_truthDetails ) {
+  if ( mask & HelperClasses::JetInfoSwitch::TRUTH_DETAILS ) {
 
     //
     // B-Hadron Details
@@ -617,7 +620,7 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int pvLoc
   //
   // BTagging
   //
-  if( m_infoSwitch->m_flavTag ) {
+  if ( mask & HelperClasses::JetInfoSwitch::FLAVOR_TAG ) {
 
     const xAOD::BTagging *btag_info = jet->btagging();
     m_MV1 ->  Fill( btag_info->MV1_discriminant() , eventWeight );
@@ -644,9 +647,10 @@ StatusCode JetHists::execute( const xAOD::Jet* jet, float eventWeight, int pvLoc
 
 
   // testing
-  if( m_infoSwitch->m_resolution ) {
+  if ( mask & HelperClasses::JetInfoSwitch::RESOLUTION ) {
     //float ghostTruthPt = jet->getAttribute( xAOD::JetAttribute::GhostTruthPt );
-    float ghostTruthPt = jet->auxdata< float >( "GhostTruthPt" );
+    static SG::AuxElement::ConstAccessor< float > ghostTruthPtAcc( "GhostTruthPt" );
+    float ghostTruthPt = ghostTruthPtAcc( *jet );
     m_jetGhostTruthPt -> Fill( ghostTruthPt/1e3, eventWeight );
     float resolution = jet->pt()/ghostTruthPt - 1;
     m_jetPt_vs_resolution -> Fill( jet->pt()/1e3, resolution, eventWeight );
@@ -86,6 +86,9 @@ EL::StatusCode JetHistsAlgo :: configure ()
     return EL::StatusCode::FAILURE;
   }
 
+  // the names of the containers of each systematic
+  m_inKeys = SystematicKeys( m_inContainerName );
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -94,6 +97,8 @@ EL::StatusCode JetHistsAlgo :: changeInput (bool /*firstFile*/) { return EL::Sta
 
 EL::StatusCode JetHistsAlgo :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   Info("initialize()", m_name.c_str());
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
@@ -102,6 +107,8 @@ EL::StatusCode JetHistsAlgo :: initialize ()
 
 EL::StatusCode JetHistsAlgo :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   const xAOD::EventInfo* eventInfo(nullptr);
   RETURN_CHECK("JetHistsAlgo::execute()", HelperFunctions::retrieve(eventInfo, "EventInfo", m_event, m_store, m_debug) ,"");
 
@@ -137,15 +144,20 @@ EL::StatusCode JetHistsAlgo :: execute ()
   }
   else { // get the list of systematics to run over
 
-    // get vector of string giving the names
-    std::vector<std::string>* systNames(nullptr);
-    RETURN_CHECK("JetHistsAlgo::execute()", HelperFunctions::retrieve(systNames, m_inputAlgo, 0, m_store, m_debug) ,"");
+    // get vector of the ids of the systematics (see SystematicIndex)
+    std::vector<unsigned int>* systIds(nullptr);
+    RETURN_CHECK("JetHistsAlgo::execute()", HelperFunctions::retrieve(systIds, SystematicIndex::idsKey( m_inputAlgo ), 0, m_store, m_debug) ,"");
 
     // loop over systematics
-    for( auto systName : *systNames ) {
-      RETURN_CHECK("JetHistsAlgo::execute()", HelperFunctions::retrieve(inJets, m_inContainerName+systName, m_event, m_store, m_debug) ,"");
-      if( m_plots.find( systName ) == m_plots.end() ) { this->AddHists( systName ); }
-      RETURN_CHECK("JetHistsAlgo::execute()", m_plots[systName]->execute( inJets, eventWeight, pvLocation ), "");
+    for( auto systId : *systIds ) {
+      RETURN_CHECK("JetHistsAlgo::execute()", HelperFunctions::retrieve(inJets, m_inKeys[systId], m_event, m_store, m_debug) ,"");
+      if( systId >= m_systPlots.size() ) { m_systPlots.resize( systId + 1, nullptr ); }
+      if( !m_systPlots[systId] ) {
+        const std::string& systName = SystematicIndex::instance().name( systId );
+        if( m_plots.find( systName ) == m_plots.end() ) { RETURN_CHECK("JetHistsAlgo::execute()", this->AddHists( systName ), ""); }
+        m_systPlots[systId] = m_plots[systName];
+      }
+      RETURN_CHECK("JetHistsAlgo::execute()", m_systPlots[systId]->execute( inJets, eventWeight, pvLocation ), "");
     }
 
   }
@@ -156,6 +168,8 @@ EL::StatusCode JetHistsAlgo :: execute ()
 EL::StatusCode JetHistsAlgo :: postExecute () { return EL::StatusCode::SUCCESS; }
 
 EL::StatusCode JetHistsAlgo :: finalize () {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   Info("finalize()", m_name.c_str());
   if(!m_plots.empty()){
     for( auto plots : m_plots ) {
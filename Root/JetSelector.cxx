@@ -46,8 +46,10 @@ ClassImp(JetSelector)
 
 
 JetSelector :: JetSelector () :
+  m_pvLocation(-1),
   m_cutflowHist(nullptr),
-  m_cutflowHistW(nullptr)
+  m_cutflowHistW(nullptr),
+  m_passSelDecor(nullptr)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -118,6 +120,13 @@ EL::StatusCode  JetSelector :: configure ()
     m_passAuxDecorKeys        = config->GetValue("PassDecorKeys", "");
     m_failAuxDecorKeys        = config->GetValue("FailDecorKeys", "");
 
+    // run the cheapest cuts per rejected jet first, as measured on the first CutOrderWarmup jets
+    m_adaptiveCutOrder        = config->GetValue("AdaptiveCutOrder", false);
+    m_cutOrderWarmup          = config->GetValue("CutOrderWarmup",   1000);
+
+    // the pT, eta, detEta, mass, rapidity cuts on the whole container at once (SIMD), only the jets that pass them go through the rest
+    m_batchPreselection       = config->GetValue("BatchPreselection", false);
+
     config->Print();
     Info("configure()", "JetSelector Interface succesfully configured! ");
 
@@ -151,6 +160,10 @@ EL::StatusCode  JetSelector :: configure ()
     return EL::StatusCode::FAILURE;
   }
 
+  // the names of the containers of each systematic
+  m_inKeys  = SystematicKeys( m_inContainerName );
+  m_outKeys = SystematicKeys( m_outContainerName );
+
 
   //
   // Set the Btagging cut
@@ -173,6 +186,9 @@ EL::StatusCode  JetSelector :: configure ()
   if ( m_decorateSelectedObjects ) {
     Info(m_name.c_str()," Decorate Jets with %s", m_decor.c_str());
   }
+  m_passSelDecor = &AuxHandles<char>::decorator( m_decor );
+
+  this->buildCuts();
 
   return EL::StatusCode::SUCCESS;
 }
@@ -245,6 +261,8 @@ EL::StatusCode JetSelector :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode JetSelector :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -270,6 +288,9 @@ EL::StatusCode JetSelector :: initialize ()
   m_weightNumEventPass  = 0;
   m_numObjectPass = 0;
 
+  // the systematics we pass on are some of those we get
+  if ( !m_inputAlgo.empty() ) { SystematicIndex::instance().forwardList( m_inputAlgo, m_outputAlgo ); }
+
   Info("initialize()", "JetSelector Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -279,6 +300,8 @@ EL::StatusCode JetSelector :: initialize ()
 
 EL::StatusCode JetSelector :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -319,30 +342,29 @@ EL::StatusCode JetSelector :: execute ()
   }
   else { // get the list of systematics to run over
 
-    // get vector of string giving the names
-    std::vector<std::string>* systNames(nullptr);
-    RETURN_CHECK("JetSelector::execute()", HelperFunctions::retrieve(systNames, m_inputAlgo, 0, m_store, m_debug) ,"");
+    // get vector of the ids of the systematics (see SystematicIndex)
+    std::vector<unsigned int>* systIds(nullptr);
+    RETURN_CHECK("JetSelector::execute()", HelperFunctions::retrieve(systIds, SystematicIndex::idsKey( m_inputAlgo ), 0, m_store, m_debug) ,"");
 
     // loop over systematics
-    std::vector< std::string >* vecOutContainerNames = new std::vector< std::string >;
+    std::vector< unsigned int >* outSystIds = new std::vector< unsigned int >;
     bool passOne(false);
-    for ( auto systName : *systNames ) {
+    for ( auto systId : *systIds ) {
 
-      RETURN_CHECK("JetSelector::execute()", HelperFunctions::retrieve(inJets, m_inContainerName+systName, m_event, m_store, m_debug) ,"");
+      RETURN_CHECK("JetSelector::execute()", HelperFunctions::retrieve(inJets, m_inKeys[systId], m_event, m_store, m_debug) ,"");
 
-      passOne = executeSelection( inJets, mcEvtWeight, count, m_outContainerName+systName );
+      passOne = executeSelection( inJets, mcEvtWeight, count, m_outKeys[systId] );
       if ( count ) { count = false; } // only count for 1 collection
-      // save the string if passing the selection
+      // save the id if passing the selection
       if ( passOne ) {
-        vecOutContainerNames->push_back( systName );
+        outSystIds->push_back( systId );
       }
       // the final decision - if at least one passes keep going!
       pass = pass || passOne;
     }
 
     // save list of systs that shoudl be considered down stream
-    RETURN_CHECK( "JetSelector::execute()", m_store->record( vecOutContainerNames, m_outputAlgo), "Failed to record vector of output container names.");
-    //delete vecOutContainerNames;
+    RETURN_CHECK( "JetSelector::execute()", SystematicIndex::instance().recordList( outSystIds, m_outputAlgo, m_store ), "Failed to record vector of systematic ids.");
 
   }
 
@@ -376,13 +398,21 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
     RETURN_CHECK("JetSelector::execute()", HelperFunctions::retrieve(vertices, "PrimaryVertices", m_event, m_store, m_debug) ,"");
     m_pvLocation = HelperFunctions::getPrimaryVertexLocation( vertices );
   }
+  m_jetAttributes.setContainer( inJets, m_pvLocation );
 
 
+  // the window cuts on all jets that will be looked at
+  if ( !m_preselection.empty() ) {
+    unsigned int nJet = inJets->size();
+    if ( m_nToProcess > 0 && nJet > static_cast<unsigned int>(m_nToProcess) ) { nJet = m_nToProcess; }
+    this->preselect( inJets, nJet );
+  }
+
   int nPass(0); int nObj(0);
   bool passEventClean(true);
 
   static SG::AuxElement::Accessor< char > isCleanAcc("cleanJet");
-  static SG::AuxElement::Decorator< char > passSelDecor( m_decor );
+  const SG::AuxElement::Decorator< char >& passSelDecor = *m_passSelDecor;
 
   for ( auto jet_itr : *inJets ) { // duplicated of basic loop
 
@@ -396,8 +426,13 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
       continue;
     }
 
+    int passSel(0);
+    if ( m_preselection.empty() || m_preselection.pass( nObj ) ) {
+      passSel = this->PassCuts( jet_itr );
+    } else if ( m_debug ) {
+      Info("PassCuts()", "Jet failed preselection.");
+    }
     nObj++;
-    int passSel = this->PassCuts( jet_itr );
     if ( m_decorateSelectedObjects ) {
       passSelDecor( *jet_itr ) = passSel;
     }
@@ -424,7 +459,7 @@ bool JetSelector :: executeSelection ( const xAOD::JetContainer* inJets,
 
   // add ConstDataVector to TStore
   if ( m_createSelectedContainer ) {
-    RETURN_CHECK("JetSelector::execute()", m_store->record( selectedJets, outContainerName ), "Failed to store const data container.");
+    RETURN_CHECK("JetSelector::execute()", HelperFunctions::record( selectedJets, outContainerName, m_store ), "Failed to store const data container.");
   }
 
   // apply event selection based on minimal/maximal requirements on the number of objects per event passing cuts
@@ -460,6 +495,8 @@ EL::StatusCode JetSelector :: postExecute ()
 
 EL::StatusCode JetSelector :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -471,6 +508,7 @@ EL::StatusCode JetSelector :: finalize ()
   // gets called on worker nodes that processed input events.
 
   Info("finalize()", "%s", m_name.c_str());
+  m_cuts.print( m_name );
   if ( m_useCutFlow ) {
     Info("histFinalize()", "Filling cutflow");
     m_cutflowHist ->SetBinContent( m_cutflow_bin, m_numEventPass        );
@@ -500,114 +538,164 @@ EL::StatusCode JetSelector :: histFinalize ()
   return EL::StatusCode::SUCCESS;
 }
 
-int JetSelector :: PassCuts( const xAOD::Jet* jet ) {
+void JetSelector :: buildCuts() {
+
+  m_cuts.clear();
+  m_preselection.clear();
+  m_preQuantity.clear();
 
   // clean jets
-  static SG::AuxElement::Accessor< char > isCleanAcc("cleanJet");
   if ( m_cleanJets ) {
-    if ( isCleanAcc.isAvailable( *jet ) ) {
-      if ( !isCleanAcc( *jet ) ) { return 0; }
+    m_cuts.add( "clean", []( const xAOD::Jet* jet ) {
+      static SG::AuxElement::Accessor< char > isCleanAcc("cleanJet");
+      return !isCleanAcc.isAvailable( *jet ) || isCleanAcc( *jet );
+    });
+  }
+
+  if ( m_batchPreselection ) {
+    if ( m_preselection.addWindow( "pT",       m_pT_min, m_pT_max             ) ) { m_preQuantity.push_back( PRE_PT ); }
+    if ( m_preselection.addWindow( "|eta|",    m_eta_min, m_eta_max, true     ) ) { m_preQuantity.push_back( PRE_ETA ); }
+    if ( m_preselection.addWindow( "detEta",   m_detEta_min, m_detEta_max     ) ) { m_preQuantity.push_back( PRE_DETETA ); }
+    if ( m_preselection.addWindow( "mass",     m_mass_min, m_mass_max         ) ) { m_preQuantity.push_back( PRE_MASS ); }
+    if ( m_preselection.addWindow( "rapidity", m_rapidity_min, m_rapidity_max ) ) { m_preQuantity.push_back( PRE_RAPIDITY ); }
+  } else {
+    // pT
+    if ( m_pT_max != 1e8 ) {
+      m_cuts.add( "pT max", [this]( const xAOD::Jet* jet ) { return !( jet->pt() > m_pT_max ); } );
+    }
+    if ( m_pT_min != 1e8 ) {
+      m_cuts.add( "pT min", [this]( const xAOD::Jet* jet ) { return !( jet->pt() < m_pT_min ); } );
     }
-  }
-
-  // pT
-  if ( m_pT_max != 1e8 ) {
-    if ( jet->pt() > m_pT_max ) { return 0; }
-  }
-  if ( m_pT_min != 1e8 ) {
-    if ( jet->pt() < m_pT_min ) { return 0; }
-  }
 
-  // eta
-  if ( m_eta_max != 1e8 ) {
-    if ( fabs(jet->eta()) > m_eta_max ) { return 0; }
-  }
-  if ( m_eta_min != 1e8 ) {
-    if ( fabs(jet->eta()) < m_eta_min ) { return 0; }
-  }
+    // eta
+    if ( m_eta_max != 1e8 ) {
+      m_cuts.add( "|eta| max", [this]( const xAOD::Jet* jet ) { return !( fabs(jet->eta()) > m_eta_max ); } );
+    }
+    if ( m_eta_min != 1e8 ) {
+      m_cuts.add( "|eta| min", [this]( const xAOD::Jet* jet ) { return !( fabs(jet->eta()) < m_eta_min ); } );
+    }
 
-  // detEta
-  if ( m_detEta_max != 1e8 ) {
-    if ( ( jet->getAttribute<xAOD::JetFourMom_t>("JetConstitScaleMomentum") ).eta() > m_detEta_max ) { return 0; }
-  }
-  if ( m_detEta_min != 1e8 ) {
-    if( ( jet->getAttribute<xAOD::JetFourMom_t>("JetConstitScaleMomentum") ).eta() < m_detEta_min ) { return 0; }
-  }
+    // detEta
+    if ( m_detEta_max != 1e8 ) {
+      m_cuts.add( "detEta max", [this]( const xAOD::Jet* jet ) { return !( m_jetAttributes.constitScaleEta( *jet ) > m_detEta_max ); } );
+    }
+    if ( m_detEta_min != 1e8 ) {
+      m_cuts.add( "detEta min", [this]( const xAOD::Jet* jet ) { return !( m_jetAttributes.constitScaleEta( *jet ) < m_detEta_min ); } );
+    }
 
-  // mass
-  if ( m_mass_max != 1e8 ) {
-    if ( jet->m() > m_mass_max ) { return 0; }
-  }
-  if ( m_mass_min != 1e8 ) {
-    if ( jet->m() < m_mass_min ) { return 0; }
-  }
+    // mass
+    if ( m_mass_max != 1e8 ) {
+      m_cuts.add( "mass max", [this]( const xAOD::Jet* jet ) { return !( jet->m() > m_mass_max ); } );
+    }
+    if ( m_mass_min != 1e8 ) {
+      m_cuts.add( "mass min", [this]( const xAOD::Jet* jet ) { return !( jet->m() < m_mass_min ); } );
+    }
 
-  // rapidity
-  if ( m_rapidity_max != 1e8 ) {
-    if ( jet->rapidity() > m_rapidity_max ) { return 0; }
-  }
-  if ( m_rapidity_min != 1e8 ) {
-    if ( jet->rapidity() < m_rapidity_min ) { return 0; }
+    // rapidity
+    if ( m_rapidity_max != 1e8 ) {
+      m_cuts.add( "rapidity max", [this]( const xAOD::Jet* jet ) { return !( jet->rapidity() > m_rapidity_max ); } );
+    }
+    if ( m_rapidity_min != 1e8 ) {
+      m_cuts.add( "rapidity min", [this]( const xAOD::Jet* jet ) { return !( jet->rapidity() < m_rapidity_min ); } );
+    }
   }
 
   // JVF pileup cut
-  if ( m_doJVF ){
-    if ( jet->pt() < m_pt_max_JVF ) {
-      xAOD::JetFourMom_t jetConstitScaleP4 = jet->getAttribute< xAOD::JetFourMom_t >( "JetConstitScaleMomentum" );
-      if ( fabs(jetConstitScaleP4.eta()) < m_eta_max_JVF ){
-        if ( jet->getAttribute< std::vector<float> >( "JVF" ).at( m_pvLocation ) < m_JVFCut ) {
-          return 0;
+  if ( m_doJVF ) {
+    m_cuts.add( "JVF", [this]( const xAOD::Jet* jet ) {
+      if ( jet->pt() < m_pt_max_JVF ) {
+        if ( fabs( m_jetAttributes.constitScaleEta( *jet ) ) < m_eta_max_JVF ) {
+          if ( m_jetAttributes.jvfPV( *jet ) < m_JVFCut ) { return false; }
         }
       }
-    }
-  } // m_doJVF
+      return true;
+    }, false );
+  }
 
   //
   //  BTagging
   //
-
-  const xAOD::BTagging *myBTag = jet->btagging();
-  if ( myBTag ) {
-    if ( m_btagCut >=0 ) {
-      if ( myBTag->MV1_discriminant() < m_btagCut ) { return 0; }
-    }
+  if ( m_btagCut >= 0 ) {
+    m_cuts.add( "b-tagging", [this]( const xAOD::Jet* jet ) {
+      const xAOD::BTagging *myBTag = jet->btagging();
+      return !( myBTag && myBTag->MV1_discriminant() < m_btagCut );
+    });
   }
 
   //
   //  Pass Keys
   //
   for ( auto& passKey : m_passKeys ) {
-    if ( !(jet->auxdata< char >(passKey) == '1') ) { return 0;}
+    const AuxHandles<char>::Accessor& passAcc = AuxHandles<char>::accessor( passKey );
+    m_cuts.add( "pass key " + passKey, [&passAcc]( const xAOD::Jet* jet ) { return passAcc( *jet ) == '1'; }, false );
   }
 
   //
   //  Fail Keys
   //
-  for ( auto& failKey : m_failKeys ){
-    if ( !(jet->auxdata< char >(failKey) == '0') ) { return 0;}
+  for ( auto& failKey : m_failKeys ) {
+    const AuxHandles<char>::Accessor& failAcc = AuxHandles<char>::accessor( failKey );
+    m_cuts.add( "fail key " + failKey, [&failAcc]( const xAOD::Jet* jet ) { return failAcc( *jet ) == '0'; }, false );
   }
 
   //
   //  Truth Label
   //
   if ( m_truthLabel != -1 ) {
+    m_cuts.add( "truth label", [this]( const xAOD::Jet* jet ) {
+      int this_TruthLabel = 0;
+      static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
+      if ( TruthLabelID.isAvailable( *jet) ) {
+        this_TruthLabel = TruthLabelID( *jet );
+      } else {
+        static SG::AuxElement::ConstAccessor<int> PartonTruthLabelID ("PartonTruthLabelID");
+        this_TruthLabel = PartonTruthLabelID( *jet );
+      }
 
-    int this_TruthLabel = 0;
-    static SG::AuxElement::ConstAccessor<int> TruthLabelID ("TruthLabelID");
-    if ( TruthLabelID.isAvailable( *jet) ) {
-      this_TruthLabel = TruthLabelID( *jet );
-    } else {
-      static SG::AuxElement::ConstAccessor<int> PartonTruthLabelID ("PartonTruthLabelID");
-      this_TruthLabel = PartonTruthLabelID( *jet );
-    }
+      if ( (m_truthLabel == 5) && this_TruthLabel != 5 ) { return false; }
+      if ( (m_truthLabel == 4) && this_TruthLabel != 4 ) { return false; }
+      if ( (m_truthLabel == 0) && !(this_TruthLabel == 21 || this_TruthLabel<4) ) { return false; }
+      return true;
+    }, false );
+  }
 
-    if ( (m_truthLabel == 5) && this_TruthLabel != 5 ) { return 0;}
-    if ( (m_truthLabel == 4) && this_TruthLabel != 4 ) { return 0;}
-    if ( (m_truthLabel == 0) && !(this_TruthLabel == 21 || this_TruthLabel<4) ) { return 0;}
+  m_cuts.setAdaptive( m_adaptiveCutOrder, m_cutOrderWarmup );
+}
 
+void JetSelector :: preselect( const xAOD::JetContainer* inJets, unsigned int nJet ) {
+
+  // one quantity at a time over all jets, into the column of its window
+  for ( unsigned int iWin = 0; iWin < m_preQuantity.size(); ++iWin ) {
+    double* x = m_preselection.column( iWin, nJet );
+    switch ( m_preQuantity[iWin] ) {
+    case PRE_PT:
+      for ( unsigned int i = 0; i < nJet; ++i ) { x[i] = (*inJets)[i]->pt(); }
+      break;
+    case PRE_ETA:
+      for ( unsigned int i = 0; i < nJet; ++i ) { x[i] = (*inJets)[i]->eta(); }
+      break;
+    case PRE_DETETA:
+      for ( unsigned int i = 0; i < nJet; ++i ) { x[i] = m_jetAttributes.constitScaleEta( *(*inJets)[i] ); }
+      break;
+    case PRE_MASS:
+      for ( unsigned int i = 0; i < nJet; ++i ) { x[i] = (*inJets)[i]->m(); }
+      break;
+    case PRE_RAPIDITY:
+      for ( unsigned int i = 0; i < nJet; ++i ) { x[i] = (*inJets)[i]->rapidity(); }
+      break;
+    }
   }
 
-  return 1;
+  m_preselection.evaluate( nJet );
 }
 
+int JetSelector :: PassCuts( const xAOD::Jet* jet ) {
+
+  int failed = m_cuts.firstFailed( jet );
+  if ( failed >= 0 ) {
+    if ( m_debug ) { Info("PassCuts()", "Jet failed %s cut.", m_cuts.name( failed ).c_str()); }
+    return 0;
+  }
 
+  return 1;
+}
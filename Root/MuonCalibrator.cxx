@@ -131,6 +131,8 @@ EL::StatusCode MuonCalibrator :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode MuonCalibrator :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -169,6 +171,8 @@ EL::StatusCode MuonCalibrator :: initialize ()
 
 EL::StatusCode MuonCalibrator :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -221,10 +225,10 @@ EL::StatusCode MuonCalibrator :: execute ()
   RETURN_CHECK( "MuonCalibrator::execute()", HelperFunctions::makeSubsetCont(calibMuonsSC.first, calibMuonsCDV, "", ToolName::CALIBRATOR), "");
 
   // add shallow copy to TStore
-  RETURN_CHECK( "MuonCalibrator::execute()", m_store->record( calibMuonsSC.first,  m_outSCContainerName ), "Failed to store container");
-  RETURN_CHECK( "MuonCalibrator::execute()", m_store->record( calibMuonsSC.second, m_outSCAuxContainerName ), "Failed to store aux container");
+  RETURN_CHECK( "MuonCalibrator::execute()", HelperFunctions::record( calibMuonsSC.first, m_outSCContainerName, m_store ), "Failed to store container");
+  RETURN_CHECK( "MuonCalibrator::execute()", HelperFunctions::record( calibMuonsSC.second, m_outSCAuxContainerName, m_store ), "Failed to store aux container");
   // add ConstDataVector to TStore
-  RETURN_CHECK( "MuonCalibrator::execute()", m_store->record( calibMuonsCDV, m_outContainerName ), "Failed to store const data container");
+  RETURN_CHECK( "MuonCalibrator::execute()", HelperFunctions::record( calibMuonsCDV, m_outContainerName, m_store ), "Failed to store const data container");
 
   return EL::StatusCode::SUCCESS;
 }
@@ -246,6 +250,8 @@ EL::StatusCode MuonCalibrator :: postExecute ()
 
 EL::StatusCode MuonCalibrator :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
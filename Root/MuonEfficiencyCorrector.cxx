@@ -43,7 +43,8 @@ ClassImp(MuonEfficiencyCorrector)
 
 
 MuonEfficiencyCorrector :: MuonEfficiencyCorrector () :
-  m_MuonEffSFTool(nullptr)
+  m_MuonEffSFTool(nullptr),
+  m_systPool(nullptr)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -79,6 +80,8 @@ EL::StatusCode  MuonEfficiencyCorrector :: configure ()
     m_runAllSyst              = config->GetValue("RunAllSyst" , false ); // default: false
     m_systName		      = config->GetValue("SystName" , "" );      // default: no syst
     m_systVal 	      = config->GetValue("SystSigma" , 0. );
+    // number of threads (and of efficiency tool instances) the systematics are spread over
+    m_systThreads             = config->GetValue("SystThreads", static_cast<int>(m_systThreads));
 
     config->Print();
     Info("configure()", "MuonEfficiencyCorrector Interface succesfully configured! ");
@@ -123,6 +126,9 @@ EL::StatusCode MuonEfficiencyCorrector :: histInitialize ()
   // beginning on each worker node, e.g. create histograms and output
   // trees.  This method gets called before any input files are
   // connected.
+
+  // the systematic threads need ROOT to be thread safe before the input is read
+  if ( this->configValue( "SystThreads", static_cast<int>(m_systThreads) ) > 1 ) { xAH::Algorithm::enableThreadSafety(); }
   return EL::StatusCode::SUCCESS;
 }
 
@@ -149,6 +155,8 @@ EL::StatusCode MuonEfficiencyCorrector :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode MuonEfficiencyCorrector :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -175,14 +183,7 @@ EL::StatusCode MuonEfficiencyCorrector :: initialize ()
 
   // initialize the MuonEfficiencyCorrectionTool
   std::string mefsf_tool_name = std::string("MuonEfficiencyCorrectionTool_") + m_name;
-  m_MuonEffSFTool = new CP::MuonEfficiencyScaleFactors( mefsf_tool_name.c_str() );
-  m_MuonEffSFTool->msg().setLevel( MSG::INFO ); // DEBUG, VERBOSE, INFO, ERROR
-
-  RETURN_CHECK( "MuonEfficiencyCorrector::initialize()", m_MuonEffSFTool->setProperty("WorkingPoint", m_WorkingPoint ),"Failed to set property");
-  RETURN_CHECK( "MuonEfficiencyCorrector::initialize()", m_MuonEffSFTool->setProperty("DataPeriod", m_DataPeriod ),"Failed to set property");
-  // test audit trail
-  RETURN_CHECK( "MuonEfficiencyCorrector::initialize()", m_MuonEffSFTool->setProperty("doAudit",false),"Failed to set property"); // audit trail functionality.
-  RETURN_CHECK( "MuonEfficiencyCorrector::initialize()", m_MuonEffSFTool->initialize(), "Failed to properly initialize the MuonEfficiencyCorrectionTool");
+  RETURN_CHECK( "MuonEfficiencyCorrector::initialize()", this->makeEffSFTool( m_MuonEffSFTool, mefsf_tool_name ), "");
 
 
   // Get a list of affecting systematics
@@ -205,6 +206,25 @@ EL::StatusCode MuonEfficiencyCorrector :: initialize ()
       Info("initialize()"," Running w/ nominal configuration!");
   }
 
+  // if not running systematics (i.e., syst name is "") or running on one syst only, drop all other syst
+  if ( !m_runAllSyst ) {
+    for ( auto syst_it = m_systList.begin(); syst_it != m_systList.end(); ) {
+      if ( syst_it->name() != m_systName ) { syst_it = m_systList.erase( syst_it ); }
+      else { ++syst_it; }
+    }
+  }
+
+  // an instance of the tool for every further thread, no more than there are systematics
+  m_MuonEffSFTools.assign( 1, m_MuonEffSFTool );
+  for ( unsigned int iTool = 1; iTool < m_systThreads && iTool < m_systList.size(); ++iTool ) {
+    CP::MuonEfficiencyScaleFactors* effSFTool(nullptr);
+    RETURN_CHECK( "MuonEfficiencyCorrector::initialize()", this->makeEffSFTool( effSFTool, mefsf_tool_name + "_" + std::to_string(iTool) ), "");
+    m_MuonEffSFTools.push_back( effSFTool );
+  }
+
+  m_systPool = new TaskPool( m_MuonEffSFTools.size() );
+  if ( m_systPool->workers() > 1 ) { Warning("initialize()", "Evaluating the systematics with %u threads. This is experimental: the CP tools may still read the input from the threads", m_systPool->workers()); }
+
   Info("initialize()", "MuonEfficiencyCorrector Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -213,6 +233,8 @@ EL::StatusCode MuonEfficiencyCorrector :: initialize ()
 
 EL::StatusCode MuonEfficiencyCorrector :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -226,6 +248,12 @@ EL::StatusCode MuonEfficiencyCorrector :: execute ()
   const xAOD::MuonContainer* correctedMuons(nullptr);
   RETURN_CHECK("MuonEfficiencyCorrector::execute()", HelperFunctions::retrieve(correctedMuons, m_inContainerName, m_event, m_store, m_debug) ,"");
 
+  // the threads should not make TEvent read anything: what the tool looks at is read here
+  if ( m_systPool->workers() > 1 ) {
+    RETURN_CHECK("MuonEfficiencyCorrector::execute()", HelperFunctions::preloadEvent(m_event, m_store, m_debug), "");
+    HelperFunctions::preloadAux( correctedMuons, { "pt", "eta", "phi", "charge", "muonType" } );
+  }
+
   // create ConstDataVector to be eventually stored in TStore
   ConstDataVector<xAOD::MuonContainer>* correctedMuonsCDV = new ConstDataVector<xAOD::MuonContainer>(SG::VIEW_ELEMENTS);
   correctedMuonsCDV->reserve( correctedMuons->size() );
@@ -238,84 +266,77 @@ EL::StatusCode MuonEfficiencyCorrector :: execute ()
     }
   }
 
-  // loop over available systematics
-  for ( const auto& syst_it : m_systList ) {
+  // the systematics are independent, each worker of the pool has its own tool. The results are
+  // kept per systematic and per muon and only decorated in order afterwards, as the
+  // decorations of all systematics go to the same muons
+  std::vector< std::vector<float> > effs( m_systList.size(), std::vector<float>( correctedMuons->size(), 0.0 ) );
+  std::vector< std::vector<float> > SFs( m_systList.size(), std::vector<float>( correctedMuons->size(), 0.0 ) );
+  bool systOk = m_systPool->run( m_systList.size(), [&]( unsigned int worker, unsigned int iSyst ) {
 
-    // prepends syst name to decoration
-    std::string SFdecor = std::string("SF");
-    if ( !syst_it.name().empty() ) {
-       std::string prepend = syst_it.name() + "_";
-       SFdecor.insert( 0, prepend );
-    }
-    RETURN_CHECK( "MuonEfficiencyCorrector::execute()", m_MuonEffSFTool->setProperty( "ScaleFactorDecorationName", SFdecor.c_str() ), "Failed to set property ScaleFactorDecorationName" );
-
-    if ( m_debug ) { Info("execute()", "SF decoration name is: %s", SFdecor.c_str()); }
-
-    // if not running systematics (i.e., syst name is "") or running on one syst only, skip directly all other syst
-    if ( !m_runAllSyst ) {
-      if ( syst_it.name() != m_systName ) { continue; }
-    }
+    const CP::SystematicSet& syst_it = m_systList.at(iSyst);
+    CP::MuonEfficiencyScaleFactors* effSFTool = m_MuonEffSFTools.at(worker);
 
     // apply syst
-    if ( m_MuonEffSFTool->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
-      Error("initialize()", "Failed to configure MuonEfficiencyCorrections for systematic %s", syst_it.name().c_str());
-      return EL::StatusCode::FAILURE;
+    if ( effSFTool->applySystematicVariation(syst_it) != CP::SystematicCode::Ok ) {
+      Error("execute()", "Failed to configure MuonEfficiencyCorrections for systematic %s", syst_it.name().c_str());
+      return false;
     }
 
     if ( m_debug ) { Info("execute()", "Successfully applied systematic: %s", syst_it.name().c_str()); }
 
-    // prepare a vector to hold SF replicas
-    // the size will tell the tool how many you want
-    // -> we will try 50!
-    std::vector<float> replicas(50);
+    // and now get data-driven efficiency and efficiency SF!
+    for ( unsigned int iMu = 0; iMu < correctedMuons->size(); ++iMu ) {
+      const xAOD::Muon* mu_itr = correctedMuons->at(iMu);
+
+      // directly obtain reco efficiency
+      if ( effSFTool->getRecoEfficiency( *mu_itr, effs.at(iSyst).at(iMu) ) != CP::CorrectionCode::Ok ) {
+        Error( "execute()", "Problem in getRecoEfficiency");
+        return false;
+      }
+
+      // directly obtain efficiency SF
+      if ( effSFTool->getEfficiencyScaleFactor( *mu_itr, SFs.at(iSyst).at(iMu) ) != CP::CorrectionCode::Ok ) {
+        Error( "execute()", "Problem in getEfficiencyScaleFactor");
+        return false;
+      }
+
+      // uncomment to try out replica genration (commented as it produces a lot of text)
+      //  std::vector<float> replicas(50);
+      //  if( effSFTool->getEfficiencyScaleFactorReplicas( *mu_itr, replicas ) != CP::CorrectionCode::Ok ){
+      //       Error( "execute()", "Problem in getEfficiencyScaleFactorReplicas");
+      //       return false;
+      //  }
+    }
+    return true;
+  });
+  if ( !systOk ) {
+    delete correctedMuonsCDV;
+    return EL::StatusCode::FAILURE;
+  }
 
-    // and now apply data-driven efficiency and efficiency SF!
-    float eff(0.0), SF(0.0);
-    for ( auto mu_itr : *(correctedMuons) ) {
+  // decorate in the order of the systematics, as applyRecoEfficiency / applyEfficiencyScaleFactor
+  // would have: the efficiency is the one of the last systematic, the SF has one decoration per systematic
+  static SG::AuxElement::Decorator< float > effDecor( "Efficiency" );
+  for ( unsigned int iSyst = 0; iSyst < m_systList.size(); ++iSyst ) {
 
-	// directly obtain reco efficiency
-        if ( m_MuonEffSFTool->getRecoEfficiency( *mu_itr, eff ) != CP::CorrectionCode::Ok ) {
-    	  Error( "execute()", "Problem in getRecoEfficiency");
-    	  return EL::StatusCode::FAILURE;
-	}
-        if ( m_debug ) { Info( "execute", "\t reco efficiency = %g", eff ); }
-
-        // directly obtain efficiency SF
-        if ( m_MuonEffSFTool->getEfficiencyScaleFactor( *mu_itr, SF ) != CP::CorrectionCode::Ok ) {
-    	  Error( "execute()", "Problem in getEfficiencyScaleFactor");
-    	  return EL::StatusCode::FAILURE;
-        }
-	if ( m_debug ) { Info( "execute()", "\t efficiency SF = %g", SF ); }
-
-        // apply reco efficiency as decoration for this muon
-        if ( m_MuonEffSFTool->applyRecoEfficiency( *mu_itr ) != CP::CorrectionCode::Ok ) {
-    	  Error( "execute()", "Problem in applyRecoEfficiency");
-    	  return EL::StatusCode::FAILURE;
-        }
-
-        // apply SF as decoration for this muon
-        if ( m_MuonEffSFTool->applyEfficiencyScaleFactor( *mu_itr ) != CP::CorrectionCode::Ok ) {
-    	  Error( "execute()", "Problem in applyEfficiencyScaleFactor");
-    	  return EL::StatusCode::FAILURE;
-        }
-
-        // uncomment to try out replica genration (commented as it produces a lot of text)
-        //  if( m_MuonEffSFTool->getEfficiencyScaleFactorReplicas( *mu_itr, replicas ) != CP::CorrectionCode::Ok ){
-    	//       Error( "execute()", "Problem in getEfficiencyScaleFactorReplicas");
-    	//       return EL::StatusCode::FAILURE;
-	//  }
-        //
-        //  for (size_t t =0; t < replicas.size();t++){
-        //    Info( "execute()", "\t scaleFactor Replica %d = %.8f",static_cast<int>(t), replicas[t] );
-        //  }
-
-        if ( m_debug ) {
-	  Info( "execute", "===>>> Resulting reco efficiency (from get function) %f, (from apply function) %f", eff, mu_itr->auxdataConst< float >("Efficiency"));
-          Info( "execute", "===>>> Resulting SF (from get function) %f, (from apply function) %f",              SF,  mu_itr->auxdataConst< float >(SFdecor.c_str()));
-	}
-
-    } // close muon loop
+    // prepends syst name to decoration
+    std::string SFdecor = std::string("SF");
+    if ( !m_systList.at(iSyst).name().empty() ) {
+       std::string prepend = m_systList.at(iSyst).name() + "_";
+       SFdecor.insert( 0, prepend );
+    }
+    if ( m_debug ) { Info("execute()", "SF decoration name is: %s", SFdecor.c_str()); }
+    SG::AuxElement::Decorator< float > sfDecor( SFdecor );
 
+    for ( unsigned int iMu = 0; iMu < correctedMuons->size(); ++iMu ) {
+      const xAOD::Muon* mu_itr = correctedMuons->at(iMu);
+      effDecor( *mu_itr ) = effs.at(iSyst).at(iMu);
+      sfDecor( *mu_itr )  = SFs.at(iSyst).at(iMu);
+
+      if ( m_debug ) {
+        Info( "execute", "===>>> Resulting reco efficiency %f, SF %f", effs.at(iSyst).at(iMu), SFs.at(iSyst).at(iMu));
+      }
+    }
   } // close loop on systematics
 
 
@@ -332,7 +353,7 @@ EL::StatusCode MuonEfficiencyCorrector :: execute ()
   RETURN_CHECK( "MuonCalibrator::execute()", HelperFunctions::makeSubsetCont(correctedMuons, correctedMuonsCDV, "", ToolName::CORRECTOR), "");
 
   // add container to TStore
-  RETURN_CHECK( "MuonEfficiencyCorrector::execute()", m_store->record( correctedMuonsCDV,  m_outContainerName ), "Failed to store container.");
+  RETURN_CHECK( "MuonEfficiencyCorrector::execute()", HelperFunctions::record( correctedMuonsCDV, m_outContainerName, m_store ), "Failed to store container.");
 
   if ( m_debug ) { m_store->print(); }
 
@@ -340,6 +361,21 @@ EL::StatusCode MuonEfficiencyCorrector :: execute ()
 }
 
 
+EL::StatusCode MuonEfficiencyCorrector :: makeEffSFTool ( CP::MuonEfficiencyScaleFactors*& effSFTool, const std::string& name )
+{
+  effSFTool = new CP::MuonEfficiencyScaleFactors( name.c_str() );
+  effSFTool->msg().setLevel( MSG::INFO ); // DEBUG, VERBOSE, INFO, ERROR
+
+  RETURN_CHECK( "MuonEfficiencyCorrector::makeEffSFTool()", effSFTool->setProperty("WorkingPoint", m_WorkingPoint ),"Failed to set property");
+  RETURN_CHECK( "MuonEfficiencyCorrector::makeEffSFTool()", effSFTool->setProperty("DataPeriod", m_DataPeriod ),"Failed to set property");
+  // test audit trail
+  RETURN_CHECK( "MuonEfficiencyCorrector::makeEffSFTool()", effSFTool->setProperty("doAudit",false),"Failed to set property"); // audit trail functionality.
+  RETURN_CHECK( "MuonEfficiencyCorrector::makeEffSFTool()", effSFTool->initialize(), "Failed to properly initialize the MuonEfficiencyCorrectionTool");
+
+  return EL::StatusCode::SUCCESS;
+}
+
+
 EL::StatusCode MuonEfficiencyCorrector :: postExecute ()
 {
   // Here you do everything that needs to be done after the main event
@@ -355,6 +391,8 @@ EL::StatusCode MuonEfficiencyCorrector :: postExecute ()
 
 EL::StatusCode MuonEfficiencyCorrector :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -367,9 +405,17 @@ EL::StatusCode MuonEfficiencyCorrector :: finalize ()
 
   Info("finalize()", "Deleting tool instances...");
 
+  // the first of them is m_MuonEffSFTool
+  for ( unsigned int iTool = 1; iTool < m_MuonEffSFTools.size(); ++iTool ) {
+    delete m_MuonEffSFTools.at(iTool);
+  }
+  m_MuonEffSFTools.clear();
   if ( m_MuonEffSFTool ) {
     delete m_MuonEffSFTool; m_MuonEffSFTool = nullptr;
   }
+  if ( m_systPool ) {
+    delete m_systPool; m_systPool = nullptr;
+  }
 
   return EL::StatusCode::SUCCESS;
 }
@@ -44,6 +44,7 @@ ClassImp(MuonSelector)
 MuonSelector :: MuonSelector () :
   m_cutflowHist(nullptr),
   m_cutflowHistW(nullptr),
+  m_passSelDecor(nullptr),
   m_muonSelectionTool(nullptr)
 {
   // Here you put any code for the base initialization of variables,
@@ -109,6 +110,10 @@ EL::StatusCode  MuonSelector :: configure ()
     m_passAuxDecorKeys        = config->GetValue("PassDecorKeys", "");
     m_failAuxDecorKeys        = config->GetValue("FailDecorKeys", "");
 
+    // run the cheapest cuts per rejected muon first, as measured on the first CutOrderWarmup muons
+    m_adaptiveCutOrder        = config->GetValue("AdaptiveCutOrder", false);
+    m_cutOrderWarmup          = config->GetValue("CutOrderWarmup",   1000);
+
     config->Print();
     Info("configure()", "MuonSelector Interface succesfully configured! ");
 
@@ -117,29 +122,28 @@ EL::StatusCode  MuonSelector :: configure ()
 
   m_outAuxContainerName     = m_outContainerName + "Aux."; // the period is very important!
 
-  std::set<std::string> muonQualitySet;
-  muonQualitySet.insert("Tight");
-  muonQualitySet.insert("Medium");
-  muonQualitySet.insert("Loose");
-  muonQualitySet.insert("VeryLoose");
-  if ( muonQualitySet.find(m_muonQuality) == muonQualitySet.end() ) {
+  // the strings of the configuration to enums, once
+  if ( !HelperClasses::EnumParser<xAOD::Muon::Quality>::find( m_muonQuality, m_muonQualityEnum ) ) {
     Error("configure()", "Unknown muon quality requested %s!",m_muonQuality.c_str());
     return EL::StatusCode::FAILURE;
   }
 
-  std::set<std::string> muonTypeSet;
-  muonTypeSet.insert("");
-  muonTypeSet.insert("Combined");
-  muonTypeSet.insert("MuonStandAlone");
-  muonTypeSet.insert("SegmentTagged");
-  muonTypeSet.insert("CaloTagged");
-  muonTypeSet.insert("SiliconAssociatedForwardMuon");
-
-  if ( muonTypeSet.find(m_muonType) == muonTypeSet.end() ) {
+  if ( !m_muonType.empty() && !HelperClasses::EnumParser<xAOD::Muon::MuonType>::find( m_muonType, m_muonTypeEnum ) ) {
     Error("configure()", "Unknown muon type requested %s!",m_muonType.c_str());
     return EL::StatusCode::FAILURE;
   }
 
+  if ( m_doIsolation ) {
+    if ( !HelperClasses::EnumParser<xAOD::Iso::IsolationType>::find( m_TrackBasedIsoType, m_trackBasedIsoEnum ) ) {
+      Error("configure()", "Unknown track based isolation type requested %s!",m_TrackBasedIsoType.c_str());
+      return EL::StatusCode::FAILURE;
+    }
+    if ( !HelperClasses::EnumParser<xAOD::Iso::IsolationType>::find( m_CaloBasedIsoType, m_caloBasedIsoEnum ) ) {
+      Error("configure()", "Unknown calo based isolation type requested %s!",m_CaloBasedIsoType.c_str());
+      return EL::StatusCode::FAILURE;
+    }
+  }
+
   // parse and split by comma
   std::string token;
 
@@ -159,6 +163,10 @@ EL::StatusCode  MuonSelector :: configure ()
     return EL::StatusCode::FAILURE;
   }
 
+  m_passSelDecor = &AuxHandles<char>::decorator( "passSel" );
+
+  this->buildCuts();
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -232,6 +240,8 @@ EL::StatusCode MuonSelector :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode MuonSelector :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -264,11 +274,9 @@ EL::StatusCode MuonSelector :: initialize ()
   m_muonSelectionTool = new CP::MuonSelectionTool( ms_tool_name.c_str() );
   m_muonSelectionTool->msg().setLevel( MSG::ERROR); // VERBOSE
 
-  HelperClasses::EnumParser<xAOD::Muon::Quality> muQualityParser;
-
   // set eta and quality requirements in order to accept the muon - ID tracks required by default
   RETURN_CHECK("MuonSelector::initialize()", m_muonSelectionTool->setProperty("MaxEta",    static_cast<double>(m_eta_max)), "Failed to set MaxEta property"); // default 2.5
-  RETURN_CHECK("MuonSelector::initialize()", m_muonSelectionTool->setProperty("MuQuality", static_cast<int>(muQualityParser.parseEnum(m_muonQuality))), "Failed to set MuQuality property" ); // why is not ok to pass the enum??
+  RETURN_CHECK("MuonSelector::initialize()", m_muonSelectionTool->setProperty("MuQuality", static_cast<int>(m_muonQualityEnum)), "Failed to set MuQuality property" ); // why is not ok to pass the enum??
 
   RETURN_CHECK("MuonSelector::initialize()", m_muonSelectionTool->initialize(), "Failed to properly initialize the Muon Selection Tool");
 
@@ -279,6 +287,8 @@ EL::StatusCode MuonSelector :: initialize ()
 
 EL::StatusCode MuonSelector :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -322,7 +332,7 @@ EL::StatusCode MuonSelector :: executeConst ( const xAOD::MuonContainer* inMuons
   const xAOD::Vertex *pvx = HelperFunctions::getPrimaryVertex(vertices);
 
   int nPass(0); int nObj(0);
-  static SG::AuxElement::Decorator< char > passSelDecor( "passSel" );
+  const SG::AuxElement::Decorator< char >& passSelDecor = *m_passSelDecor;
 
   for( auto mu_itr : *inMuons ) { // duplicated of basic loop
 
@@ -376,7 +386,7 @@ EL::StatusCode MuonSelector :: executeConst ( const xAOD::MuonContainer* inMuons
 
   // add ConstDataVector to TStore
   if ( m_createSelectedContainer ) {
-    RETURN_CHECK("MuonSelector::execute()", m_store->record( selectedMuons, m_outContainerName ), "Failed to store const data container");
+    RETURN_CHECK("MuonSelector::execute()", HelperFunctions::record( selectedMuons, m_outContainerName, m_store ), "Failed to store const data container");
   }
 
   return EL::StatusCode::SUCCESS;
@@ -398,6 +408,8 @@ EL::StatusCode MuonSelector :: postExecute ()
 
 EL::StatusCode MuonSelector :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -408,6 +420,8 @@ EL::StatusCode MuonSelector :: finalize ()
   // merged.  This is different from histFinalize() in that it only
   // gets called on worker nodes that processed input events.
 
+  m_cuts.print( m_name );
+
   Info("finalize()", "Deleting tool instances...");
 
   if ( m_muonSelectionTool ) { delete m_muonSelectionTool; m_muonSelectionTool = nullptr; }
@@ -441,116 +455,87 @@ EL::StatusCode MuonSelector :: histFinalize ()
   return EL::StatusCode::SUCCESS;
 }
 
-int MuonSelector :: PassCuts( const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex  ) {
-
-  // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/InDetTrackingDC14
-
-  const xAOD::TrackParticle* tp  = muon->primaryTrackParticle();
+void MuonSelector :: buildCuts() {
 
-  float d0_significance = fabs( tp->d0() ) / sqrt(tp->definingParametersCovMatrix()(0,0) );
-  float z0sintheta      = ( tp->z0() + tp->vz() - primaryVertex->z() ) * sin( tp->theta() );
+  typedef const xAOD::Muon*   Mu;
+  typedef const xAOD::Vertex* Vtx;
 
-  int type = static_cast<int>(muon->muonType());
+  m_cuts.clear();
 
   // pT max
   if ( m_pT_max != 1e8 ) {
-    if (  muon->pt() > m_pT_max ) {
-      if ( m_debug ) { Info("PassCuts()", "Muon failed pT max cut."); }
-      return 0;
-    }
+    m_cuts.add( "pT max", [this]( Mu muon, Vtx ) { return !( muon->pt() > m_pT_max ); } );
   }
   // pT min
   if ( m_pT_min != 1e8 ) {
-    if ( muon->pt() < m_pT_min ) {
-      if ( m_debug ) { Info("PassCuts()", "Muon failed pT min cut."); }
-      return 0;
-    }
+    m_cuts.add( "pT min", [this]( Mu muon, Vtx ) { return !( muon->pt() < m_pT_min ); } );
   }
   // |eta| max
   if ( m_eta_max != 1e8 ) {
-    if ( fabs(muon->eta()) > m_eta_max ) {
-      if ( m_debug ) { Info("PassCuts()", "Muon failed |eta| max cut."); }
-      return 0;
-    }
-  }
-  // do not cut on impact parameter if muon is Standalone
-  if ( type != xAOD::Muon::MuonType::MuonStandAlone ) {
-    // d0 cut
-    if ( !( tp->d0() < m_d0_max ) ) {
-    	if ( m_debug ) { Info("PassCuts()", "Muon failed d0 cut."); }
-    	return 0;
-    }
-    // d0sig cut
-    if ( !( d0_significance < m_d0sig_max ) ) {
-    	if ( m_debug ) { Info("PassCuts()", "Muon failed d0 significance cut."); }
-    	return 0;
-    }
-    // z0*sin(theta) cut
-    if ( !( fabs(z0sintheta) < m_z0sintheta_max ) ) {
-    	if ( m_debug ) { Info("PassCuts()", "Muon failed z0*sin(theta) cut."); }
-    	return 0;
-    }
+    m_cuts.add( "|eta| max", [this]( Mu muon, Vtx ) { return !( fabs(muon->eta()) > m_eta_max ); } );
   }
 
-  // if muon is Combined, check charge is the same in ID and MS - Used in some RunI analyses
-  /*
-  if ( type != xAOD::Muon::MuonType::Combined ) {
-
-    const xAOD::TrackParticle* IDTrack = const_cast<xAOD::TrackParticle*>( muon->trackParticle(xAOD::Muon::InnerDetectorTrackParticle) );
-    const xAOD::TrackParticle* MSTrack = const_cast<xAOD::TrackParticle*>( muon->trackParticle(xAOD::Muon::MuonSpectrometerTrackParticle) );
-
-    if ( IDTrack && MSTrack ) {
-      if ( IDTrack->charge() * MSTrack->charge() < 0 ) {
-    	if ( m_debug ) { Info("PassCuts()", "Muon track has different charge measured in ID and MS. Failed selection"); }
-    	return 0;
-      }
-    }
-  }
-  */
-
-  // muon quality
-  xAOD::Muon::Quality my_quality = m_muonSelectionTool->getQuality( *muon );
-  if ( m_debug ) { Info("PassCuts()", "Muon quality %d", static_cast<int>(my_quality)); }
-  /*
-  if ( my_quality <= xAOD::Muon::VeryLoose )
-    verylooseMuons++;
-  if ( my_quality <= xAOD::Muon::Loose )
-    looseMuons++;
-  if ( my_quality <= xAOD::Muon::Medium )
-    mediumMuons++;
-  if ( my_quality <= xAOD::Muon::Tight )
-    tightMuons++;
-  if ( my_quality <= xAOD::Muon::VeryLoose && !(my_quality <= xAOD::Muon::Loose) )
-    badMuons++;
-  */
-
-  // if specified, cut on muon quality
-  HelperClasses::EnumParser<xAOD::Muon::MuonType> muTypeParser;
-  //static_cast<int>(muTypeParser.parseEnum(m_muonType))
+  // https://twiki.cern.ch/twiki/bin/view/AtlasProtected/InDetTrackingDC14
+  // do not cut on impact parameter if muon is Standalone
+  // d0 cut
+  m_cuts.add( "d0", [this]( Mu muon, Vtx ) {
+    if ( muon->muonType() == xAOD::Muon::MuonType::MuonStandAlone ) { return true; }
+    const xAOD::TrackParticle* tp = muon->primaryTrackParticle();
+    return ( tp->d0() < m_d0_max );
+  });
+  // d0sig cut
+  m_cuts.add( "d0 significance", [this]( Mu muon, Vtx ) {
+    if ( muon->muonType() == xAOD::Muon::MuonType::MuonStandAlone ) { return true; }
+    const xAOD::TrackParticle* tp = muon->primaryTrackParticle();
+    float d0_significance = fabs( tp->d0() ) / sqrt(tp->definingParametersCovMatrix()(0,0) );
+    return ( d0_significance < m_d0sig_max );
+  });
+  // z0*sin(theta) cut
+  m_cuts.add( "z0*sin(theta)", [this]( Mu muon, Vtx primaryVertex ) {
+    if ( muon->muonType() == xAOD::Muon::MuonType::MuonStandAlone ) { return true; }
+    const xAOD::TrackParticle* tp = muon->primaryTrackParticle();
+    float z0sintheta = ( tp->z0() + tp->vz() - primaryVertex->z() ) * sin( tp->theta() );
+    return ( fabs(z0sintheta) < m_z0sintheta_max );
+  }, false );
+
+  // if specified, cut on muon type
   if ( !m_muonType.empty() ) {
-    if ( muon->muonType() != static_cast<int>(muTypeParser.parseEnum(m_muonType))) {
-      if ( m_debug ) { Info("PassCuts()", "Muon type: %d - required: %s . Failed", muon->muonType(), m_muonType.c_str()); }
-      return 0;
-    }
+    m_cuts.add( "muon type", [this]( Mu muon, Vtx ) {
+      if ( muon->muonType() != m_muonTypeEnum ) {
+        if ( m_debug ) { Info("PassCuts()", "Muon type: %d - required: %s . Failed", muon->muonType(), m_muonType.c_str()); }
+        return false;
+      }
+      return true;
+    });
   }
 
   // isolation
   if ( m_doIsolation ) {
-    HelperClasses::EnumParser<xAOD::Iso::IsolationType> isoParser;
-    float ptcone_dr = -999., etcone_dr = -999.;
-    if ( muon->isolation(ptcone_dr, isoParser.parseEnum(m_TrackBasedIsoType)) &&  muon->isolation(etcone_dr,isoParser.parseEnum(m_CaloBasedIsoType)) ) {
-      bool isTrackIso = ( ptcone_dr / (muon->pt()) > 0.0 && ptcone_dr / (muon->pt()) <  m_TrackBasedIsoCut);
-      bool isCaloIso  = ( etcone_dr / (muon->pt()) > 0.0 && etcone_dr / (muon->pt()) <  m_CaloBasedIsoCut) ;
-      if ( !( isTrackIso && isCaloIso ) ) {
-        if ( m_debug ) { Info("PassCuts()", "Muon failed isolation cut "); }
-        return 0;
+    m_cuts.add( "isolation", [this]( Mu muon, Vtx ) {
+      float ptcone_dr = -999., etcone_dr = -999.;
+      if ( muon->isolation(ptcone_dr, m_trackBasedIsoEnum) &&  muon->isolation(etcone_dr, m_caloBasedIsoEnum) ) {
+        bool isTrackIso = ( ptcone_dr / (muon->pt()) > 0.0 && ptcone_dr / (muon->pt()) <  m_TrackBasedIsoCut);
+        bool isCaloIso  = ( etcone_dr / (muon->pt()) > 0.0 && etcone_dr / (muon->pt()) <  m_CaloBasedIsoCut) ;
+        return ( isTrackIso && isCaloIso );
       }
-    }
+      return true;
+    });
   }
 
   // this will accept the muon based on the settings at initialization
-  if ( ! m_muonSelectionTool->accept( *muon ) ) {
-    if ( m_debug ) { Info("PassCuts()", "Muon failed requirements of MuonSelectionTool."); }
+  m_cuts.add( "MuonSelectionTool", [this]( Mu muon, Vtx ) {
+    if ( m_debug ) { Info("PassCuts()", "Muon quality %d", static_cast<int>(m_muonSelectionTool->getQuality( *muon ))); }
+    return m_muonSelectionTool->accept( *muon );
+  });
+
+  m_cuts.setAdaptive( m_adaptiveCutOrder, m_cutOrderWarmup );
+}
+
+int MuonSelector :: PassCuts( const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex  ) {
+
+  int failed = m_cuts.firstFailed( muon, primaryVertex );
+  if ( failed >= 0 ) {
+    if ( m_debug ) { Info("PassCuts()", "Muon failed %s cut.", m_cuts.name( failed ).c_str()); }
     return 0;
   }
 
@@ -78,16 +78,16 @@ EL::StatusCode  OverlapRemover :: configure ()
 
     /* Muons */
     m_inContainerName_Muons       = config->GetValue("InputContainerMuons",  "");
-    m_inputAlgoMuons              = config->GetValue("InputAlgoMuons",  "");  // name of vector<string> of syst retrieved from TStore
-    m_outputAlgoMuons             = config->GetValue("OutputAlgoMuons", "MuonCollection_OR_Algo");    // name of vector<string> of syst pushed in TStore
+    m_inputAlgoMuons              = config->GetValue("InputAlgoMuons",  "");  // name of the list of systematics retrieved from TStore (see SystematicIndex)
+    m_outputAlgoMuons             = config->GetValue("OutputAlgoMuons", "MuonCollection_OR_Algo");    // name of the list of systematics pushed in TStore (see SystematicIndex)
     /* Electrons */
     m_inContainerName_Electrons   = config->GetValue("InputContainerElectrons",  "");
-    m_inputAlgoElectrons          = config->GetValue("InputAlgoElectrons",  "");  // name of vector<string> of syst retrieved from TStore
-    m_outputAlgoElectrons         = config->GetValue("OutputAlgoElectrons", "ElectronCollection_OR_Algo");    // name of vector<string> of syst pushed in TStore
+    m_inputAlgoElectrons          = config->GetValue("InputAlgoElectrons",  "");  // name of the list of systematics retrieved from TStore (see SystematicIndex)
+    m_outputAlgoElectrons         = config->GetValue("OutputAlgoElectrons", "ElectronCollection_OR_Algo");    // name of the list of systematics pushed in TStore (see SystematicIndex)
     /* Jets */
     m_inContainerName_Jets        = config->GetValue("InputContainerJets",  "");
-    m_inputAlgoJets               = config->GetValue("InputAlgoJets",  "");  // name of vector<string> of syst retrieved from TStore
-    m_outputAlgoJets              = config->GetValue("OutputAlgoJets", "JetCollection_OR_Algo");    // name of vector<string> of syst pushed in TStore
+    m_inputAlgoJets               = config->GetValue("InputAlgoJets",  "");  // name of the list of systematics retrieved from TStore (see SystematicIndex)
+    m_outputAlgoJets              = config->GetValue("OutputAlgoJets", "JetCollection_OR_Algo");    // name of the list of systematics pushed in TStore (see SystematicIndex)
     /* Photons */
     m_inContainerName_Photons     = config->GetValue("InputContainerPhotons",  "");
     /* Taus */
@@ -140,6 +140,17 @@ EL::StatusCode  OverlapRemover :: configure ()
   m_outAuxContainerName_Photons     = m_outContainerName_Photons + "Aux.";   // the period is very important!
   m_outAuxContainerName_Taus        = m_outContainerName_Taus + "Aux.";      // the period is very important!
 
+  // the names of the containers and decorations of each systematic
+  m_inKeys_Electrons  = SystematicKeys( m_inContainerName_Electrons );
+  m_inKeys_Muons      = SystematicKeys( m_inContainerName_Muons );
+  m_inKeys_Jets       = SystematicKeys( m_inContainerName_Jets );
+  m_outKeys_Electrons = SystematicKeys( m_outContainerName_Electrons );
+  m_outKeys_Muons     = SystematicKeys( m_outContainerName_Muons );
+  m_outKeys_Jets      = SystematicKeys( m_outContainerName_Jets );
+  m_outKeys_Photons   = SystematicKeys( m_outContainerName_Photons );
+  m_outKeys_Taus      = SystematicKeys( m_outContainerName_Taus );
+  m_ORdecorKeys       = SystematicKeys( "", "_overlaps" );
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -196,6 +207,8 @@ EL::StatusCode OverlapRemover :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode OverlapRemover :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -231,6 +244,11 @@ EL::StatusCode OverlapRemover :: initialize ()
   //RETURN_CHECK( "OverlapRemover::initialize()", m_overlapRemovalTool->setProperty("OverlapLabel", "overlaps"), ""); // tool will decorate objects with 'overlaps' boolean if they overlap (not possible to customise name atm!)
   RETURN_CHECK( "OverlapRemover::initialize()", m_overlapRemovalTool->initialize(), "Failed to properly initialize the OverlapRemovalTool.");
 
+  // the systematics we pass on are some of those we get
+  if ( !m_inputAlgoElectrons.empty() ) { SystematicIndex::instance().forwardList( m_inputAlgoElectrons, m_outputAlgoElectrons ); }
+  if ( !m_inputAlgoMuons.empty() )     { SystematicIndex::instance().forwardList( m_inputAlgoMuons,     m_outputAlgoMuons );     }
+  if ( !m_inputAlgoJets.empty() )      { SystematicIndex::instance().forwardList( m_inputAlgoJets,      m_outputAlgoJets );      }
+
   Info("initialize()", "OverlapRemover Interface succesfully initialized!" );
 
   return EL::StatusCode::SUCCESS;
@@ -239,6 +257,8 @@ EL::StatusCode OverlapRemover :: initialize ()
 
 EL::StatusCode OverlapRemover :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -278,11 +298,11 @@ EL::StatusCode OverlapRemover :: execute ()
     //
     // get the systematic sets:
 
-    // get vector of string giving the syst names (rememeber: 1st element is a blank string: nominal case!)
-    std::vector<std::string>* systNames_el(nullptr);
-    RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(systNames_el, m_inputAlgoElectrons, 0, m_store, m_debug) ,"");
+    // get vector of the ids of the systematics (see SystematicIndex, 0 is nominal)
+    std::vector<unsigned int>* systIds_el(nullptr);
+    RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(systIds_el, SystematicIndex::idsKey( m_inputAlgoElectrons ), 0, m_store, m_debug) ,"");
 
-    executeOR(inElectrons, inMuons, inJets, inPhotons, inTaus,  ELSYST, systNames_el);
+    executeOR(inElectrons, inMuons, inJets, inPhotons, inTaus,  ELSYST, systIds_el);
 
   } // end of if ( !m_inputAlgoElectrons.empty() )
 
@@ -297,11 +317,11 @@ EL::StatusCode OverlapRemover :: execute ()
     //
     // get the systematic sets:
 
-    // get vector of string giving the syst names (rememeber: 1st element is a blank string: nominal case!)
-    std::vector<std::string>* systNames_mu(nullptr);
-    RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(systNames_mu, m_inputAlgoMuons, 0, m_store, m_debug) ,"");
+    // get vector of the ids of the systematics (see SystematicIndex, 0 is nominal)
+    std::vector<unsigned int>* systIds_mu(nullptr);
+    RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(systIds_mu, SystematicIndex::idsKey( m_inputAlgoMuons ), 0, m_store, m_debug) ,"");
 
-    executeOR(inElectrons, inMuons, inJets, inPhotons, inTaus,  MUSYST, systNames_mu);
+    executeOR(inElectrons, inMuons, inJets, inPhotons, inTaus,  MUSYST, systIds_mu);
 
   }  // end of if ( !m_inputAlgoMuons.empty() )
 
@@ -316,11 +336,11 @@ EL::StatusCode OverlapRemover :: execute ()
     //
     // get the systematic sets:
 
-    // get vector of string giving the syst names (rememeber: 1st element is a blank string: nominal case!)
-    std::vector<std::string>* systNames_jet;
-    RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(systNames_jet, m_inputAlgoJets, 0, m_store, m_debug) ,"");
+    // get vector of the ids of the systematics (see SystematicIndex, 0 is nominal)
+    std::vector<unsigned int>* systIds_jet(nullptr);
+    RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(systIds_jet, SystematicIndex::idsKey( m_inputAlgoJets ), 0, m_store, m_debug) ,"");
 
-    executeOR(inElectrons, inMuons, inJets, inPhotons, inTaus,  JETSYST, systNames_jet);
+    executeOR(inElectrons, inMuons, inJets, inPhotons, inTaus,  JETSYST, systIds_jet);
 
   }  // end of if ( !m_inputAlgoJets.empty() )
 
@@ -353,6 +373,8 @@ EL::StatusCode OverlapRemover :: postExecute ()
 
 EL::StatusCode OverlapRemover :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -426,7 +448,7 @@ EL::StatusCode OverlapRemover :: printOverlapInfo (const char* type, const xAOD:
 
 EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inElectrons, const xAOD::MuonContainer* inMuons, const xAOD::JetContainer* inJets,
 					     const xAOD::PhotonContainer* inPhotons,   const xAOD::TauJetContainer* inTaus,
-					     SystType syst_type, std::vector<std::string>* sysVec)
+					     SystType syst_type, std::vector<unsigned int>* sysVec)
 {
 
   // instantiate output container(s)
@@ -491,11 +513,11 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
 
       // add ConstDataVector to TStore
       if ( m_createSelectedContainers ) {
-        RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedElectrons, m_outContainerName_Electrons ), "Failed to store const data container");
-        RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedMuons,	 m_outContainerName_Muons ), "Failed to store const data container");
-        RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedJets,	 m_outContainerName_Jets ), "Failed to store const data container");
-        if ( m_usePhotons ){ RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedPhotons, m_outContainerName_Photons ), "Failed to store const data container"); }
-        if ( m_useTaus )   { RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedTaus, m_outContainerName_Taus ), "Failed to store const data container"); }
+        RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedElectrons, m_outContainerName_Electrons, m_store ), "Failed to store const data container");
+        RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedMuons, m_outContainerName_Muons, m_store ), "Failed to store const data container");
+        RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedJets, m_outContainerName_Jets, m_store ), "Failed to store const data container");
+        if ( m_usePhotons ){ RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedPhotons, m_outContainerName_Photons, m_store ), "Failed to store const data container"); }
+        if ( m_useTaus )   { RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedTaus, m_outContainerName_Taus, m_store ), "Failed to store const data container"); }
       }
 
       break;
@@ -505,11 +527,11 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       // prepare a vector of the names of CDV containers
       // must be a pointer to be recorded in TStore
       // for now just copy the one you just retrieved in it!
-      std::vector< std::string >* vecOutContainerNames_el = new std::vector< std::string >(*sysVec);
+      std::vector< unsigned int >* outSystIds_el = new std::vector< unsigned int >(*sysVec);
       // just to check everything is fine
       if ( m_debug ) {
            Info("execute()","output vector already contains the following ELECTRON systematics:" );
-           for ( auto it : *vecOutContainerNames_el ) {	Info("execute()" ,"\t %s ", it.c_str()); }
+           for ( auto it : *outSystIds_el ) {	Info("execute()" ,"\t %s ", SystematicIndex::instance().name(it).c_str()); }
       }
 
       // these input containers won't change in the electron syst loop ...
@@ -518,18 +540,16 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       if ( m_usePhotons )  RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inPhotons, m_inContainerName_Photons, m_event, m_store, m_debug) ,"");
       if ( m_useTaus )     RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inTaus, m_inContainerName_Taus, m_event, m_store, m_debug) ,"");
 
-      for ( auto systName : *sysVec) {
+      for ( auto systId : *sysVec ) {
 
-	if ( systName.empty() ) continue;
+	if ( systId == 0 ) continue;
 
         // ... instead, the electron input container will be different for each syst
-        RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inElectrons, m_inContainerName_Electrons + systName, m_event, m_store, m_debug) ,"");
+        RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inElectrons, m_inKeys_Electrons[systId], m_event, m_store, m_debug) ,"");
         if ( m_debug ) { Info("execute()",  "inElectrons : %lu, inMuons : %lu, inJets : %lu", inElectrons->size(), inMuons->size(),  inJets->size());  }
 
-        std::string ORdecor = std::string("overlaps");
-        // prepends syst name to decoration
-        std::string prepend = systName + "_";
-        ORdecor.insert( 0, prepend );
+        // syst name prepended to the decoration
+        const std::string& ORdecor = m_ORdecorKeys[systId];
 
         RETURN_CHECK( "OverlapRemover::execute()", m_overlapRemovalTool->setProperty( "OverlapLabel", ORdecor.c_str() ), "Failed to set property OverlapLabel" );
 
@@ -568,16 +588,16 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
         // add ConstDataVector to TStore
         if ( m_createSelectedContainers ) {
           // a different syst varied container will be stored for each syst variation
-          RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedElectrons, m_outContainerName_Electrons + systName ), "Failed to store const data container");
-          RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedMuons,     m_outContainerName_Muons + systName ), "Failed to store const data container");
-          RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedJets,      m_outContainerName_Jets + systName ), "Failed to store const data container");
-          if ( m_usePhotons ){ RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedPhotons, m_outContainerName_Photons + systName ), "Failed to store const data container"); }
-          if ( m_useTaus )   { RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedTaus, m_outContainerName_Taus + systName ), "Failed to store const data container"); }
+          RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedElectrons, m_outKeys_Electrons[systId], m_store ), "Failed to store const data container");
+          RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedMuons, m_outKeys_Muons[systId], m_store ), "Failed to store const data container");
+          RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedJets, m_outKeys_Jets[systId], m_store ), "Failed to store const data container");
+          if ( m_usePhotons ){ RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedPhotons, m_outKeys_Photons[systId], m_store ), "Failed to store const data container"); }
+          if ( m_useTaus )   { RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedTaus, m_outKeys_Taus[systId], m_store ), "Failed to store const data container"); }
         }
       } // close loop on systematic sets available from upstream algo (Electrons)
 
       // add vector<string container_names_syst> to TStore
-      RETURN_CHECK( "execute()", m_store->record( vecOutContainerNames_el, m_outputAlgoMuons ), "Failed to record vector of output container names.");
+      RETURN_CHECK( "execute()", SystematicIndex::instance().recordList( outSystIds_el, m_outputAlgoElectrons, m_store ), "Failed to record vector of systematic ids.");
       break;
     }
     case (2) : // muon syst
@@ -585,11 +605,11 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       // prepare a vector of the names of CDV containers
       // must be a pointer to be recorded in TStore
       // for now just copy the one you just retrieved in it!
-      std::vector< std::string >* vecOutContainerNames_mu = new std::vector< std::string >(*sysVec);
+      std::vector< unsigned int >* outSystIds_mu = new std::vector< unsigned int >(*sysVec);
       // just to check everything is fine
       if ( m_debug ) {
          Info("execute()","output vector already contains MUON systematics:" );
-         for (auto it : *vecOutContainerNames_mu){	Info("execute()" ,"\t %s ", it.c_str()); }
+         for ( auto it : *outSystIds_mu ) {	Info("execute()" ,"\t %s ", SystematicIndex::instance().name(it).c_str()); }
       }
 
       // these input containers won't change in the muon syst loop ...
@@ -598,18 +618,16 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       if ( m_usePhotons )  RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inPhotons, m_inContainerName_Photons, m_event, m_store, m_debug) ,"");
       if ( m_useTaus )     RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inTaus, m_inContainerName_Taus, m_event, m_store, m_debug) ,"");
 
-      for ( auto systName : *sysVec) {
+      for ( auto systId : *sysVec ) {
 
-	if ( systName.empty() ) continue;
+	if ( systId == 0 ) continue;
 
 	// ... instead, the muon input container will be different for each syst
-        RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inMuons, m_inContainerName_Muons + systName, m_event, m_store, m_debug) ,"");
+        RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inMuons, m_inKeys_Muons[systId], m_event, m_store, m_debug) ,"");
         if ( m_debug ) { Info("execute()",  "inElectrons : %lu, inMuons : %lu, inJets : %lu", inElectrons->size(), inMuons->size(),  inJets->size());  }
 
-        std::string ORdecor = std::string("overlaps");
-        // prepends syst name to decoration
-        std::string prepend = systName + "_";
-        ORdecor.insert( 0, prepend );
+        // syst name prepended to the decoration
+        const std::string& ORdecor = m_ORdecorKeys[systId];
 
         RETURN_CHECK( "OverlapRemover::execute()", m_overlapRemovalTool->setProperty( "OverlapLabel", ORdecor.c_str() ), "Failed to set property OverlapLabel" );
 
@@ -648,17 +666,17 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
         // add ConstDataVector to TStore
         if ( m_createSelectedContainers ) {
           // a different syst varied container will be stored for each syst variation
-          RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedElectrons, m_outContainerName_Electrons + systName ), "Failed to store const data container");
-          RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedMuons,     m_outContainerName_Muons + systName ), "Failed to store const data container");
-          RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedJets,      m_outContainerName_Jets + systName ), "Failed to store const data container");
-          if ( m_usePhotons ){ RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedPhotons, m_outContainerName_Photons + systName ), "Failed to store const data container"); }
-          if ( m_useTaus )   { RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedTaus, m_outContainerName_Taus + systName ), "Failed to store const data container"); }
+          RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedElectrons, m_outKeys_Electrons[systId], m_store ), "Failed to store const data container");
+          RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedMuons, m_outKeys_Muons[systId], m_store ), "Failed to store const data container");
+          RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedJets, m_outKeys_Jets[systId], m_store ), "Failed to store const data container");
+          if ( m_usePhotons ){ RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedPhotons, m_outKeys_Photons[systId], m_store ), "Failed to store const data container"); }
+          if ( m_useTaus )   { RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedTaus, m_outKeys_Taus[systId], m_store ), "Failed to store const data container"); }
         }
 
       } // close loop on systematic sets available from upstream algo (Muons)
 
       // add vector<string container_names_syst> to TStore
-      RETURN_CHECK( "execute()", m_store->record( vecOutContainerNames_mu, m_outputAlgoMuons ), "Failed to record vector of output container names.");
+      RETURN_CHECK( "execute()", SystematicIndex::instance().recordList( outSystIds_mu, m_outputAlgoMuons, m_store ), "Failed to record vector of systematic ids.");
 
       break;
     }
@@ -667,11 +685,11 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       // prepare a vector of the names of CDV containers
       // must be a pointer to be recorded in TStore
       // for now just copy the one you just retrieved in it!
-      std::vector< std::string >* vecOutContainerNames_jet = new std::vector< std::string >(*sysVec);
+      std::vector< unsigned int >* outSystIds_jet = new std::vector< unsigned int >(*sysVec);
       // just to check everything is fine
       if ( m_debug ) {
         Info("execute()","output vector already contains the following JET systematics:" );
-        for ( auto it : *vecOutContainerNames_jet) { Info("execute()" ,"\t %s ", it.c_str());  }
+        for ( auto it : *outSystIds_jet ) { Info("execute()" ,"\t %s ", SystematicIndex::instance().name(it).c_str()); }
       }
 
       // these input containers won't change in the jet syst loop ...
@@ -680,18 +698,16 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
       if ( m_usePhotons )  RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inPhotons, m_inContainerName_Photons, m_event, m_store, m_debug) ,"");
       if ( m_useTaus )     RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inTaus, m_inContainerName_Taus, m_event, m_store, m_debug) ,"");
 
-      for( auto systName : *sysVec ) {
+      for ( auto systId : *sysVec ) {
 
-	 if ( systName.empty() ) continue;
+	 if ( systId == 0 ) continue;
 
 	 // ... instead, the jet input container will be different for each syst
-         RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inJets, m_inContainerName_Jets + systName, m_event, m_store, m_debug) ,"");
+         RETURN_CHECK("OverlapRemover::execute()", HelperFunctions::retrieve(inJets, m_inKeys_Jets[systId], m_event, m_store, m_debug) ,"");
          if ( m_debug ) { Info("execute()",  "inElectrons : %lu, inMuons : %lu, inJets : %lu", inElectrons->size(), inMuons->size(),  inJets->size());  }
 
-         std::string ORdecor = std::string("overlaps");
-         // prepends syst name to decoration
-         std::string prepend = systName + "_";
-         ORdecor.insert( 0, prepend );
+         // syst name prepended to the decoration
+         const std::string& ORdecor = m_ORdecorKeys[systId];
 
          RETURN_CHECK( "OverlapRemover::execute()", m_overlapRemovalTool->setProperty( "OverlapLabel", ORdecor.c_str() ), "Failed to set property OverlapLabel" );
 
@@ -730,16 +746,16 @@ EL::StatusCode OverlapRemover :: executeOR(  const xAOD::ElectronContainer* inEl
         // add ConstDataVector to TStore
         if ( m_createSelectedContainers ) {
           // a different syst varied container will be stored for each syst variation
-          RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedElectrons, m_outContainerName_Electrons + systName ), "Failed to store const data container");
-          RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedMuons,     m_outContainerName_Muons + systName ), "Failed to store const data container");
-          RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedJets,      m_outContainerName_Jets + systName ), "Failed to store const data container");
-          if ( m_usePhotons ){ RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedPhotons, m_outContainerName_Photons + systName ), "Failed to store const data container"); }
-          if ( m_useTaus )   { RETURN_CHECK( "OverlapRemover::execute()", m_store->record( selectedTaus, m_outContainerName_Taus + systName ), "Failed to store const data container"); }
+          RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedElectrons, m_outKeys_Electrons[systId], m_store ), "Failed to store const data container");
+          RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedMuons, m_outKeys_Muons[systId], m_store ), "Failed to store const data container");
+          RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedJets, m_outKeys_Jets[systId], m_store ), "Failed to store const data container");
+          if ( m_usePhotons ){ RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedPhotons, m_outKeys_Photons[systId], m_store ), "Failed to store const data container"); }
+          if ( m_useTaus )   { RETURN_CHECK( "OverlapRemover::execute()", HelperFunctions::record( selectedTaus, m_outKeys_Taus[systId], m_store ), "Failed to store const data container"); }
         }
       } // close loop on systematic sets available from upstream algo (Jets)
 
       // add vector<string container_names_syst> to TStore
-      RETURN_CHECK( "OverlapRemover::execute()", m_store->record( vecOutContainerNames_jet, m_outputAlgoJets ), "Failed to record vector of output container names.");
+      RETURN_CHECK( "OverlapRemover::execute()", SystematicIndex::instance().recordList( outSystIds_jet, m_outputAlgoJets, m_store ), "Failed to record vector of systematic ids.");
 
       break;
     }
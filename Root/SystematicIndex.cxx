@@ -0,0 +1,71 @@
+/******************************************
+ *
+ * Job-wide integer ids of the systematic
+ * variations.
+ *
+ ******************************************/
+
+// package include(s):
+#include <xAODAnaHelpers/SystematicIndex.h>
+#include <xAODAnaHelpers/HelperFunctions.h>
+
+// ROOT include(s):
+#include "TError.h"
+
+SystematicIndex& SystematicIndex :: instance()
+{
+  static SystematicIndex index;
+  return index;
+}
+
+SystematicIndex :: SystematicIndex()
+{
+  // nominal
+  this->id( "" );
+}
+
+unsigned int SystematicIndex :: id( const std::string& systName )
+{
+  std::map<std::string, unsigned int>::const_iterator it = m_ids.find( systName );
+  if ( it != m_ids.end() ) { return it->second; }
+
+  unsigned int newId = m_names.size();
+  m_names.push_back( systName );
+  m_ids[ systName ] = newId;
+  if ( newId ) { Info("SystematicIndex", "Systematic %u : %s", newId, systName.c_str()); }
+  return newId;
+}
+
+void SystematicIndex :: declareList( const std::string& listName, const std::vector<unsigned int>& ids )
+{
+  if ( listName.empty() ) { return; }
+  m_lists[ listName ] = ids;
+}
+
+void SystematicIndex :: forwardList( const std::string& inListName, const std::string& outListName )
+{
+  const std::vector<unsigned int>* ids = this->list( inListName );
+  if ( !ids ) { return; }
+  // a copy, the map may grow
+  this->declareList( outListName, std::vector<unsigned int>( *ids ) );
+}
+
+const std::vector<unsigned int>* SystematicIndex :: list( const std::string& listName ) const
+{
+  std::map< std::string, std::vector<unsigned int> >::const_iterator it = m_lists.find( listName );
+  if ( it == m_lists.end() ) { return nullptr; }
+  return &it->second;
+}
+
+StatusCode SystematicIndex :: recordList( std::vector<unsigned int>* ids, const std::string& listName, xAOD::TStore* store ) const
+{
+  std::vector<std::string>* names = new std::vector<std::string>;
+  names->reserve( ids->size() );
+  for ( auto id : *ids ) { names->push_back( this->name( id ) ); }
+
+  if ( !HelperFunctions::record( ids, idsKey( listName ), store ).isSuccess() ) {
+    delete names;
+    return StatusCode::FAILURE;
+  }
+  return HelperFunctions::record( names, listName, store );
+}
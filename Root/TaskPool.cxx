@@ -0,0 +1,107 @@
+/******************************************
+ *
+ * Worker threads for the independent tasks
+ * of one event (systematic variations).
+ *
+ ******************************************/
+
+// package include(s):
+#include <xAODAnaHelpers/TaskPool.h>
+
+// ROOT include(s):
+#include "TError.h"
+
+// c++ include(s):
+#include <exception>
+
+TaskPool :: TaskPool( unsigned int nWorkers ) :
+  m_nWorkers( nWorkers ? nWorkers : 1 ),
+  m_task(nullptr),
+  m_nTasks(0),
+  m_batch(0),
+  m_busy(0),
+  m_stop(false),
+  m_next(0),
+  m_ok(true)
+{
+  if ( m_nWorkers == 1 ) { return; }
+
+  // ROOT was made thread safe before any I/O, see xAH::Algorithm::enableThreadSafety()
+  for ( unsigned int worker = 1; worker < m_nWorkers; ++worker ) {
+    m_threads.push_back( std::thread( &TaskPool::work, this, worker ) );
+  }
+}
+
+TaskPool :: ~TaskPool()
+{
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  for ( auto& thread : m_threads ) { thread.join(); }
+}
+
+bool TaskPool :: run( unsigned int nTasks, const Task& task )
+{
+  // in order in this thread, nothing to hand out
+  bool runHere = ( m_threads.empty() || nTasks < 2 );
+
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_task   = &task;
+    m_nTasks = nTasks;
+    m_next   = 0;
+    m_ok     = true;
+    if ( !runHere ) {
+      m_busy = m_threads.size();
+      ++m_batch;
+    }
+  }
+
+  if ( runHere ) {
+    this->drain( 0 );
+    m_task = nullptr;
+    return m_ok;
+  }
+
+  m_cond.notify_all();
+
+  this->drain( 0 );
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [this]{ return m_busy == 0; } );
+  m_task = nullptr;
+
+  return m_ok;
+}
+
+void TaskPool :: work( unsigned int worker )
+{
+  unsigned long batch(0);
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while ( true ) {
+    m_cond.wait( lock, [this, batch]{ return m_stop || m_batch != batch; } );
+    if ( m_stop ) { return; }
+    batch = m_batch;
+
+    lock.unlock();
+    this->drain( worker );
+    lock.lock();
+
+    if ( --m_busy == 0 ) { m_cond.notify_all(); }
+  }
+}
+
+void TaskPool :: drain( unsigned int worker )
+{
+  unsigned int i(0);
+  while ( ( i = m_next++ ) < m_nTasks ) {
+    try {
+      if ( !(*m_task)( worker, i ) ) { m_ok = false; }
+    } catch ( const std::exception& e ) {
+      Error("TaskPool", "Task %u threw: %s", i, e.what());
+      m_ok = false;
+    }
+  }
+}
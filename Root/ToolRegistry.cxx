@@ -0,0 +1,51 @@
+/******************************************
+ *
+ * Tools shared by the algorithms of a
+ * job, one instance per configuration.
+ *
+ ******************************************/
+
+// package include(s):
+#include <xAODAnaHelpers/ToolRegistry.h>
+
+// ROOT include(s):
+#include "TError.h"
+
+ToolRegistry& ToolRegistry :: instance()
+{
+  static ToolRegistry registry;
+  return registry;
+}
+
+unsigned int ToolRegistry :: users( const void* tool ) const
+{
+  std::lock_guard<std::recursive_mutex> lock( m_mutex );
+  for ( const auto& entry : m_tools ) {
+    if ( entry.second.tool == tool ) { return entry.second.users; }
+  }
+  return 0;
+}
+
+void ToolRegistry :: releaseTool( const void* tool )
+{
+  if ( !tool ) { return; }
+
+  std::function<void()> destroy;
+  {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+    std::map<std::string, Entry>::iterator it = m_tools.begin();
+    for ( ; it != m_tools.end(); ++it ) {
+      if ( it->second.tool == tool ) { break; }
+    }
+    if ( it == m_tools.end() ) {
+      Error("ToolRegistry::release()", "Tool at %p was not handed out by the registry, not deleting it", tool);
+      return;
+    }
+    if ( --it->second.users > 0 ) { return; }
+    destroy = it->second.destroy;
+    m_tools.erase( it );
+  }
+
+  // outside the lock, a tool may release the ones it uses when deleted
+  destroy();
+}
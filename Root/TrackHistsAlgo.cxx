@@ -88,6 +88,8 @@ EL::StatusCode TrackHistsAlgo :: changeInput (bool /*firstFile*/) { return EL::S
 
 EL::StatusCode TrackHistsAlgo :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   Info("initialize()", "TrackHistsAlgo");
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
@@ -96,6 +98,8 @@ EL::StatusCode TrackHistsAlgo :: initialize ()
 
 EL::StatusCode TrackHistsAlgo :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   const xAOD::EventInfo* eventInfo(nullptr);
   RETURN_CHECK("TrackHistsAlgo::execute()", HelperFunctions::retrieve(eventInfo, "EventInfo", m_event, m_store, m_debug) ,"");
 
@@ -119,7 +123,13 @@ EL::StatusCode TrackHistsAlgo :: execute ()
 }
 
 EL::StatusCode TrackHistsAlgo :: postExecute () { return EL::StatusCode::SUCCESS; }
-EL::StatusCode TrackHistsAlgo :: finalize () { return EL::StatusCode::SUCCESS; }
+EL::StatusCode TrackHistsAlgo :: finalize ()
+{
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
+  return EL::StatusCode::SUCCESS;
+}
+
 EL::StatusCode TrackHistsAlgo :: histFinalize ()
 {
   // clean up memory
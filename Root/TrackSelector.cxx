@@ -25,7 +25,8 @@ ClassImp(TrackSelector)
 
 TrackSelector :: TrackSelector () :
   m_cutflowHist(nullptr),
-  m_cutflowHistW(nullptr)
+  m_cutflowHistW(nullptr),
+  m_passSelDecor(nullptr)
 {
   // Here you put any code for the base initialization of variables,
   // e.g. initialize all pointers to 0.  Note that you should only put
@@ -81,6 +82,13 @@ EL::StatusCode  TrackSelector :: configure ()
 
     m_failAuxDecorKeys        = config->GetValue("FailDecorKeys", "");
 
+    // run the cheapest cuts per rejected track first, as measured on the first CutOrderWarmup tracks
+    m_adaptiveCutOrder        = config->GetValue("AdaptiveCutOrder", false);
+    m_cutOrderWarmup          = config->GetValue("CutOrderWarmup",   1000);
+
+    // the pT, eta, d0, z0 cuts on the whole container at once (SIMD), only the tracks that pass them go through the rest
+    m_batchPreselection       = config->GetValue("BatchPreselection", false);
+
     config->Print();
     Info("configure()", "TrackSelector Interface succesfully configured! ");
 
@@ -105,7 +113,9 @@ EL::StatusCode  TrackSelector :: configure ()
     return EL::StatusCode::FAILURE;
   }
 
+  m_passSelDecor = &AuxHandles<char>::decorator( "passSel" );
 
+  this->buildCuts();
 
   return EL::StatusCode::SUCCESS;
 }
@@ -178,6 +188,8 @@ EL::StatusCode TrackSelector :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode TrackSelector :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -211,6 +223,8 @@ EL::StatusCode TrackSelector :: initialize ()
 
 EL::StatusCode TrackSelector :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -239,6 +253,13 @@ EL::StatusCode TrackSelector :: execute ()
     selectedTracks = new ConstDataVector<xAOD::TrackParticleContainer>(SG::VIEW_ELEMENTS);
   }
 
+  // the window cuts on all tracks that will be looked at
+  if( !m_preselection.empty() ) {
+    unsigned int nTrk = inTracks->size();
+    if( m_nToProcess > 0 && nTrk > static_cast<unsigned int>(m_nToProcess) ) { nTrk = m_nToProcess; }
+    this->preselect( inTracks, pvx, nTrk );
+  }
+
   xAOD::TrackParticleContainer::const_iterator trk_itr = inTracks->begin();
   xAOD::TrackParticleContainer::const_iterator trk_end = inTracks->end();
   int nPass(0); int nObj(0);
@@ -247,17 +268,22 @@ EL::StatusCode TrackSelector :: execute ()
     // if only looking at a subset of tracks make sure all are decorrated
     if( m_nToProcess > 0 && nObj >= m_nToProcess ) {
       if(m_decorateSelectedObjects) {
-        (*trk_itr)->auxdecor< char >( "passSel" ) = -1;
+        (*m_passSelDecor)( **trk_itr ) = -1;
       } else {
         break;
       }
       continue;
     }
 
+    int passSel(0);
+    if( m_preselection.empty() || m_preselection.pass( nObj ) ) {
+      passSel = this->PassCuts( (*trk_itr), pvx );
+    } else if( m_debug ) {
+      Info("execute()", "Track failed preselection.");
+    }
     nObj++;
-    int passSel = this->PassCuts( (*trk_itr), pvx );
     if(m_decorateSelectedObjects) {
-      (*trk_itr)->auxdecor< char >( "passSel" ) = passSel;
+      (*m_passSelDecor)( **trk_itr ) = passSel;
     }
 
     if(passSel) {
@@ -283,7 +309,7 @@ EL::StatusCode TrackSelector :: execute ()
 
   // add output container to TStore
   if( m_createSelectedContainer ) {
-    RETURN_CHECK( "TrackSelector::execute()", m_store->record( selectedTracks, m_outContainerName ), "Failed to store container.");
+    RETURN_CHECK( "TrackSelector::execute()", HelperFunctions::record( selectedTracks, m_outContainerName, m_store ), "Failed to store container.");
   }
 
   m_numEventPass++;
@@ -311,6 +337,8 @@ EL::StatusCode TrackSelector :: postExecute ()
 
 EL::StatusCode TrackSelector :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -323,6 +351,8 @@ EL::StatusCode TrackSelector :: finalize ()
 
   Info("finalize()", "Deleting tool instances...");
 
+  m_cuts.print( m_name );
+
   return EL::StatusCode::SUCCESS;
 }
 
@@ -343,109 +373,179 @@ EL::StatusCode TrackSelector :: histFinalize ()
   return EL::StatusCode::SUCCESS;
 }
 
-int TrackSelector :: PassCuts( const xAOD::TrackParticle* trk, const xAOD::Vertex *pvx ) {
-
-
-  // pT
-  if( m_pT_max != 1e8 ) {
-    if( trk->pt() > m_pT_max ) { return 0; }
-  }
-  if( m_pT_min != 1e8 ) {
-    if( trk->pt() < m_pT_min ) { return 0; }
-  }
+void TrackSelector :: buildCuts() {
+
+  typedef const xAOD::TrackParticle* Trk;
+  typedef const xAOD::Vertex*        Vtx;
+
+  m_cuts.clear();
+  m_preselection.clear();
+  m_preQuantity.clear();
+
+  if( m_batchPreselection ) {
+    if( m_preselection.addWindow( "pT",            m_pT_min, m_pT_max     ) ) { m_preQuantity.push_back( PRE_PT ); }
+    if( m_preselection.addWindow( "eta",           m_eta_min, m_eta_max   ) ) { m_preQuantity.push_back( PRE_ETA ); }
+    if( m_preselection.addWindow( "d0",            1e8, m_d0_max,     true ) ) { m_preQuantity.push_back( PRE_D0 ); }
+    if( m_preselection.addWindow( "z0",            1e8, m_z0_max,     true ) ) { m_preQuantity.push_back( PRE_Z0 ); }
+    if( m_preselection.addWindow( "z0 sin(theta)", 1e8, m_z0sinT_max, true ) ) { m_preQuantity.push_back( PRE_Z0SINT ); }
+  } else {
+    // pT
+    if( m_pT_max != 1e8 ) {
+      m_cuts.add( "pT max", [this]( Trk trk, Vtx ) { return !( trk->pt() > m_pT_max ); } );
+    }
+    if( m_pT_min != 1e8 ) {
+      m_cuts.add( "pT min", [this]( Trk trk, Vtx ) { return !( trk->pt() < m_pT_min ); } );
+    }
 
-  // eta
-  if( m_eta_max != 1e8 ) {
-    if( trk->eta() > m_eta_max ) { return 0; }
-  }
-  if( m_eta_min != 1e8 ) {
-    if( trk->eta() < m_eta_min ) { return 0; }
-  }
+    // eta
+    if( m_eta_max != 1e8 ) {
+      m_cuts.add( "eta max", [this]( Trk trk, Vtx ) { return !( trk->eta() > m_eta_max ); } );
+    }
+    if( m_eta_min != 1e8 ) {
+      m_cuts.add( "eta min", [this]( Trk trk, Vtx ) { return !( trk->eta() < m_eta_min ); } );
+    }
 
-  //
-  //  D0
-  //
-  if( m_d0_max != 1e8 ){
-    if( fabs(trk->d0()) > m_d0_max ) {return 0; }
-  }
+    //
+    //  D0
+    //
+    if( m_d0_max != 1e8 ){
+      m_cuts.add( "d0", [this]( Trk trk, Vtx ) { return !( fabs(trk->d0()) > m_d0_max ); } );
+    }
 
-  //
-  //  Z0
-  //
-  float z0 = (trk->z0() + trk->vz() - pvx->z());
-  if( m_z0_max != 1e8 ){
-    if( fabs(z0) > m_z0_max ) {return 0; }
-  }
+    //
+    //  Z0
+    //
+    if( m_z0_max != 1e8 ){
+      m_cuts.add( "z0", [this]( Trk trk, Vtx pvx ) { return !( fabs( trk->z0() + trk->vz() - pvx->z() ) > m_z0_max ); }, false );
+    }
 
-  //
-  //  z0 sin(theta)
-  //
-  float sinT        = sin(trk->theta());
-  if( m_z0sinT_max != 1e8 ){
-    if( fabs(z0*sinT) > m_z0sinT_max ) {return 0; }
+    //
+    //  z0 sin(theta)
+    //
+    if( m_z0sinT_max != 1e8 ){
+      m_cuts.add( "z0 sin(theta)", [this]( Trk trk, Vtx pvx ) {
+        float z0   = (trk->z0() + trk->vz() - pvx->z());
+        float sinT = sin(trk->theta());
+        return !( fabs(z0*sinT) > m_z0sinT_max );
+      }, false );
+    }
   }
 
   //
   //  nBLayer
   //
-  uint8_t nBL       = -1;
   if( m_nBL_min != 1e8 ){
-    if(!trk->summaryValue(nBL,       xAOD::numberOfBLayerHits))      Error("PassCuts()", "BLayer hits not filled");
-    if( nBL < m_nBL_min ) {return 0; }
+    m_cuts.add( "nBLayer", [this]( Trk trk, Vtx ) {
+      uint8_t nBL       = -1;
+      if(!trk->summaryValue(nBL,       xAOD::numberOfBLayerHits))      Error("PassCuts()", "BLayer hits not filled");
+      return !( nBL < m_nBL_min );
+    });
   }
 
   //
   //  nSi_min
   //
-  uint8_t nSCT      = -1;
-  uint8_t nPix      = -1;
   if( m_nSi_min != 1e8 ){
-    if(!trk->summaryValue(nPix,      xAOD::numberOfPixelHits))        Error("PassCuts()", "Pix hits not filled");
-    if(!trk->summaryValue(nSCT,      xAOD::numberOfSCTHits))          Error("PassCuts()", "SCT hits not filled");
-    if( (nSCT+nPix) < m_nSi_min ) {return 0;}
+    m_cuts.add( "nSi", [this]( Trk trk, Vtx ) {
+      uint8_t nSCT      = -1;
+      uint8_t nPix      = -1;
+      if(!trk->summaryValue(nPix,      xAOD::numberOfPixelHits))        Error("PassCuts()", "Pix hits not filled");
+      if(!trk->summaryValue(nSCT,      xAOD::numberOfSCTHits))          Error("PassCuts()", "SCT hits not filled");
+      return !( (nSCT+nPix) < m_nSi_min );
+    });
   }
 
   //
   //  nPix Holes
   //
-  uint8_t nPixHoles = -1;
   if( m_nPixHoles_max != 1e8 ){
-    if(!trk->summaryValue(nPixHoles, xAOD::numberOfPixelHoles))       Error("PassCuts()", "Pix holes not filled");
-    if( nPixHoles > m_nPixHoles_max ) {return 0;}
+    m_cuts.add( "nPixHoles", [this]( Trk trk, Vtx ) {
+      uint8_t nPixHoles = -1;
+      if(!trk->summaryValue(nPixHoles, xAOD::numberOfPixelHoles))       Error("PassCuts()", "Pix holes not filled");
+      return !( nPixHoles > m_nPixHoles_max );
+    });
   }
 
   //
   //  chi2
   //
-  float        chi2        = trk->chiSquared();
-  float        ndof        = trk->numberDoF();
   if( m_chi2NdofCut_max != 1e8){
-    float chi2NDoF     = (ndof > 0) ? chi2/ndof : -1;
-    if( chi2NDoF > m_chi2NdofCut_max ) {return 0;}
+    m_cuts.add( "chi2/ndof", [this]( Trk trk, Vtx ) {
+      float chi2     = trk->chiSquared();
+      float ndof     = trk->numberDoF();
+      float chi2NDoF = (ndof > 0) ? chi2/ndof : -1;
+      return !( chi2NDoF > m_chi2NdofCut_max );
+    });
   }
 
   if( m_chi2Prob_max != 1e8 ){
-    float        chi2Prob    = TMath::Prob(chi2,ndof);
-    if( chi2Prob > m_chi2Prob_max) {return 0;}
+    m_cuts.add( "chi2 probability", [this]( Trk trk, Vtx ) {
+      float chi2Prob = TMath::Prob(trk->chiSquared(),trk->numberDoF());
+      return !( chi2Prob > m_chi2Prob_max );
+    });
   }
 
-
   //
   //  Pass Keys
   //
   for(auto& passKey : m_passKeys){
-    if(!(trk->auxdata< char >(passKey) == '1')) { return 0;}
+    const AuxHandles<char>::Accessor& passAcc = AuxHandles<char>::accessor( passKey );
+    m_cuts.add( "pass key " + passKey, [&passAcc]( Trk trk, Vtx ) { return passAcc( *trk ) == '1'; }, false );
   }
 
   //
   //  Fail Keys
   //
   for(auto& failKey : m_failKeys){
-    if(!(trk->auxdata< char >(failKey) == '0')) {return 0;}
+    const AuxHandles<char>::Accessor& failAcc = AuxHandles<char>::accessor( failKey );
+    m_cuts.add( "fail key " + failKey, [&failAcc]( Trk trk, Vtx ) { return failAcc( *trk ) == '0'; }, false );
   }
 
+  m_cuts.setAdaptive( m_adaptiveCutOrder, m_cutOrderWarmup );
+}
+
+void TrackSelector :: preselect( const xAOD::TrackParticleContainer* inTracks, const xAOD::Vertex *pvx, unsigned int nTrk ) {
+
+  // one quantity at a time over all tracks, into the column of its window
+  for( unsigned int iWin = 0; iWin < m_preQuantity.size(); ++iWin ) {
+    double* x = m_preselection.column( iWin, nTrk );
+    switch( m_preQuantity[iWin] ) {
+    case PRE_PT:
+      for( unsigned int i = 0; i < nTrk; ++i ) { x[i] = (*inTracks)[i]->pt(); }
+      break;
+    case PRE_ETA:
+      for( unsigned int i = 0; i < nTrk; ++i ) { x[i] = (*inTracks)[i]->eta(); }
+      break;
+    case PRE_D0:
+      for( unsigned int i = 0; i < nTrk; ++i ) { x[i] = (*inTracks)[i]->d0(); }
+      break;
+    case PRE_Z0:
+      for( unsigned int i = 0; i < nTrk; ++i ) {
+        const xAOD::TrackParticle* trk = (*inTracks)[i];
+        x[i] = (trk->z0() + trk->vz() - pvx->z());
+      }
+      break;
+    case PRE_Z0SINT:
+      for( unsigned int i = 0; i < nTrk; ++i ) {
+        const xAOD::TrackParticle* trk = (*inTracks)[i];
+        float z0   = (trk->z0() + trk->vz() - pvx->z());
+        float sinT = sin(trk->theta());
+        x[i] = z0*sinT;
+      }
+      break;
+    }
+  }
 
-  return 1;
+  m_preselection.evaluate( nTrk );
 }
 
+int TrackSelector :: PassCuts( const xAOD::TrackParticle* trk, const xAOD::Vertex *pvx ) {
+
+  int failed = m_cuts.firstFailed( trk, pvx );
+  if( failed >= 0 ) {
+    if( m_debug ) Info("PassCuts()", "Track failed %s cut.", m_cuts.name( failed ).c_str());
+    return 0;
+  }
 
+  return 1;
+}
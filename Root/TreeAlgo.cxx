@@ -9,6 +9,7 @@
 #include <AthContainers/ConstDataVector.h>
 
 #include <xAODAnaHelpers/TreeAlgo.h>
+#include <xAODAnaHelpers/TrigDecisionCache.h>
 
 #include <xAODAnaHelpers/HelperFunctions.h>
 #include <xAODAnaHelpers/HelperClasses.h>
@@ -21,13 +22,47 @@
 #include "TEnv.h"
 #include "TSystem.h"
 
+#include <cstdlib>
+#include <set>
+#include <sstream>
+
 // this is needed to distribute the algorithm to the workers
 ClassImp(TreeAlgo)
 
 TreeAlgo :: TreeAlgo () :
+  m_outHistDir(false),
+  m_evtDetailStr(""),
+  m_trigDetailStr(""),
+  m_jetTrigDetailStr(""),
+  m_muDetailStr(""),
+  m_elDetailStr(""),
+  m_jetDetailStr(""),
+  m_fatJetDetailStr(""),
+  m_tauDetailStr(""),
+  m_evtContainerName(""),
+  m_muContainerName(""),
+  m_elContainerName(""),
+  m_jetContainerName(""),
+  m_fatJetContainerName(""),
+  m_tauContainerName(""),
+  m_triggerSelection(".*"),
+  m_muSystsVec(""),
+  m_elSystsVec(""),
+  m_jetSystsVec(""),
+  m_tauSystsVec(""),
+  m_DC14(false),
+  m_asyncWrite(false),
+  m_compressionAlgorithm(""),
+  m_compressionLevel(-1),
+  m_basketSize(0),
+  m_autoFlush(0),
+  m_branchSettings(""),
+  m_autoTuneEntries(0),
+  m_autoTuneMemory(10000000),
   m_helpTree(nullptr),
   m_trigConfTool(nullptr),
-  m_trigDecTool(nullptr)
+  m_trigDecTool(nullptr),
+  m_trigCache(nullptr)
 {
   this->SetName("TreeAlgo"); // needed if you want to retrieve this algo with wk()->getAlg(ALG_NAME) downstream
 }
@@ -43,13 +78,22 @@ EL::StatusCode TreeAlgo :: setupJob (EL::Job& job)
   return EL::StatusCode::SUCCESS;
 }
 
+EL::StatusCode TreeAlgo :: histInitialize ()
+{
+  // the background fill needs ROOT to be thread safe before any file is read or written
+  if ( this->configValue( "AsyncWrite", m_asyncWrite ) ) { xAH::Algorithm::enableThreadSafety(); }
+  return EL::StatusCode::SUCCESS;
+}
+
 EL::StatusCode TreeAlgo :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   Info("initialize()", m_name.c_str());
   m_event = wk()->xaodEvent();
   m_store = wk()->xaodStore();
 
-  this->treeInitialize();
+  RETURN_CHECK("TreeAlgo::initialize()", this->treeInitialize(), "");
   return EL::StatusCode::SUCCESS;
 }
 
@@ -76,8 +120,18 @@ EL::StatusCode TreeAlgo :: treeInitialize ()
   // get the file we created already
   TFile* treeFile = wk()->getOutputFile ("tree");
   m_helpTree = new HelpTreeBase( m_event, outTree, treeFile, 1e3, m_debug, m_DC14 );
+  if ( m_asyncWrite ) { m_helpTree->EnableAsyncFill(); }
   // tell the tree to go into the file
   outTree->SetDirectory( treeFile );
+  // branches take the compression of the file when they are created
+  if ( !m_compressionAlgorithm.empty() ) {
+    int settings = HelperFunctions::compressionSettings( m_compressionAlgorithm, m_compressionLevel );
+    if ( settings < 0 ) {
+      Error("treeInitialize()", "Cannot write %s with compression level %i", m_compressionAlgorithm.c_str(), m_compressionLevel);
+      return EL::StatusCode::FAILURE;
+    }
+    treeFile->SetCompressionSettings( settings );
+  }
   // choose if want to add tree to same directory as ouput histograms
   if ( m_outHistDir ) {
     wk()->addOutput( outTree );
@@ -89,15 +143,10 @@ EL::StatusCode TreeAlgo :: treeInitialize ()
 
     Info("initialize()", "Configuring xAODConfigTool and TrigDecisionTool" );
 
-    m_trigConfTool = new TrigConf::xAODConfigTool( "xAODConfigTool" );
-    RETURN_CHECK("TreeAlgo::initialize()", m_trigConfTool->initialize(), "");
-    ToolHandle< TrigConf::ITrigConfigTool > configHandle( m_trigConfTool );
+    // one pair of trigger tools for all the algorithms of the job
+    RETURN_CHECK("TreeAlgo::initialize()", TrigDecisionCache::shareTools( m_trigDecTool, m_trigConfTool ), "");
 
-    m_trigDecTool = new Trig::TrigDecisionTool( "TrigDecisionTool" );
-    RETURN_CHECK("TreeAlgo::initialize()", m_trigDecTool->setProperty( "ConfigTool", configHandle ), "");
-    RETURN_CHECK("TreeAlgo::initialize()", m_trigDecTool->setProperty( "TrigDecisionKey", "xTrigDecision" ), "");
-    RETURN_CHECK("TreeAlgo::initialize()", m_trigDecTool->setProperty( "OutputLevel", MSG::ERROR), "");
-    RETURN_CHECK("TreeAlgo::initialize()", m_trigDecTool->initialize(), "");
+    m_trigCache = new TrigDecisionCache( m_trigDecTool, m_trigConfTool, m_triggerSelection );
 
   }
   
@@ -113,6 +162,17 @@ EL::StatusCode TreeAlgo :: treeInitialize ()
   if ( !m_fatJetContainerName.empty() ) {   m_helpTree->AddFatJets    (m_fatJetDetailStr);  }
   if ( !m_tauContainerName.empty() )    {   m_helpTree->AddTaus       (m_tauDetailStr);     }
 
+  if ( this->applyTreeLayout( m_helpTree ) != EL::StatusCode::SUCCESS ) {
+    Error("treeInitialize()", "Failed to apply the output tree layout");
+    return EL::StatusCode::FAILURE;
+  }
+
+  // one tree per systematic the calibrators can make, the lists were declared in their initialize()
+  if ( !m_muSystsVec.empty() )  { RETURN_CHECK("TreeAlgo::treeInitialize()", this->createSystTrees( "muon", m_muSystsVec ), ""); }
+  if ( !m_elSystsVec.empty() )  { RETURN_CHECK("TreeAlgo::treeInitialize()", this->createSystTrees( "el",   m_elSystsVec ), "");  }
+  if ( !m_jetSystsVec.empty() ) { RETURN_CHECK("TreeAlgo::treeInitialize()", this->createSystTrees( "jet",  m_jetSystsVec ), ""); }
+  if ( !m_tauSystsVec.empty() ) { RETURN_CHECK("TreeAlgo::treeInitialize()", this->createSystTrees( "tau",  m_tauSystsVec ), ""); }
+
   Info("treeInitialize()", "Successfully initialized output tree");
 
   return EL::StatusCode::SUCCESS;
@@ -145,10 +205,25 @@ EL::StatusCode TreeAlgo :: configure ()
     
     m_triggerSelection        = config->GetValue("TriggerSelection",        ".*");
 
+    m_muSystsVec              = config->GetValue("MuonSystsVec",            "");
+    m_elSystsVec              = config->GetValue("ElectronSystsVec",        "");
+    m_jetSystsVec             = config->GetValue("JetSystsVec",             "");
+    m_tauSystsVec             = config->GetValue("TauSystsVec",             "");
+
     // DC14 switch for little things that need to happen to run
     // for those samples with the corresponding packages
     m_DC14                    = config->GetValue("DC14", false);
 
+    m_asyncWrite              = config->GetValue("AsyncWrite", false);
+
+    m_compressionAlgorithm    = config->GetValue("CompressionAlgorithm",    "");
+    m_compressionLevel        = config->GetValue("CompressionLevel",        m_compressionLevel);
+    m_basketSize              = config->GetValue("BasketSize",              m_basketSize);
+    m_autoFlush               = config->GetValue("AutoFlush",               m_autoFlush);
+    m_branchSettings          = config->GetValue("BranchSettings",          "");
+    m_autoTuneEntries         = config->GetValue("AutoTuneEntries",         m_autoTuneEntries);
+    m_autoTuneMemory          = config->GetValue("AutoTuneMemory",          m_autoTuneMemory);
+
     Info("configure()", "Loaded in configuration values");
 
     // everything seems preliminarily ok, let's print config and say we were successful
@@ -157,15 +232,164 @@ EL::StatusCode TreeAlgo :: configure ()
     delete config; config = nullptr;
   }
 
+  // the names of the containers of each systematic
+  m_muKeys  = SystematicKeys( m_muContainerName );
+  m_elKeys  = SystematicKeys( m_elContainerName );
+  m_jetKeys = SystematicKeys( m_jetContainerName );
+  m_tauKeys = SystematicKeys( m_tauContainerName );
+
   return EL::StatusCode::SUCCESS;
 }
 
+EL::StatusCode TreeAlgo :: applyTreeLayout ( HelpTreeBase* helpTree )
+{
+  if ( m_basketSize > 0 ) { helpTree->SetBasketSize( "*", m_basketSize ); }
+  if ( m_autoFlush != 0 ) { helpTree->SetAutoFlush( m_autoFlush ); }
+
+  std::stringstream groups( m_branchSettings );
+  std::string group;
+  while ( groups >> group ) {
+    std::stringstream ss( group );
+    std::string pattern, algorithm, level, basketSize;
+    std::getline( ss, pattern,    ':' );
+    std::getline( ss, algorithm,  ':' );
+    std::getline( ss, level,      ':' );
+    std::getline( ss, basketSize, ':' );
+    if ( pattern.empty() ) {
+      Error("applyTreeLayout()", "No branch pattern in BranchSettings entry %s", group.c_str());
+      return EL::StatusCode::FAILURE;
+    }
+
+    if ( !algorithm.empty() ) {
+      int settings = HelperFunctions::compressionSettings( algorithm, level.empty() ? -1 : atoi( level.c_str() ) );
+      if ( settings < 0 ) {
+        Error("applyTreeLayout()", "Cannot write %s with compression level '%s' (BranchSettings entry %s)", algorithm.c_str(), level.c_str(), group.c_str());
+        return EL::StatusCode::FAILURE;
+      }
+      // the trees of the systematics only have some of the branches
+      if ( !helpTree->SetCompression( pattern, settings ) && helpTree == m_helpTree ) {
+        Warning("applyTreeLayout()", "No branch of %s matches %s", m_name.c_str(), pattern.c_str());
+      }
+    }
+    if ( !basketSize.empty() ) { helpTree->SetBasketSize( pattern, atoi( basketSize.c_str() ) ); }
+  }
+
+  if ( m_autoTuneEntries > 0 ) { helpTree->AutoTuneBaskets( m_autoTuneEntries, m_autoTuneMemory ); }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode TreeAlgo :: createSystTrees ( const std::string& collection, const std::string& systsVec )
+{
+  const std::vector<unsigned int>* systIds = SystematicIndex::instance().list( systsVec );
+  if ( !systIds ) {
+    Error("createSystTrees()", "No algorithm before %s declared the systematics list %s", m_name.c_str(), systsVec.c_str());
+    return EL::StatusCode::FAILURE;
+  }
+
+  std::map< unsigned int, HelpTreeBase* >& systTrees = m_systTrees[ collection ];
+  TFile* treeFile = wk()->getOutputFile ("tree");
+
+  for ( auto systId : *systIds ) {
+    // nominal is in the main tree
+    if ( systId == 0 || systTrees.count( systId ) ) { continue; }
+
+    std::string treeName = m_name + "_" + collection + "_" + SystematicIndex::instance().name( systId );
+    TTree* outTree = new TTree( treeName.c_str(), treeName.c_str() );
+    HelpTreeBase* systTree = new HelpTreeBase( m_event, outTree, treeFile, 1e3, m_debug, m_DC14 );
+    outTree->SetDirectory( treeFile );
+    if ( m_outHistDir ) { wk()->addOutput( outTree ); }
+
+    // the event ids, for matching the entries to those of the main tree
+    systTree->AddEvent( "" );
+    if      ( collection == "muon" ) { systTree->AddMuons     ( m_muDetailStr );  }
+    else if ( collection == "el"   ) { systTree->AddElectrons ( m_elDetailStr );  }
+    else if ( collection == "jet"  ) { systTree->AddJets      ( m_jetDetailStr ); }
+    else if ( collection == "tau"  ) { systTree->AddTaus      ( m_tauDetailStr ); }
+    RETURN_CHECK("TreeAlgo::createSystTrees()", this->applyTreeLayout( systTree ), "");
+
+    systTrees[ systId ] = systTree;
+    Info("createSystTrees()", "Writing %s next to %s", treeName.c_str(), m_name.c_str());
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+EL::StatusCode TreeAlgo :: fillSystTrees ( const std::string& collection, const std::string& systsVec, const xAOD::EventInfo* eventInfo,
+                                           const xAOD::Vertex* primaryVertex, int pvLocation )
+{
+  std::vector<unsigned int>* systIds(nullptr);
+  RETURN_CHECK("TreeAlgo::fillSystTrees()", HelperFunctions::retrieve(systIds, SystematicIndex::idsKey( systsVec ), 0, m_store, m_debug) ,"");
+
+  std::map< unsigned int, HelpTreeBase* >& systTrees = m_systTrees[ collection ];
+  std::set< unsigned int > filled;
+
+  for ( auto systId : *systIds ) {
+    // nominal is in the main tree
+    if ( systId == 0 ) { continue; }
+
+    std::map< unsigned int, HelpTreeBase* >::iterator treeIt = systTrees.find( systId );
+    if ( treeIt == systTrees.end() ) {
+      Error("fillSystTrees()", "Systematic %s of %s was not declared in initialize()", SystematicIndex::instance().name( systId ).c_str(), systsVec.c_str());
+      return EL::StatusCode::FAILURE;
+    }
+    HelpTreeBase* systTree = treeIt->second;
+
+    if ( collection == "muon" ) {
+      const xAOD::MuonContainer* inMuon(nullptr);
+      RETURN_CHECK("TreeAlgo::fillSystTrees()", HelperFunctions::retrieve(inMuon, m_muKeys[systId], m_event, m_store, m_debug) ,"");
+      systTree->FillMuons( inMuon, primaryVertex );
+    } else if ( collection == "el" ) {
+      const xAOD::ElectronContainer* inElec(nullptr);
+      RETURN_CHECK("TreeAlgo::fillSystTrees()", HelperFunctions::retrieve(inElec, m_elKeys[systId], m_event, m_store, m_debug) ,"");
+      systTree->FillElectrons( inElec, primaryVertex );
+    } else if ( collection == "jet" ) {
+      const xAOD::JetContainer* inJets(nullptr);
+      RETURN_CHECK("TreeAlgo::fillSystTrees()", HelperFunctions::retrieve(inJets, m_jetKeys[systId], m_event, m_store, m_debug) ,"");
+      systTree->FillJets( inJets, pvLocation );
+    } else if ( collection == "tau" ) {
+      const xAOD::TauJetContainer* inTaus(nullptr);
+      RETURN_CHECK("TreeAlgo::fillSystTrees()", HelperFunctions::retrieve(inTaus, m_tauKeys[systId], m_event, m_store, m_debug) ,"");
+      systTree->FillTaus( inTaus );
+    }
+    filled.insert( systId );
+  }
+
+  // every systematic tree gets an entry in every event to stay in line with the main tree,
+  // an empty one if the systematic is not there this time
+  for ( auto& systTree : systTrees ) {
+    if ( !filled.count( systTree.first ) ) { this->clearSystTree( collection, systTree.second ); }
+    systTree.second->FillEvent( eventInfo );
+    systTree.second->Fill();
+  }
+
+  return EL::StatusCode::SUCCESS;
+}
+
+void TreeAlgo :: clearSystTree ( const std::string& collection, HelpTreeBase* systTree )
+{
+  if      ( collection == "muon" ) { systTree->ClearMuons();     }
+  else if ( collection == "el"   ) { systTree->ClearElectrons(); }
+  else if ( collection == "jet"  ) { systTree->ClearJets();      }
+  else if ( collection == "tau"  ) { systTree->ClearTaus();      }
+}
+
 EL::StatusCode TreeAlgo :: fileExecute () { return EL::StatusCode::SUCCESS; }
-EL::StatusCode TreeAlgo :: changeInput (bool /*firstFile*/) { return EL::StatusCode::SUCCESS; }
+EL::StatusCode TreeAlgo :: changeInput (bool /*firstFile*/)
+{
+  // the first file comes before initialize(), nothing to redo then
+  if ( m_helpTree ) { m_helpTree->NewInputFile(); }
+  for ( auto& collection : m_systTrees ) {
+    for ( auto& systTree : collection.second ) { systTree.second->NewInputFile(); }
+  }
+  return EL::StatusCode::SUCCESS;
+}
 
 
 EL::StatusCode TreeAlgo :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Get EventInfo and the PrimaryVertices
   const xAOD::EventInfo* eventInfo(nullptr);
   RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(eventInfo, "EventInfo", m_event, m_store, m_debug) ,"");
@@ -178,7 +402,8 @@ EL::StatusCode TreeAlgo :: execute ()
   
   // Fill trigger information
   if ( !m_trigDetailStr.empty() )    {  
-    m_helpTree->FillTrigger( m_trigConfTool, m_trigDecTool, m_triggerSelection );
+    m_trigCache->decide( eventInfo );
+    m_helpTree->FillTrigger( m_trigCache );
   }
   
   // Fill jet trigger information
@@ -192,18 +417,27 @@ EL::StatusCode TreeAlgo :: execute ()
     const xAOD::MuonContainer* inMuon(nullptr);
     RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(inMuon, m_muContainerName, m_event, m_store, m_debug) ,"");
     m_helpTree->FillMuons( inMuon, primaryVertex );
+    if ( !m_muSystsVec.empty() ) {
+      RETURN_CHECK("TreeAlgo::execute()", this->fillSystTrees( "muon", m_muSystsVec, eventInfo, primaryVertex, -1 ), "");
+    }
   }
 
   if ( !m_elContainerName.empty() ) {
     const xAOD::ElectronContainer* inElec(nullptr);
     RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(inElec, m_elContainerName, m_event, m_store, m_debug) ,"");
     m_helpTree->FillElectrons( inElec, primaryVertex );
+    if ( !m_elSystsVec.empty() ) {
+      RETURN_CHECK("TreeAlgo::execute()", this->fillSystTrees( "el", m_elSystsVec, eventInfo, primaryVertex, -1 ), "");
+    }
   }
 
   if ( !m_jetContainerName.empty() ) {
     const xAOD::JetContainer* inJets(nullptr);
     RETURN_CHECK("TreeAlgo::execute()", HelperFunctions::retrieve(inJets, m_jetContainerName, m_event, m_store, m_debug) ,"");
     m_helpTree->FillJets( inJets, HelperFunctions::getPrimaryVertexLocation(vertices) );
+    if ( !m_jetSystsVec.empty() ) {
+      RETURN_CHECK("TreeAlgo::execute()", this->fillSystTrees( "jet", m_jetSystsVec, eventInfo, primaryVertex, HelperFunctions::getPrimaryVertexLocation(vertices) ), "");
+    }
   }
 
   if ( !m_fatJetContainerName.empty() ) {
@@ -215,6 +449,9 @@ EL::StatusCode TreeAlgo :: execute ()
     const xAOD::TauJetContainer* inTaus(nullptr);
     RETURN_CHECK("HTopMultilepTreeAlgo::execute()", HelperFunctions::retrieve(inTaus, m_tauContainerName, m_event, m_store, m_debug) , "");
     m_helpTree->FillTaus( inTaus );
+    if ( !m_tauSystsVec.empty() ) {
+      RETURN_CHECK("TreeAlgo::execute()", this->fillSystTrees( "tau", m_tauSystsVec, eventInfo, primaryVertex, -1 ), "");
+    }
   }
 
   // fill the tree
@@ -227,12 +464,18 @@ EL::StatusCode TreeAlgo :: execute ()
 EL::StatusCode TreeAlgo :: postExecute () { return EL::StatusCode::SUCCESS; }
 
 EL::StatusCode TreeAlgo :: finalize () {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
 
   Info("finalize()", "Deleting tree instances...");
 
   if ( m_helpTree      ) { delete m_helpTree;     m_helpTree     = nullptr; }
-  if ( m_trigDecTool   ) { delete m_trigDecTool;  m_trigDecTool  = nullptr; }
-  if ( m_trigConfTool  ) { delete m_trigConfTool; m_trigConfTool = nullptr; }
+  for ( auto& collection : m_systTrees ) {
+    for ( auto& systTree : collection.second ) { delete systTree.second; }
+  }
+  m_systTrees.clear();
+  if ( m_trigCache     ) { delete m_trigCache;    m_trigCache    = nullptr; }
+  TrigDecisionCache::releaseTools( m_trigDecTool, m_trigConfTool );
 
   return EL::StatusCode::SUCCESS;
 }
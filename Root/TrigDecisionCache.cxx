@@ -0,0 +1,141 @@
+/******************************************
+ *
+ * Per-event trigger decisions for a selection,
+ * with the chain groups resolved once per menu.
+ *
+ ******************************************/
+
+// package include(s):
+#include <xAODAnaHelpers/TrigDecisionCache.h>
+#include <xAODAnaHelpers/ToolRegistry.h>
+#include <xAODAnaHelpers/tools/ReturnCheck.h>
+
+// For the trigger configuration and decisions
+#include "TrigConfxAOD/xAODConfigTool.h"
+#include "TrigDecisionTool/TrigDecisionTool.h"
+
+// C++ include(s)
+#include <functional>
+#include <sstream>
+
+TrigDecisionCache :: TrigDecisionCache( Trig::TrigDecisionTool* trigDecTool, TrigConf::xAODConfigTool* trigConfTool, const std::string& selection ) :
+  m_trigDecTool(trigDecTool),
+  m_trigConfTool(trigConfTool),
+  m_selection(selection),
+  m_bitsDecor(decorationName(selection)),
+  m_masterKey(0),
+  m_L1PSKey(0),
+  m_HLTPSKey(0),
+  m_menuVersion(0),
+  m_selectionGroup(nullptr),
+  m_anyGroup(nullptr),
+  m_L1Group(nullptr),
+  m_HLTGroup(nullptr)
+{
+}
+
+std::string TrigDecisionCache :: decorationName( const std::string& selection )
+{
+  // the selection is a regex, keep it out of the aux variable name
+  std::stringstream name;
+  name << "trigBits_" << std::hash<std::string>()( selection );
+  return name.str();
+}
+
+EL::StatusCode TrigDecisionCache :: shareTools( Trig::TrigDecisionTool*& trigDecTool, TrigConf::xAODConfigTool*& trigConfTool, const std::string& trigDecisionKey )
+{
+  // the registry keys hold every property that is set, so a differently configured tool is never handed out
+  const std::string confName = "xAODConfigTool";
+  RETURN_CHECK("TrigDecisionCache::shareTools()", ToolRegistry::instance().share( trigConfTool, confName, [&]( TrigConf::xAODConfigTool*& confTool ) -> EL::StatusCode {
+    confTool = new TrigConf::xAODConfigTool( confName );
+    RETURN_CHECK("TrigDecisionCache::shareTools()", confTool->initialize(), "");
+    return EL::StatusCode::SUCCESS;
+  }), "");
+
+  // tools in the same job need different names
+  const std::string decName = trigDecisionKey == "xTrigDecision" ? "TrigDecisionTool" : "TrigDecisionTool_" + trigDecisionKey;
+  const std::string decConfig = decName + " ConfigTool=" + confName + " TrigDecisionKey=" + trigDecisionKey + " OutputLevel=ERROR";
+  RETURN_CHECK("TrigDecisionCache::shareTools()", ToolRegistry::instance().share( trigDecTool, decConfig, [&]( Trig::TrigDecisionTool*& decTool ) -> EL::StatusCode {
+    ToolHandle< TrigConf::ITrigConfigTool > configHandle( trigConfTool );
+    decTool = new Trig::TrigDecisionTool( decName );
+    RETURN_CHECK("TrigDecisionCache::shareTools()", decTool->setProperty( "ConfigTool", configHandle ), "");
+    RETURN_CHECK("TrigDecisionCache::shareTools()", decTool->setProperty( "TrigDecisionKey", trigDecisionKey ), "");
+    RETURN_CHECK("TrigDecisionCache::shareTools()", decTool->setProperty( "OutputLevel", MSG::ERROR ), "");
+    RETURN_CHECK("TrigDecisionCache::shareTools()", decTool->initialize(), "");
+    return EL::StatusCode::SUCCESS;
+  }), "");
+
+  return EL::StatusCode::SUCCESS;
+}
+
+void TrigDecisionCache :: releaseTools( Trig::TrigDecisionTool*& trigDecTool, TrigConf::xAODConfigTool*& trigConfTool )
+{
+  // the decision tool uses the config tool, it goes first
+  ToolRegistry::instance().release( trigDecTool );
+  ToolRegistry::instance().release( trigConfTool );
+}
+
+void TrigDecisionCache :: resolve()
+{
+  Info("TrigDecisionCache::resolve()", "Resolving chains for \"%s\" (SMK %u, L1PSK %u, HLTPSK %u)",
+       m_selection.c_str(), m_masterKey, m_L1PSKey, m_HLTPSKey);
+
+  m_selectionGroup = m_trigDecTool->getChainGroup( m_selection );
+  m_anyGroup       = m_trigDecTool->getChainGroup( ".*" );
+  m_L1Group        = m_trigDecTool->getChainGroup( "L1_.*" );
+  m_HLTGroup       = m_trigDecTool->getChainGroup( "HLT_.*" );
+
+  m_chains = m_selectionGroup->getListOfTriggers();
+  m_chainGroups.clear();
+  for ( auto& trigName : m_chains ) {
+    m_chainGroups.push_back( m_trigDecTool->getChainGroup( trigName ) );
+  }
+  m_bits.assign( ( m_chains.size() + 31 ) / 32, 0 );
+
+  ++m_menuVersion;
+}
+
+void TrigDecisionCache :: updateMenu()
+{
+  uint32_t masterKey = m_trigConfTool->masterKey();
+  uint32_t L1PSKey   = m_trigConfTool->lvl1PrescaleKey();
+  uint32_t HLTPSKey  = m_trigConfTool->hltPrescaleKey();
+  if ( !m_menuVersion || masterKey != m_masterKey || L1PSKey != m_L1PSKey || HLTPSKey != m_HLTPSKey ) {
+    m_masterKey = masterKey;
+    m_L1PSKey   = L1PSKey;
+    m_HLTPSKey  = HLTPSKey;
+    this->resolve();
+  }
+}
+
+void TrigDecisionCache :: decide( const xAOD::EventInfo* eventInfo )
+{
+  this->updateMenu();
+
+  // somebody already did the work for this selection in this event
+  if ( eventInfo && m_bitsDecor.isAvailable( *eventInfo ) && m_bitsDecor( *eventInfo ).size() == m_bits.size() ) {
+    m_bits = m_bitsDecor( *eventInfo );
+    return;
+  }
+
+  std::fill( m_bits.begin(), m_bits.end(), 0 );
+  for ( unsigned int iChain = 0; iChain < m_chainGroups.size(); ++iChain ) {
+    if ( m_chainGroups.at(iChain)->isPassed() ) { m_bits.at( iChain/32 ) |= ( 1u << ( iChain%32 ) ); }
+  }
+  if ( eventInfo ) { m_bitsDecor( *eventInfo ) = m_bits; }
+}
+
+bool TrigDecisionCache :: passSelection() const
+{
+  // the group passes if any of its chains does
+  for ( auto word : m_bits ) {
+    if ( word ) return true;
+  }
+  return false;
+}
+
+float TrigDecisionCache :: selectionPrescale() const { return m_selectionGroup->getPrescale(); }
+
+bool TrigDecisionCache :: passAny() const { return m_anyGroup->isPassed(); }
+bool TrigDecisionCache :: passL1()  const { return m_L1Group->isPassed(); }
+bool TrigDecisionCache :: passHLT() const { return m_HLTGroup->isPassed(); }
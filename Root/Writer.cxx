@@ -104,6 +104,8 @@ EL::StatusCode Writer :: changeInput (bool /*firstFile*/)
 
 EL::StatusCode Writer :: initialize ()
 {
+  xAH::ProfileScope profile(this, Stage::INITIALIZE);
+
   // Here you do everything that you need to do after the first input
   // file has been connected and before the first event is processed,
   // e.g. create additional histograms based on which variables are
@@ -134,6 +136,8 @@ EL::StatusCode Writer :: initialize ()
 
 EL::StatusCode Writer :: execute ()
 {
+  xAH::ProfileScope profile(this, Stage::EXECUTE);
+
   // Here you do everything that needs to be done on every single
   // events, e.g. read input variables, apply cuts, and fill
   // histograms and trees.  This is where most of your actual analysis
@@ -212,6 +216,8 @@ EL::StatusCode Writer :: postExecute ()
 
 EL::StatusCode Writer :: finalize ()
 {
+  xAH::ProfileScope profile(this, Stage::FINALIZE);
+
   // This method is the mirror image of initialize(), meaning it gets
   // called after the last event has been processed on the worker node
   // and allows you to finish up any objects you created in
@@ -91,6 +91,18 @@ if __name__ == "__main__":
                       help='Run your jobs on the grid.')
   group_driver.set_defaults(driver='direct')
 
+  parser.add_argument('--nWorkers',
+                      dest='num_workers',
+                      metavar='<n>',
+                      type=int,
+                      help='Number of worker processes to use with --prooflite. Every worker is a separate process with its own TEvent/TStore, its own copy of the algorithm chain and its own instances of every CP tool; outputs (cutflows, metadata, trees) are merged at the end. Default (0): one per core.',
+                      default=0)
+
+  parser.add_argument('--profile',
+                      dest='profile',
+                      action='store_true',
+                      help='Time initialize/execute/finalize and track memory of every algorithm. A summary is added to the histogram output as profile_<name>.')
+
   parser.add_argument('--inputList',
                       dest='input_from_file',
                       action='store_true',
@@ -199,6 +211,9 @@ if __name__ == "__main__":
         else:
           setattr(alg, config_name, config_val)
 
+      if args.profile:
+        alg.setProfile(True)
+
       xAH_logger.info("adding algorithm %s to job", alg_name)
       job.algsAdd(alg)
 
@@ -215,6 +230,9 @@ if __name__ == "__main__":
     elif (args.driver == "prooflite"):
       xAH_logger.info("\trunning on prooflite")
       driver = ROOT.EL.ProofDriver()
+      if args.num_workers > 0:
+        xAH_logger.info("\tusing %d workers", args.num_workers)
+        driver.numWorkers = args.num_workers
       xAH_logger.info("\tsubmit job")
       driver.submit(job, args.submit_dir)
     elif (args.driver == "grid"):
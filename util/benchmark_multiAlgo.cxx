@@ -0,0 +1,175 @@
+#include "xAODRootAccess/Init.h"
+#include "SampleHandler/SampleHandler.h"
+#include "SampleHandler/Sample.h"
+#include "SampleHandler/ToolsDiscovery.h"
+#include "EventLoop/Job.h"
+#include "EventLoop/DirectDriver.h"
+#include "SampleHandler/DiskListLocal.h"
+#include <TSystem.h>
+#include <TH1.h>
+#include <TError.h>
+#include <TEnv.h>
+
+#include "multiAlgoChain.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+
+/*
+ * Throughput benchmark of the chain of test_multiAlgo (see multiAlgoChain.h)
+ * on the bundled r20test_AOD.pool.root. Every algorithm is profiled and the
+ * first nWarmup events are left out of the numbers. The throughput is the wall
+ * clock of the event loop from the first event after the warm-up to the end,
+ * input and framework included. The summary is written to
+ * submitDir/benchmark.json, for scripts, and to submitDir/benchmark.config, a
+ * TEnv file. If a baseline (the benchmark.config of an earlier run) is given,
+ * the two are compared and the exit code is 1 when the throughput dropped by
+ * more than the tolerance.
+ *
+ * usage:
+ * benchmark_multiAlgo  [optional] submitDir nEvents nWarmup baseline.config tolerance
+ */
+
+int main( int argc, char* argv[] ) {
+
+  std::string submitDir = "submitDir";
+  if( argc > 1 ) submitDir = argv[ 1 ];
+  int nEvents = 500;
+  if( argc > 2 ) nEvents = std::atoi( argv[ 2 ] );
+  int nWarmup = 50;
+  if( argc > 3 ) nWarmup = std::atoi( argv[ 3 ] );
+  std::string baseline = "";
+  if( argc > 4 ) baseline = argv[ 4 ];
+  double tolerance = 0.1;
+  if( argc > 5 ) tolerance = std::atof( argv[ 5 ] );
+
+  // Set up the job for xAOD access:
+  xAOD::Init().ignore();
+
+  // Construct the samples to run on:
+  SH::SampleHandler sh;
+  std::string dataPath = gSystem->ExpandPathName("$ROOTCOREBIN/data");
+  SH::DiskListLocal list (dataPath);
+  SH::scanDir (sh, list, "r20test_AOD.pool.root", "xAODAnaHelpers");
+  sh.setMetaString( "nc_tree", "CollectionTree" );
+  sh.print();
+
+  // Create an EventLoop job:
+  EL::Job job;
+  job.sampleHandler( sh );
+  job.options()->setDouble(EL::Job::optRemoveSubmitDir, 1);
+  job.options()->setString( EL::Job::optXaodAccessMode, EL::Job::optXaodAccessMode_branch );
+  job.options()->setDouble(EL::Job::optMaxEvents, nEvents + nWarmup);
+
+  std::vector< xAH::Algorithm* > algs = multiAlgoChain();
+  for ( auto alg : algs ) {
+    alg->setProfile(true, nWarmup);
+    job.algsAdd( alg );
+  }
+
+  // Run the job using the local/direct driver:
+  EL::DirectDriver driver;
+  driver.submit( job, submitDir );
+
+  // collect the per-algorithm summaries back from the histogram output
+  SH::SampleHandler sh_hist;
+  sh_hist.load( submitDir + "/hist" );
+  SH::Sample* sample = sh_hist.at(0);
+
+  std::map< std::string, double > current;
+  double nMeasured(0);
+  double wall(0);
+  double peakRSS(0);
+
+  std::ofstream json( (submitDir + "/benchmark.json").c_str() );
+  TEnv summary;
+  json << "{\n"
+       << "  \"input\": \"r20test_AOD.pool.root\",\n"
+       << "  \"nEvents\": "   << nEvents << ",\n"
+       << "  \"nWarmup\": "   << nWarmup << ",\n"
+       << "  \"algorithms\": [\n";
+
+  for ( unsigned int i = 0; i < algs.size(); ++i ) {
+    std::string name = "profile_" + algs.at(i)->m_name;
+    std::replace( name.begin(), name.end(), '/', '_' );
+    TH1* profile = sample ? dynamic_cast<TH1*>( sample->readHist( name ) ) : nullptr;
+    if ( !profile ) {
+      Error("benchmark_multiAlgo", "Could not find %s in the output", name.c_str());
+      return 1;
+    }
+    name = name.substr( 8 );
+
+    // bin layout is the one of xAH::Algorithm::profileReport()
+    double nExecute = profile->GetBinContent(1);
+    double total    = profile->GetBinContent(3);
+    double mean     = profile->GetBinContent(4);
+    double p99      = profile->GetBinContent(6);
+    double rssExec  = profile->GetBinContent(10);
+    peakRSS = std::max( peakRSS, profile->GetBinContent(11) );
+
+    // the first algorithm starts every event, its wall clock window is the event loop
+    if ( i == 0 ) {
+      nMeasured = profile->GetBinContent(12);
+      wall      = profile->GetBinContent(13);
+    }
+    current[ name ] = mean;
+    summary.SetValue( ("execute_mean_ms." + name).c_str(), mean );
+
+    json << "    { \"name\": \""         << algs.at(i)->m_name
+         << "\", \"class\": \""          << algs.at(i)->ClassName()
+         << "\", \"nExecute\": "         << nExecute
+         << ", \"execute_total_s\": "    << total
+         << ", \"execute_mean_ms\": "    << mean
+         << ", \"execute_p99_ms\": "     << p99
+         << ", \"rss_growth_execute_kB\": " << rssExec
+         << " }" << ( i+1 < algs.size() ? "," : "" ) << "\n";
+  }
+
+  double rate = wall > 0 ? nMeasured/wall : 0;
+
+  json << "  ],\n"
+       << "  \"events\": "        << nMeasured << ",\n"
+       << "  \"wall_s\": "        << wall      << ",\n"
+       << "  \"events_per_s\": "  << rate      << ",\n"
+       << "  \"peak_rss_kB\": "   << peakRSS   << "\n"
+       << "}\n";
+  json.close();
+
+  summary.SetValue( "events",       nMeasured );
+  summary.SetValue( "wall_s",       wall );
+  summary.SetValue( "events_per_s", rate );
+  summary.SetValue( "peak_rss_kB",  peakRSS );
+  summary.WriteFile( (submitDir + "/benchmark.config").c_str() );
+
+  Info("benchmark_multiAlgo", "%.0f events in %.3f s of wall clock: %.1f events/s, peak RSS %.0f kB",
+       nMeasured, wall, rate, peakRSS);
+  Info("benchmark_multiAlgo", "Summary written to %s/benchmark.json and benchmark.config", submitDir.c_str());
+
+  if ( baseline.empty() ) return 0;
+
+  // compare against the benchmark.config of an earlier run
+  TEnv reference;
+  if ( reference.ReadFile( gSystem->ExpandPathName( baseline.c_str() ), kEnvLocal ) != 0 ) {
+    Error("benchmark_multiAlgo", "Could not read baseline %s", baseline.c_str());
+    return 1;
+  }
+
+  for ( auto& alg : current ) {
+    double value = reference.GetValue( ("execute_mean_ms." + alg.first).c_str(), -1.0 );
+    if ( value < 0 ) continue;
+    double ratio = value > 0 ? alg.second/value : 1;
+    Info("benchmark_multiAlgo", "%-30s %8.3f ms (baseline %8.3f ms) %s", alg.first.c_str(), alg.second, value,
+         ratio > 1+tolerance ? "SLOWER" : "");
+  }
+
+  double baselineRate = reference.GetValue( "events_per_s", 0.0 );
+  Info("benchmark_multiAlgo", "Throughput %.1f events/s (baseline %.1f events/s)", rate, baselineRate);
+  if ( baselineRate > 0 && rate < baselineRate*(1-tolerance) ) {
+    Error("benchmark_multiAlgo", "Throughput dropped by more than %.0f%% with respect to the baseline", 100*tolerance);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+#ifndef xAODAnaHelpers_multiAlgoChain_H
+#define xAODAnaHelpers_multiAlgoChain_H
+
+#include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/BasicEventSelection.h"
+#include "xAODAnaHelpers/JetCalibrator.h"
+#include "xAODAnaHelpers/JetSelector.h"
+#include "xAODAnaHelpers/JetHistsAlgo.h"
+#include "xAODAnaHelpers/MuonCalibrator.h"
+#include "xAODAnaHelpers/MuonEfficiencyCorrector.h"
+#include "xAODAnaHelpers/MuonSelector.h"
+#include "xAODAnaHelpers/ElectronCalibrator.h"
+#include "xAODAnaHelpers/ElectronEfficiencyCorrector.h"
+#include "xAODAnaHelpers/ElectronSelector.h"
+#include "xAODAnaHelpers/OverlapRemover.h"
+#include "xAODAnaHelpers/TreeAlgo.h"
+
+#include <string>
+#include <vector>
+
+/*
+  multiAlgoChain
+
+    The chain of test_multiAlgo, shared with benchmark_multiAlgo so the two
+    always run the same thing: the algorithms of data/test_multiAlgo.json, in
+    the same order and set up from the matching .config files, followed by the
+    output tree. The algorithms are returned in that order, to be added to the job.
+
+    Example Usage:
+      for ( auto alg : multiAlgoChain() ) { job.algsAdd( alg ); }
+*/
+inline std::vector< xAH::Algorithm* > multiAlgoChain() {
+
+  std::string localDataDir = "$ROOTCOREBIN/data/xAODAnaHelpers/";
+
+  BasicEventSelection* baseEventSel             = new BasicEventSelection();
+  baseEventSel->setName("baseEventSel")->setConfig(localDataDir+"baseEvent.config");
+
+  JetCalibrator* jetCalib                       = new JetCalibrator();
+  jetCalib->setName("jetCalib_AntiKt4TopoEM")->setConfig(localDataDir+"jetCalib_AntiKt4TopoEMCalib.config");
+
+  MuonCalibrator* muonCalib                     = new MuonCalibrator();
+  muonCalib->setName("muonCalib")->setConfig(localDataDir+"muonCalib.config");
+
+  ElectronCalibrator* electronCalib             = new ElectronCalibrator();
+  electronCalib->setName("electronCalib")->setConfig(localDataDir+"electronCalib.config");/*->setSysts("All");*/
+
+  MuonEfficiencyCorrector*      muonEffCorr     = new MuonEfficiencyCorrector();
+  muonEffCorr->setName("muonEfficiencyCorrector")->setConfig(localDataDir+"muonEffCorr.config");
+
+  ElectronEfficiencyCorrector*  electronEffCorr = new ElectronEfficiencyCorrector();
+  electronEffCorr->setName("electronEfficiencyCorrector")->setConfig(localDataDir+"electronEffCorr.config");/*->setSysts("All");*/
+
+  MuonSelector* muonSelect_signal               = new MuonSelector();
+  muonSelect_signal->setName("muonSelect_signal")->setConfig(localDataDir+"muonSelect_signal.config");
+
+  ElectronSelector* electronSelect_signal       = new ElectronSelector();
+  electronSelect_signal->setName("electronSelect_signal")->setConfig(localDataDir+"electronSelect_signal.config");
+
+  JetSelector* jetSelect_signal                 = new JetSelector();
+  jetSelect_signal->setName("jetSelect_signal")->setConfig(localDataDir+"jetSelect_signal.config");
+
+  // the BJetSelector of the JSON: b-tagging is a JetSelector option
+  JetSelector* bjetSelect_signal                = new JetSelector();
+  bjetSelect_signal->setName("bjetSelect_signal")->setConfig(localDataDir+"bjetSelect_signal.config");
+
+  JetHistsAlgo* jetHistsAlgo_signal             = new JetHistsAlgo();
+  jetHistsAlgo_signal->setName("jetHistsAlgo_signal")->setConfig(localDataDir+"jetHistsAlgo_signal.config");
+
+  JetSelector* jetSelect_truth                  = new JetSelector();
+  jetSelect_truth->setName("jetSelect_truth")->setConfig(localDataDir+"jetSelect_truth.config");
+
+  JetHistsAlgo* jetHistsAlgo_truth              = new JetHistsAlgo();
+  jetHistsAlgo_truth->setName("jetHistsAlgo_truth")->setConfig(localDataDir+"jetHistsAlgo_truth.config");
+
+  OverlapRemover* overlapRemoval                = new OverlapRemover();
+  overlapRemoval->setName("OverlapRemovalTool")->setConfig(localDataDir+"overlapRemoval.config");
+
+  JetHistsAlgo* jk_AntiKt10LC                   = new JetHistsAlgo();
+  jk_AntiKt10LC->setName("AntiKt10/")->setConfig(localDataDir+"test_jetPlotExample.config");
+
+  TreeAlgo* out_tree                            = new TreeAlgo();
+  out_tree->setName("physics")->setConfig(localDataDir+"tree.config");
+
+  return {
+    baseEventSel, jetCalib, muonCalib, electronCalib, muonEffCorr, electronEffCorr,
+    muonSelect_signal, electronSelect_signal, jetSelect_signal, bjetSelect_signal,
+    jetHistsAlgo_signal, jetSelect_truth, jetHistsAlgo_truth, overlapRemoval, jk_AntiKt10LC,
+    out_tree
+  };
+}
+
+#endif
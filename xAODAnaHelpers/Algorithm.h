@@ -11,12 +11,13 @@
 #include <EventLoop/Algorithm.h>
 
 #include <string>
+#include <vector>
 
 namespace xAH {
   class Algorithm : public EL::Algorithm {
       public:
         Algorithm();
-        ClassDef(Algorithm, 1);
+        ClassDef(Algorithm, 2);
 
         Algorithm* setName(std::string name);
         Algorithm* setConfig(std::string configName);
@@ -25,6 +26,9 @@ namespace xAH {
 
         Algorithm* setSyst(std::string systName);
         Algorithm* setSyst(std::string systName, float systVal);
+        Algorithm* setSystThreads(unsigned int systThreads);
+
+        Algorithm* setProfile(bool profile, unsigned int warmup = 0);
 
         // each algorithm should have a unique name for init, to differentiate them
         std::string m_name;
@@ -36,14 +40,78 @@ namespace xAH {
         std::string m_systName;
         // if running systs - the value ( +/- 1 )
         float m_systVal;
+        // if running systs - the number of threads to evaluate them with, every
+        // thread has its own instances of the CP tools (1: no extra threads).
+        // Experimental: the CP tools retrieve from TEvent themselves, which is not
+        // thread safe, so this is not guaranteed to work with every tool
+        // (see HelperFunctions::preloadAux)
+        unsigned int m_systThreads;
+
+        // time initialize/execute/finalize and track the memory growth of each,
+        // a summary is written to the EL output (histogram profile_<name>)
+        bool m_profile;
+        // number of events (of the worker, not calls of this algorithm) left out of the profile,
+        // to skip first-event setup
+        unsigned int m_profileWarmup;
+
+        // the stages of the algorithm that can be profiled
+        enum class Stage { INITIALIZE, EXECUTE, FINALIZE };
 
       protected:
         // name of a config file to load in, optional
         std::string m_configName;
 
+        // every worker gets its own event/store pair (and its own streamed
+        // copy of the algorithm), so these are never sent to the workers
         xAOD::TEvent* m_event; //!
         xAOD::TStore* m_store; //!
 
+        // ROOT has to be made thread safe before the worker reads or writes any file, i.e. in
+        // histInitialize(), by the algorithms that will start threads (SystThreads, AsyncWrite).
+        // Their options are only read by configure() in initialize(), so configValue() looks
+        // the one that matters up in the config file beforehand (value if it is not set there)
+        static void enableThreadSafety();
+        int configValue(const std::string& key, int value) const;
+
+        // called by xAH::ProfileScope, no-ops unless m_profile is set
+        // (apart from opening/releasing the retrieve() cache of the TEvent at initialize/finalize)
+        void profileStart(Stage stage);
+        void profileStop(Stage stage);
+        EL::StatusCode profileReport();
+
+      private:
+        friend class ProfileScope;
+
+        double m_profileStartTime;           //!
+        long   m_profileStartRSS;            //!
+        double m_initializeTime;             //!
+        double m_finalizeTime;               //!
+        // execute times: count, sum and a histogram in log bins for the quantiles
+        unsigned long m_executeCalls;        //!
+        double m_executeTotal;               //!
+        std::vector<unsigned long> m_executeHist; //!
+        // event of the worker being executed (1 = first) and the clock at the first one after the warm-up
+        unsigned long m_profileEvent;        //!
+        double m_profileWallStart;           //!
+        long   m_initializeRSS;              //!
+        long   m_executeRSS;                 //!
+        long   m_finalizeRSS;                //!
+
+  };
+
+  // profile one call of an algorithm method: the clock starts when this is
+  // constructed and stops when it goes out of scope, whichever return is taken.
+  // At initialize/finalize it also opens/releases the HelperFunctions::retrieve() cache of the TEvent
+  //    xAH::ProfileScope profile(this, Stage::EXECUTE);
+  class ProfileScope {
+      public:
+        ProfileScope(Algorithm* alg, Algorithm::Stage stage) :
+          m_alg(alg), m_stage(stage) { m_alg->profileStart(m_stage); }
+        ~ProfileScope() { m_alg->profileStop(m_stage); }
+
+      private:
+        Algorithm*       m_alg;
+        Algorithm::Stage m_stage;
   };
 }
 #endif
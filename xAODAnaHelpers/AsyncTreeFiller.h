@@ -0,0 +1,91 @@
+#ifndef xAODAnaHelpers_AsyncTreeFiller_H
+#define xAODAnaHelpers_AsyncTreeFiller_H
+
+// ROOT include(s):
+#include "TFile.h"
+#include "TTree.h"
+
+// C++ include(s)
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+/*
+  AsyncTreeFiller
+
+    Runs TTree::Fill (and with it the basket compression and the writing to
+    the output file) on a thread of its own, so that it overlaps with the
+    processing of the next event by the algorithms that come before the tree.
+
+    TFile is not thread safe, so there is one filler per output file, shared
+    by all the trees written to it asynchronously, and exactly one entry of
+    one of them is in flight at a time. fill() hands the current entry of a
+    tree over and returns, after waiting for the entry before it if that is
+    still being written. The branch buffers are the ones of the tree's owner:
+    wait() has to be called before they are touched again.
+
+    ROOT keeps global state (gDirectory, the type system) that is touched while
+    writing, so it has to be made thread safe before the job does any I/O:
+    xAH::Algorithm::enableThreadSafety() in histInitialize() of the algorithm
+    that will fill asynchronously (TreeAlgo does it for AsyncWrite).
+
+    Everything else writing to the file on the main thread (trees filled
+    synchronously, TTree::OptimizeBaskets, ...) calls waitFor() first, which
+    returns at once if the file has no filler.
+
+    Example Usage:
+      m_filler = AsyncTreeFiller::acquire( m_tree->GetCurrentFile() );
+      // per event
+      m_filler->wait();   // before clearing / filling the branch buffers
+      ...
+      m_filler->fill( m_tree );
+      // any other tree of the file, filled here
+      AsyncTreeFiller::waitFor( otherTree->GetCurrentFile() );
+      otherTree->Fill();
+      // at the end
+      AsyncTreeFiller::release( m_filler );   // the last user writes the last entry
+*/
+class AsyncTreeFiller
+{
+  public:
+    // the filler of file, made by the first tree asking for it
+    static AsyncTreeFiller* acquire( TFile* file );
+    static void release( AsyncTreeFiller*& filler );
+
+    // nothing is being written to file once this returns (until the next fill())
+    static void waitFor( TFile* file );
+
+    void fill( TTree* tree );
+    void wait();
+
+    Long64_t entries() const { return m_entries; }
+    Long64_t bytes() const   { return m_bytes; }
+
+  private:
+    AsyncTreeFiller( TFile* file );
+    ~AsyncTreeFiller();
+
+    void run();
+
+    TFile* m_file;
+    unsigned int m_users;
+
+    std::thread             m_thread;
+    std::mutex              m_mutex;
+    std::condition_variable m_cond;
+    TTree* m_pending;
+    bool   m_stop;
+
+    Long64_t m_entries;
+    Long64_t m_bytes;
+    Long64_t m_errors;
+
+    static std::mutex s_mutex;
+    static std::map< TFile*, AsyncTreeFiller* > s_fillers;
+
+    AsyncTreeFiller( const AsyncTreeFiller& );
+    AsyncTreeFiller& operator=( const AsyncTreeFiller& );
+};
+
+#endif
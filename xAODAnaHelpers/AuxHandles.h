@@ -0,0 +1,68 @@
+#ifndef xAODAnaHelpers_AuxHandles_H
+#define xAODAnaHelpers_AuxHandles_H
+
+// EDM include(s):
+#include "AthContainers/AuxElement.h"
+
+// C++ include(s)
+#include <map>
+#include <mutex>
+#include <string>
+
+/*
+  AuxHandles
+
+    Job-wide accessors and decorators of aux variables by name. obj->auxdata<T>( name )
+    looks the name up in the aux type registry on every call; an accessor does that
+    once when it is made. Here each (type, name) gets one accessor / decorator, made the
+    first time it is asked for, so that algorithms can resolve the names from their
+    configuration (PassDecorKeys, FailDecorKeys, "passSel", ...) in configure() or
+    initialize() and keep a reference for the per-object loops.
+
+    The references stay valid until the end of the job. Ask for them at setup, not per
+    object: the lookup itself is by name.
+
+    Example Usage:
+      // configure()
+      m_passSelDecor = &AuxHandles<char>::decorator( "passSel" );
+      for ( auto& passKey : m_passKeys ) {
+        const AuxHandles<char>::Accessor& passAcc = AuxHandles<char>::accessor( passKey );
+        m_cuts.add( "pass key " + passKey, [&passAcc]( const xAOD::Jet* jet ) { return passAcc( *jet ) == '1'; } );
+      }
+      // execute()
+      (*m_passSelDecor)( *jet ) = passSel;
+*/
+template <typename T>
+class AuxHandles
+{
+  public:
+    typedef SG::AuxElement::ConstAccessor<T> Accessor;
+    typedef SG::AuxElement::Decorator<T>     Decorator;
+
+    static const Accessor& accessor( const std::string& name )
+    {
+      std::lock_guard<std::mutex> lock( mutex() );
+      static std::map<std::string, Accessor> accessors;
+      typename std::map<std::string, Accessor>::iterator it = accessors.find( name );
+      if ( it == accessors.end() ) { it = accessors.insert( std::make_pair( name, Accessor( name ) ) ).first; }
+      return it->second;
+    }
+
+    static const Decorator& decorator( const std::string& name )
+    {
+      std::lock_guard<std::mutex> lock( mutex() );
+      static std::map<std::string, Decorator> decorators;
+      typename std::map<std::string, Decorator>::iterator it = decorators.find( name );
+      if ( it == decorators.end() ) { it = decorators.insert( std::make_pair( name, Decorator( name ) ) ).first; }
+      return it->second;
+    }
+
+  private:
+    static std::mutex& mutex()
+    {
+      static std::mutex m;
+      return m;
+    }
+};
+
+#endif
@@ -13,6 +13,7 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/TaskPool.h"
 
 class BJetEfficiencyCorrector : public xAH::Algorithm
 {
@@ -42,6 +43,9 @@ private:
 
   // tools
   BTaggingEfficiencyTool  *m_BJetEffSFTool; //!
+  // one efficiency tool per thread of m_systPool, the first is m_BJetEffSFTool
+  std::vector<BTaggingEfficiencyTool*> m_BJetEffSFTools; //!
+  TaskPool *m_systPool; //!
 
   bool m_isEMjet;                //!
   bool m_isLCjet;                //!
@@ -73,6 +77,9 @@ public:
   // these are the functions not inherited from Algorithm
   virtual EL::StatusCode configure ();
 
+  // a new BTaggingEfficiencyTool, configured and initialized
+  EL::StatusCode makeEffSFTool ( BTaggingEfficiencyTool*& effSFTool, const std::string& name );
+
   // this is needed to distribute the algorithm to the workers
   ClassDef(BJetEfficiencyCorrector, 1);
 
@@ -19,6 +19,8 @@ namespace Trig {
   class TrigDecisionTool;
 }
 
+class TrigDecisionCache;
+
 class BasicEventSelection : public xAH::Algorithm
 {
   // put your configuration variables here as public variables.
@@ -43,6 +45,7 @@ class BasicEventSelection : public xAH::Algorithm
 
     TrigConf::xAODConfigTool*    m_trigConfTool;  //!
     Trig::TrigDecisionTool*      m_trigDecTool;   //!
+    TrigDecisionCache*           m_trigCache;     //!
 
     int m_eventCounter;     //!
 
@@ -0,0 +1,66 @@
+#ifndef xAODAnaHelpers_BatchPreselection_H
+#define xAODAnaHelpers_BatchPreselection_H
+
+// C++ include(s)
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+  BatchPreselection
+
+    The window cuts of a selector (min < x < max on pT, eta, d0, ...) on a
+    whole container at once. The selector copies the quantity of each window
+    into a plain array (one column per window, one entry per object) and
+    evaluate() checks all of them with SIMD instructions, leaving a bitmask of
+    the objects inside every window. Only those need to go through the
+    per-object cuts.
+
+    A window fails an object as the one-at-a-time cuts do: x > max or x < min
+    (with |x| if absolute), so a NaN is never cut. A bound equal to
+    "disabled" (1e8, as for the cuts in the configs) is left open.
+
+    Example Usage:
+      // configure()
+      if ( m_preselection.addWindow( "pT", m_pT_min, m_pT_max ) ) { ... remember it is the pT column ... }
+      // execute()
+      double* pt = m_preselection.column( 0, inJets->size() );
+      for ( unsigned int i = 0; i < inJets->size(); ++i ) { pt[i] = inJets->at(i)->pt(); }
+      m_preselection.evaluate( inJets->size() );
+      if ( m_preselection.pass( i ) ) { ... the other cuts ... }
+*/
+class BatchPreselection
+{
+  public:
+    void clear();
+
+    // false (and nothing added) if both bounds are disabled
+    bool addWindow( const std::string& name, double min, double max, bool absolute = false, double disabled = 1e8 );
+
+    unsigned int windows() const { return m_windows.size(); }
+    bool empty() const { return m_windows.empty(); }
+    const std::string& name( unsigned int window ) const { return m_windows.at( window ).name; }
+
+    // the values of one window for the next nObj objects, to be filled by the caller
+    double* column( unsigned int window, unsigned int nObj );
+
+    // fills the mask for the first nObj objects
+    void evaluate( unsigned int nObj );
+
+    bool pass( unsigned int obj ) const { return ( m_mask[ obj >> 6 ] >> ( obj & 63 ) ) & 1; }
+
+  private:
+    struct Window
+    {
+      std::string name;
+      double      min;
+      double      max;
+      bool        absolute;
+      std::vector<double> values;
+    };
+
+    std::vector<Window>   m_windows;
+    std::vector<uint64_t> m_mask;
+};
+
+#endif
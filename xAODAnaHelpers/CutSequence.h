@@ -0,0 +1,193 @@
+#ifndef xAODAnaHelpers_CutSequence_H
+#define xAODAnaHelpers_CutSequence_H
+
+// ROOT include(s):
+#include "TError.h"
+
+// C++ include(s)
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+  CutSequence
+
+    The object cuts of a selector as a list of predicates, put together once
+    at configure time (disabled cuts are simply not added). pass() runs them
+    until the first one that fails.
+
+    By default the cuts run in the order they were added. With adaptive order
+    the first <warmup> objects run through all cuts, the time each cut takes
+    and how often it rejects are measured, and from then on the cuts run
+    cheapest-per-rejection first (cost / rejection rate ascending, which is
+    the best order for independent cuts). The decision is the same in any
+    order, only which cut is reported as the failing one can change.
+
+    Reading the clock costs more than most cuts, so only every 16th warm-up
+    object is timed; the rejections are counted on all of them.
+
+    During the warm-up every movable cut runs on every object, whatever the
+    cuts before it decided, and afterwards any of them can end up first. So a
+    movable cut has to be safe on any object the selector is given. Cuts that
+    are not are added with movable = false: those that decorate the object as
+    they go, and those that rely on something only some objects have (a
+    decoration or attribute that may be missing, the primary vertex, an
+    earlier cut having passed). They always run last, in the order they were
+    added, and only for objects that passed all the cuts before them - during
+    the warm-up too - so they never see an object the fixed order would not
+    have given them.
+
+    Example Usage:
+      // configure()
+      m_cuts.clear();
+      if ( m_pT_min != 1e8 ) { m_cuts.add( "pT min", [this]( const xAOD::Jet* jet ) { return jet->pt() >= m_pT_min; } ); }
+      m_cuts.setAdaptive( m_adaptiveCutOrder, m_cutOrderWarmup );
+      // PassCuts()
+      int failed = m_cuts.firstFailed( jet );
+      if ( failed >= 0 ) { if ( m_debug ) { Info("PassCuts()", "Jet failed %s cut.", m_cuts.name( failed ).c_str()); } return 0; }
+      // finalize()
+      m_cuts.print( m_name );
+*/
+template <typename... Args>
+class CutSequence
+{
+  public:
+    typedef std::function<bool(Args...)> Predicate;
+
+    CutSequence() : m_adaptive(false), m_warmup(0), m_seen(0) { }
+
+    void clear()
+    {
+      m_cuts.clear();
+      m_order.clear();
+      m_seen = 0;
+    }
+
+    void add( const std::string& name, Predicate pass, bool movable = true )
+    {
+      Cut cut;
+      cut.name    = name;
+      cut.pass    = pass;
+      cut.movable = movable;
+      cut.calls   = 0;
+      cut.fails   = 0;
+      cut.timed   = 0;
+      cut.time    = 0.;
+      m_cuts.push_back( cut );
+
+      // the movable ones go in front of those that are not
+      std::vector<unsigned int>::iterator pos = m_order.end();
+      if ( movable ) {
+        pos = std::find_if( m_order.begin(), m_order.end(), [this]( unsigned int iCut ) { return !m_cuts[iCut].movable; } );
+      }
+      m_order.insert( pos, m_cuts.size() - 1 );
+    }
+
+    // reorder after measuring the first warmup objects
+    void setAdaptive( bool adaptive, unsigned int warmup )
+    {
+      m_adaptive = adaptive;
+      m_warmup   = warmup;
+    }
+
+    unsigned int size() const { return m_cuts.size(); }
+    const std::string& name( int cut ) const { return m_cuts.at( cut ).name; }
+
+    // the cut (index in the order of add()) the object fails first, -1 if it passes all
+    int firstFailed( Args... args )
+    {
+      if ( m_adaptive && m_seen <= m_warmup ) {
+        if ( m_seen++ < m_warmup ) { return this->measure( args... ); }
+        this->reorder(); // once, m_seen is past m_warmup now
+      }
+
+      for ( auto iCut : m_order ) {
+        if ( !m_cuts[iCut].pass( args... ) ) { return iCut; }
+      }
+      return -1;
+    }
+
+    bool pass( Args... args ) { return this->firstFailed( args... ) < 0; }
+
+    void print( const std::string& owner ) const
+    {
+      if ( !m_adaptive || m_cuts.empty() ) { return; }
+      Info(owner.c_str(), "Order of the cuts, with what was measured on the first %u objects:", m_warmup);
+      for ( auto iCut : m_order ) {
+        const Cut& cut = m_cuts[iCut];
+        Info(owner.c_str(), "  %-24s %s rejects %5.1f%% of %llu, %.0f ns per object", cut.name.c_str(), cut.movable ? "   " : "(*)",
+             cut.calls ? 100. * cut.fails / cut.calls : 0., cut.calls, cut.timed ? 1e9 * cut.time / cut.timed : 0.);
+      }
+    }
+
+  private:
+    struct Cut
+    {
+      std::string name;
+      Predicate   pass;
+      bool        movable;
+      unsigned long long calls;
+      unsigned long long fails;
+      unsigned long long timed; // calls that were timed
+      double      time; // s, of the timed calls
+    };
+
+    // warm-up objects between two that are timed
+    enum { TimeEvery = 16 };
+
+    // all movable cuts, timed on every TimeEvery-th object; the rest (never reordered, never timed)
+    // only if all those before them pass, stopping at the first that fails
+    int measure( Args... args )
+    {
+      const bool timeIt = ( m_seen - 1 ) % TimeEvery == 0;
+      int failed(-1);
+      for ( auto iCut : m_order ) {
+        Cut& cut = m_cuts[iCut];
+        if ( !cut.movable && failed >= 0 ) { break; }
+        bool pass(false);
+        if ( timeIt && cut.movable ) {
+          std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+          pass = cut.pass( args... );
+          cut.time += std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+          ++cut.timed;
+        } else {
+          pass = cut.pass( args... );
+        }
+        ++cut.calls;
+        if ( !pass ) {
+          ++cut.fails;
+          if ( failed < 0 ) { failed = iCut; }
+          if ( !cut.movable ) { break; }
+        }
+      }
+      return failed;
+    }
+
+    void reorder()
+    {
+      // time spent per object rejected; the cuts that never rejected go last, cheapest first
+      std::vector< std::pair<bool, double> > score( m_cuts.size(), std::make_pair( false, 0. ) );
+      for ( unsigned int iCut = 0; iCut < m_cuts.size(); ++iCut ) {
+        const Cut& cut = m_cuts[iCut];
+        if ( !cut.calls ) { continue; }
+        double cost = cut.timed ? cut.time / cut.timed : 0.;
+        score[iCut] = cut.fails ? std::make_pair( false, cost * cut.calls / cut.fails ) : std::make_pair( true, cost );
+      }
+      std::stable_sort( m_order.begin(), m_order.end(), [this, &score]( unsigned int a, unsigned int b ) {
+        if ( !m_cuts[a].movable || !m_cuts[b].movable ) { return m_cuts[a].movable && !m_cuts[b].movable; }
+        return score[a] < score[b];
+      });
+    }
+
+    bool m_adaptive;
+    unsigned int m_warmup;
+    unsigned int m_seen;
+
+    std::vector<Cut>          m_cuts;
+    std::vector<unsigned int> m_order;
+};
+
+#endif
@@ -11,8 +11,13 @@
 // external tools include(s):
 #include "ElectronPhotonFourMomentumCorrection/EgammaCalibrationAndSmearingTool.h"
 
+// EDM include(s):
+#include "xAODEgamma/ElectronContainer.h"
+
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/SystematicIndex.h"
+#include "xAODAnaHelpers/TaskPool.h"
 
 class ElectronCalibrator : public xAH::Algorithm
 {
@@ -28,15 +33,16 @@ public:
 
 
   // systematics
-  std::string m_inputAlgoSystNames;  // this is the name of the vector of names of the systematically varied containers produced by the
+  std::string m_inputAlgoSystNames;  // this is the name of the vector of ids (see SystematicIndex) of the systematically varied containers produced by the
   			             // upstream algo (e.g., the SC containers with calibration systematics)
-  std::string m_outputAlgoSystNames; // this is the name of the vector of names of the systematically varied containers produced by THIS
+  std::string m_outputAlgoSystNames; // this is the name of the vector of ids (see SystematicIndex) of the systematically varied containers produced by THIS
   				     // algo ( these will be the m_inputAlgoSystNames of the algo downstream
   bool m_runSysts;
   bool m_runAllSyst;
 
 private:
   int m_numEvent;         //!
+  // electrons written out, counted once per variation
   int m_numObject;        //!
 
   std::string m_outAuxContainerName;
@@ -44,9 +50,17 @@ private:
   std::string m_outSCAuxContainerName;
 
   std::vector<CP::SystematicSet> m_systList; //!
+  // ids in SystematicIndex, in the order of m_systList
+  std::vector<unsigned int> m_systIds;       //!
+  SystematicKeys m_outSCKeys;                //!
+  SystematicKeys m_outSCAuxKeys;             //!
+  SystematicKeys m_outKeys;                  //!
 
   // tools
   CP::EgammaCalibrationAndSmearingTool *m_EgammaCalibrationAndSmearingTool; //!
+  // one calibration tool per thread of m_systPool, the first is m_EgammaCalibrationAndSmearingTool
+  std::vector<CP::EgammaCalibrationAndSmearingTool*> m_EgammaCalibrationAndSmearingTools; //!
+  TaskPool *m_systPool; //!
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
@@ -73,6 +87,12 @@ public:
   // these are the functions not inherited from Algorithm
   virtual EL::StatusCode configure ();
 
+  // a new EgammaCalibrationAndSmearingTool, configured and initialized
+  EL::StatusCode makeCalibTool ( CP::EgammaCalibrationAndSmearingTool*& calibTool, const std::string& name );
+
+  // calibrate with the systematic the tool is set to; runs in the syst threads, so it touches neither TEvent nor TStore
+  EL::StatusCode calibrate ( CP::EgammaCalibrationAndSmearingTool* calibTool, xAOD::ElectronContainer* electrons, const std::string& systName );
+
   // this is needed to distribute the algorithm to the workers
   ClassDef(ElectronCalibrator, 1);
 };
@@ -15,6 +15,8 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/SystematicIndex.h"
+#include "xAODAnaHelpers/TaskPool.h"
 
 class ElectronEfficiencyCorrector : public xAH::Algorithm
 {
@@ -25,7 +27,7 @@ public:
   std::string m_inContainerName;
 
   // systematics
-  std::string m_inputAlgoSystNames;  // this is the name of the vector of names of the systematically varied containers produced by the
+  std::string m_inputAlgoSystNames;  // this is the name of the vector of ids (see SystematicIndex) of the systematically varied containers produced by the
   			             // upstream algo (e.g., the SC containers with calibration systematics)
   bool m_runAllSyst;
   std::string m_outputSystNames;
@@ -39,8 +41,14 @@ private:
 
   std::vector<CP::SystematicSet> m_systList; //!
 
+  // container names of each systematic
+  SystematicKeys m_inKeys; //!
+
   // tools
   AsgElectronEfficiencyCorrectionTool  *m_asgElectronEfficiencyCorrectionTool; //!
+  // one efficiency tool per thread of m_systPool, the first is m_asgElectronEfficiencyCorrectionTool
+  std::vector<AsgElectronEfficiencyCorrectionTool*> m_asgElectronEfficiencyCorrectionTools; //!
+  TaskPool *m_systPool; //!
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
@@ -68,6 +76,8 @@ public:
 
   // these are the functions not inherited from Algorithm
   virtual EL::StatusCode configure ();
+  // a new AsgElectronEfficiencyCorrectionTool, configured and initialized
+  EL::StatusCode makeEffTool ( AsgElectronEfficiencyCorrectionTool*& effTool, const std::string& name );
   virtual EL::StatusCode executeSF (  const xAOD::ElectronContainer* inputElectrons, unsigned int countSyst  );
 
   // this is needed to distribute the algorithm to the workers
@@ -17,6 +17,9 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/AuxHandles.h"
+#include "xAODAnaHelpers/CutSequence.h"
+#include "xAODAnaHelpers/SystematicIndex.h"
 
 class ElectronSelector : public xAH::Algorithm
 {
@@ -60,6 +63,11 @@ public:
   std::string    m_CutBasedConfigYear;
   std::string    m_CutBasedOperatingPoint;
 
+  // PID decorations
+  std::string    m_LHDecorWPs;        // LH WPs to decorate, comma separated (all if empty)
+  std::string    m_CutBasedDecorWPs;  // cut-based WPs to decorate, comma separated (all if empty)
+  bool           m_PIDShortCircuit;   // decorate 0 w/o calling the tool once a looser WP fails
+
   // isolation
   bool           m_doIsolation;
   std::string    m_IsoWP;
@@ -71,6 +79,9 @@ public:
   std::string    m_TrackBasedIsoType;
   float          m_TrackBasedIsoCut;
 
+  bool           m_adaptiveCutOrder;  // reorder the cuts by measured cost and rejection
+  int            m_cutOrderWarmup;    // number of electrons to measure the cuts on
+
   std::string    m_passAuxDecorKeys;  //!
   std::string    m_failAuxDecorKeys;  //!
 
@@ -81,11 +92,21 @@ private:
   int m_weightNumEventPass; //!
   int m_numObjectPass;      //!
 
+  // container names of each systematic
+  SystematicKeys m_inKeys;  //!
+  SystematicKeys m_outKeys; //!
+
   // cutflow
   TH1D* m_cutflowHist;      //!
   TH1D* m_cutflowHistW;     //!
   int   m_cutflow_bin;      //!
 
+  // the passSel decoration, resolved in configure()
+  const SG::AuxElement::Decorator< char >* m_passSelDecor; //!
+
+  // the enabled cuts, in the order PassCuts() runs them
+  CutSequence<const xAOD::Electron*, const xAOD::Vertex*> m_cuts; //!
+
   // tools
   CP::IsolationSelectionTool         *m_IsolationSelectionTool;               //! /* MC15 tool for isolation*/
   CP::ElectronIsolationSelectionTool *m_ElectronIsolationSelectionTool;       //! /* DC14 tool for isolation*/
@@ -97,6 +118,9 @@ private:
   std::vector<std::string> m_passKeys;  //!
   std::vector<std::string> m_failKeys;  //!
 
+  std::vector<std::string> m_LHDecorWPList;        //!
+  std::vector<std::string> m_CutBasedDecorWPList;  //!
+
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
   // node (done by the //!)
@@ -130,8 +154,10 @@ public:
   // added functions not from Algorithm
   // why does this need to be virtual?
   virtual int PassCuts( const xAOD::Electron* electron, const xAOD::Vertex *primaryVertex );
+  // put the enabled cuts in m_cuts
+  void buildCuts();
   // this is needed to distribute the algorithm to the workers
-  ClassDef(ElectronSelector, 1);
+  ClassDef(ElectronSelector, 2);
 };
 
 #endif
@@ -24,12 +24,19 @@
 #include "xAODTau/TauJetContainer.h"
 
 #include "xAODAnaHelpers/HelperClasses.h"
+#include "xAODAnaHelpers/TreeColumns.h"
+#include "xAODAnaHelpers/JaggedVector.h"
+#include "xAODAnaHelpers/JetAttributeView.h"
 #include "xAODRootAccess/TEvent.h"
 
 // root includes
 #include "TTree.h"
 #include "TFile.h"
 
+// c++ includes
+#include <set>
+#include <tuple>
+
 namespace TrigConf {
   class xAODConfigTool;
 }
@@ -38,12 +45,15 @@ namespace Trig {
   class TrigDecisionTool;
 }
 
+class TrigDecisionCache;
+class AsyncTreeFiller;
+
 class HelpTreeBase {
 
 public:
 
   HelpTreeBase(xAOD::TEvent *event, TTree* tree, TFile* file, const float units = 1e3, bool debug = false, bool DC14 = false );
-  virtual ~HelpTreeBase() {;}
+  virtual ~HelpTreeBase();
 
   void AddEvent       (const std::string detailStr = "");
   void AddTrigger     (const std::string detailStr = "");
@@ -67,6 +77,8 @@ public:
   
 
   void FillEvent( const xAOD::EventInfo* eventInfo, xAOD::TEvent* event = 0 );
+  void FillTrigger( TrigDecisionCache* trigCache );
+  // the same, through a TrigDecisionCache of this tree for the tools and chains given
   void FillTrigger( TrigConf::xAODConfigTool* trigConfTool, Trig::TrigDecisionTool* trigDecTool, std::string trigs = ".*" );
   void FillJetTrigger( TrigConf::xAODConfigTool* trigConfTool, Trig::TrigDecisionTool* trigDecTool );
   void FillMuons( const xAOD::MuonContainer* muons, const xAOD::Vertex* primaryVertex );
@@ -86,6 +98,30 @@ public:
 
   bool writeTo( TFile *file );
 
+  // aux variable availability is looked up again after this
+  void NewInputFile();
+
+  // TTree::Fill runs in the background, overlapping with the next event.
+  // All the trees of the output file enabling it share one thread, and
+  // the others wait for it before they are filled. The Clear functions
+  // wait for it, anything else writing the branch buffers (or the output
+  // file) has to call WaitForFill() first
+  void EnableAsyncFill();
+  void WaitForFill();
+
+  // output layout, to be called after the Add functions. branches is a
+  // wildcard pattern ("jet_*"), settings ROOT's 100*algorithm + level.
+  // SetCompression returns the number of branches it matched
+  int  SetCompression( const std::string& branches, int settings );
+  void SetBasketSize( const std::string& branches, Int_t size );
+  void SetAutoFlush( Long64_t autoFlush );
+  // after nEntries entries, share maxMemory bytes of baskets out over the
+  // branches by how much each one wrote so far
+  void AutoTuneBaskets( Long64_t nEntries, Long64_t maxMemory );
+
+  // read friend's branches with this tree, entry by entry, as <alias>.<branch>
+  void AddFriend( HelpTreeBase* friendTree, const std::string& alias );
+
   virtual void AddEventUser(const std::string detailStr = "")      { 
     Info("AddEventUser","Empty function called from HelpTreeBase %s",detailStr.c_str()); 
     return; 
@@ -137,6 +173,10 @@ public:
 protected:
 
   TTree* m_tree;
+  AsyncTreeFiller* m_asyncFiller;
+  Long64_t m_autoTuneEntries;
+  Long64_t m_autoTuneMemory;
+  Long64_t m_nFilled;
 
   int m_units; //For MeV to GeV conversion in output
   
@@ -180,6 +220,15 @@ protected:
   unsigned int m_HLTPSKey;
   std::vector<std::string> m_allTriggers;
   std::vector<int> m_allTriggerDec;
+  // dictionary encoded: names written once per menu to m_trigMenuTree,
+  // per event only the packed decisions and the menu keys they refer to
+  std::vector<unsigned int> m_triggerBits;
+  TTree* m_trigMenuTree;
+  unsigned int m_trigMenuVersion;
+  std::vector<std::string> m_trigMenuNames;
+  std::set< std::tuple<unsigned int, unsigned int, unsigned int> > m_trigMenuWritten;
+  // the cache of FillTrigger( trigConfTool, trigDecTool, trigs )
+  TrigDecisionCache* m_ownTrigCache;
   
   // jet trigger
 
@@ -190,6 +239,9 @@ protected:
   std::vector<float> m_jet_phi;
   std::vector<float> m_jet_E;
 
+  // fills the clean, energy, truth and truth detail vectors below that are plain aux variables
+  TreeColumns* m_jetColumns;
+
   // clean
   std::vector<float> m_jet_time;
   std::vector<float> m_jet_LArQuality;
@@ -216,18 +268,30 @@ protected:
   std::vector<float> m_jet_lowEtFrac;
   std::vector<float> m_jet_muonSegCount;
   std::vector<float> m_jet_width;
+  JetAttributeView m_jetAttributes;
+
+  // the per-jet lists below are filled by their JaggedVector when the branches are
+  // written as vector<vector> and stay empty with the flatVectors layout
 
   // layer
   std::vector< std::vector<float> > m_jet_ePerSamp;
+  JaggedVector<float> m_jet_ePerSampBranch;
 
   // tracksAll
   std::vector< std::vector<int> >   m_jet_NTrkPt1000;
+  JaggedVector<int>   m_jet_NTrkPt1000Branch;
   std::vector< std::vector<float> > m_jet_SumPtPt1000;
+  JaggedVector<float> m_jet_SumPtPt1000Branch;
   std::vector< std::vector<float> > m_jet_TrkWPt1000;
+  JaggedVector<float> m_jet_TrkWPt1000Branch;
   std::vector< std::vector<int> >   m_jet_NTrkPt500;
+  JaggedVector<int>   m_jet_NTrkPt500Branch;
   std::vector< std::vector<float> > m_jet_SumPtPt500;
+  JaggedVector<float> m_jet_SumPtPt500Branch;
   std::vector< std::vector<float> > m_jet_TrkWPt500;
+  JaggedVector<float> m_jet_TrkWPt500Branch;
   std::vector< std::vector<float> > m_jet_jvf;
+  JaggedVector<float> m_jet_jvfBranch;
   std::vector< std::vector<float> > m_jet_jvfloose;
 
   // tracksPV
@@ -244,9 +308,13 @@ protected:
   std::vector<int> m_jet_GhostTrackCount;
   std::vector<float> m_jet_GhostTrackPt;
   std::vector< std::vector<float> > m_jet_GhostTrack_pt;
+  JaggedVector<float> m_jet_GhostTrack_ptBranch;
   std::vector< std::vector<float> > m_jet_GhostTrack_eta;
+  JaggedVector<float> m_jet_GhostTrack_etaBranch;
   std::vector< std::vector<float> > m_jet_GhostTrack_phi;
+  JaggedVector<float> m_jet_GhostTrack_phiBranch;
   std::vector< std::vector<float> > m_jet_GhostTrack_e;
+  JaggedVector<float> m_jet_GhostTrack_eBranch;
 
   // flavor tag
   std::vector<float> m_jet_sv0;
@@ -330,6 +398,9 @@ protected:
   std::vector<float> m_el_eta;
   std::vector<float> m_el_m;
   
+  // fills the isolation and PID vectors
+  TreeColumns* m_elColumns;
+
   // isolation
   std::vector<int>   m_el_isIsolated;
   
@@ -2,7 +2,9 @@
 #define xAODAnaHelpers_HELPERCLASSES_H
 
 #include <map>
+#include <set>
 #include <iostream>
+#include <stdint.h>
 
 #include "TString.h"
 
@@ -34,33 +36,60 @@ namespace HelperClasses {
   };
 
   /* template enum parser
-  copied from: http://stackoverflow.com/a/726681
+  the names of each enum are a fixed table (HelperClasses.cxx), nothing is
+  built when a parser is made; resolve the strings of the configuration
+  once, in configure(), and keep the enum
   */
   template <typename T>
   class EnumParser
   {
-     std::multimap <std::string, T> enumMap;
    public:
-     EnumParser();
+     /* false (and result untouched) if value is not a name of T */
+     static bool find(const std::string &value, T &result)
+     {
+        for ( const std::pair<const char*, T>* entry = entries(); entry->first; ++entry ) {
+          if ( value == entry->first ) { result = entry->second; return true; }
+        }
+        return false;
+     }
 
-     T parseEnum(const std::string &value)
+     static T parseEnum(const std::string &value)
      {
-        typename std::multimap <std::string, T>::const_iterator iValue = enumMap.find(value);
-        if (iValue == enumMap.end()){
+        T result = T();
+        if ( !find(value, result) ) {
             std::cerr << "Could not find input string in enum!" << std::endl;
-	}
-        return iValue->second;
+        }
+        return result;
      }
+
+   private:
+     /* { name, value } pairs, ended by a null name */
+     static const std::pair<const char*, T>* entries();
   };
 
 
+  /* The config string is split on whitespace once, and a flag is on only if
+     it is one of the words, so "truth" does not turn on with "truth_details".
+     Every flag also sets its bit in m_mask. The per-object fill loops copy the
+     mask to a local once and test the bits of that:
+       const uint32_t mask = m_jetInfoSwitch->m_mask;
+       for( ... ) { if ( mask & JetInfoSwitch::KINEMATIC ) { ... } }
+  */
   struct InfoSwitch {
     const std::string m_configStr;
-    InfoSwitch(const std::string configStr) : m_configStr(configStr) { };
-    bool parse(const std::string flag);
+    std::set<std::string> m_configTokens;
+    uint32_t m_mask;
+    InfoSwitch(const std::string configStr);
+    bool parse(const std::string flag, uint32_t bit = 0);
   };
 
   struct EventInfoSwitch : InfoSwitch {
+    enum Flag : uint32_t {
+      PILEUP   = 1u << 0,
+      SHAPE_EM = 1u << 1,
+      SHAPE_LC = 1u << 2,
+      TRUTH    = 1u << 3
+    };
     bool m_pileup;
     bool m_shapeEM;
     bool m_shapeLC;
@@ -70,14 +99,25 @@ namespace HelperClasses {
   };
 
   struct TriggerInfoSwitch : InfoSwitch {
+    enum Flag : uint32_t {
+      BASIC        = 1u << 0,
+      MENU_KEYS    = 1u << 1,
+      ALL_TRIGGERS = 1u << 2,
+      TRIGGER_BITS = 1u << 3
+    };
     bool m_basic;
     bool m_menuKeys;
     bool m_allTriggers;
+    bool m_triggerBits;
     void initialize();
     TriggerInfoSwitch(const std::string configStr) : InfoSwitch(configStr) { initialize(); };
   };
   
   struct JetTriggerInfoSwitch : InfoSwitch {
+    enum Flag : uint32_t {
+      KINEMATIC = 1u << 0,
+      CLEAN     = 1u << 1
+    };
     bool m_kinematic;
     bool m_clean;
     void initialize();
@@ -85,6 +125,11 @@ namespace HelperClasses {
   };
 
   struct MuonInfoSwitch : InfoSwitch {
+    enum Flag : uint32_t {
+      KINEMATIC    = 1u << 0,
+      TRACKPARAMS  = 1u << 1,
+      TRACKHITCONT = 1u << 2
+    };
     bool m_kinematic;
     bool m_trackparams;
     bool m_trackhitcont;
@@ -93,6 +138,13 @@ namespace HelperClasses {
   };
 
   struct ElectronInfoSwitch : InfoSwitch {
+    enum Flag : uint32_t {
+      KINEMATIC    = 1u << 0,
+      ISOLATION    = 1u << 1,
+      PID          = 1u << 2,
+      TRACKPARAMS  = 1u << 3,
+      TRACKHITCONT = 1u << 4
+    };
     bool m_kinematic;
     bool m_isolation;
     bool m_PID;
@@ -103,6 +155,20 @@ namespace HelperClasses {
   };
 
   struct JetInfoSwitch : InfoSwitch {
+    enum Flag : uint32_t {
+      KINEMATIC     = 1u << 0,
+      CLEAN         = 1u << 1,
+      ENERGY        = 1u << 2,
+      RESOLUTION    = 1u << 3,
+      TRUTH         = 1u << 4,
+      TRUTH_DETAILS = 1u << 5,
+      LAYER         = 1u << 6,
+      TRACK_PV      = 1u << 7,
+      TRACK_ALL     = 1u << 8,
+      ALL_TRACK     = 1u << 9,
+      FLAVOR_TAG    = 1u << 10,
+      FLAT_VECTORS  = 1u << 11
+    };
     bool m_kinematic;
     bool m_clean;
     bool m_energy;
@@ -114,12 +180,18 @@ namespace HelperClasses {
     bool m_trackAll;
     bool m_allTrack;
     bool m_flavTag;
+    bool m_flatVectors;
     int  m_numLeadingJets;
     void initialize();
     JetInfoSwitch(const std::string configStr) : InfoSwitch(configStr) { initialize(); };
   };
 
   struct TauInfoSwitch : InfoSwitch {
+    enum Flag : uint32_t {
+      KINEMATIC    = 1u << 0,
+      TRACKPARAMS  = 1u << 1,
+      TRACKHITCONT = 1u << 2
+    };
     bool m_kinematic;
     bool m_trackparams;
     bool m_trackhitcont;
@@ -3,7 +3,15 @@
 
 // for typing in template
 #include <typeinfo>
+#include <typeindex>
+#include <type_traits>
 #include <cxxabi.h>
+#include <unordered_map>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <set>
 // Gaudi/Athena include(s):
 #include "AthContainers/normalizedTypeinfoName.h"
 
@@ -15,7 +23,12 @@
 #include "xAODJet/JetContainer.h"
 
 #include "xAODTracking/VertexContainer.h"
+#include "xAODRootAccess/TEvent.h"
+#include "xAODRootAccess/TStore.h"
+#include "xAODRootAccess/tools/TVirtualIncidentListener.h"
 #include "AthContainers/ConstDataVector.h"
+#include "AthContainers/AuxElement.h"
+#include "AthContainers/AuxVectorData.h"
 #include "xAODAnaHelpers/HelperClasses.h"
 
 // CP interface includes
@@ -32,11 +45,17 @@
 namespace HelperFunctions {
 
   // primary vertex
+  //   the PV location and the NPV are worked out once per event and vertex container
+  //   (the per-event boundary is the one of RetrieveCache below), so every algorithm
+  //   can call these on every event without rescanning the container
   bool passPrimaryVertexSelection(const xAOD::VertexContainer* vertexContainer, int Ntracks = 2);
   int countPrimaryVertices(const xAOD::VertexContainer* vertexContainer, int Ntracks = 2);
   const xAOD::Vertex* getPrimaryVertex(const xAOD::VertexContainer* vertexContainer);
   int getPrimaryVertexLocation(const xAOD::VertexContainer* vertexContainer);
   std::string replaceString(std::string subjet, const std::string& search, const std::string& replace);
+  // ROOT compression settings (100*algorithm + level) from "ZLIB", "LZMA", "LZ4" or "ZSTD",
+  // -1 for an unknown name or level. LZ4/ZSTD become ZLIB with a ROOT too old for them
+  int compressionSettings(const std::string& algorithm, int level);
 
 
   /*@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@*\
@@ -200,6 +219,113 @@ namespace HelperFunctions {
       // look for "AntiKt10LCTopoJets" in only TEvent, enable verbose output
       RETURN_CHECK("JetCalibrator::execute()", HelperFunctions::retrieve(jets, "AntiKt10LCTopoJets", m_event, 0, true) ,"");
   */
+  /*  RetrieveCache    per-event lookup cache used by retrieve()
+        - remembers where (TStore or TEvent) and at which address an object of a given
+          type and name was found, so that retrieving "EventInfo" or "PrimaryVertices"
+          again later in the same event is a single hashed lookup
+        - only objects that were found are cached, a miss always goes to TStore/TEvent
+        - TStore keeps its priority: record() below drops a name from the cache when
+          something is recorded in TStore under it, so an object found in TEvent is not
+          handed out any more once TStore has one of that name. TStore is cleared at
+          every entry, the cache with it. Objects recorded in TStore directly, not
+          through record(), are not seen until the next entry
+        - there is one cache per TEvent, keyed on the entry the TEvent has loaded: it listens
+          to the BeginEvent incident that TEvent::getEntry() fires, and retrieve() drops
+          whatever it holds from an earlier entry, whoever calls it and whether or not an
+          algorithm profiles. Nothing is cached before the cache has heard of an entry
+        - retrieve() calls without a TEvent are not cached, there is no entry to key them on
+        - every cache is locked on its own, so lookups from the syst threads are safe (the
+          TEvent/TStore behind them are not, see preloadEvent() below)
+        - xAH::Algorithm opens the cache of its TEvent at initialize, before the first entry,
+          and releases it at finalize. A cache that has already heard of entries when it is
+          opened belongs to a TEvent that went without a finalize and whose address the new
+          one reuses, it is replaced by a new one
+        - hits()/misses() count the lookups served from the cache / from TStore-TEvent
+  */
+  class RetrieveCache : public xAOD::TVirtualIncidentListener {
+    public:
+      // the cache of event, made and registered with event on first use (nullptr: none)
+      static RetrieveCache* forEvent(xAOD::TEvent* event);
+      // the cache of event, made now so that it hears of the first entry; one left by an
+      // earlier TEvent at this address is replaced
+      static void open(xAOD::TEvent* event);
+      // stop listening to event and stop caching for it, until the next open()
+      static void release(xAOD::TEvent* event);
+
+      // changes with every entry any cached TEvent loads, anything keyed on it is per-event
+      // (0: no TEvent is listened to, nothing can be known to be per-event)
+      static unsigned long generation() { return s_generation; }
+      static unsigned long hits() { return s_hits; }
+      static unsigned long misses() { return s_misses; }
+
+      // something of this name was recorded in TStore: drop it from every cache
+      static void recorded(const std::string& name);
+
+      // BeginEvent of our TEvent: a new entry, everything we hold is stale
+      virtual void handle(const xAOD::TIncident& inc);
+
+      // store: the TStore retrieve() looks in (nullptr: TEvent only)
+      template <typename T>
+      T* find(const std::string& name, bool inEvent, xAOD::TStore* store) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if ( !m_listening || !m_entry ) return nullptr;
+        this->sync();
+        auto entries = m_cache.find(name);
+        if ( entries != m_cache.end() ) {
+          for ( const auto& entry : entries->second ) {
+            if ( entry.type != std::type_index(typeid(T)) ) continue;
+            // never hand out a non-const pointer to something that was retrieved const
+            if ( entry.isConst && !std::is_const<T>::value ) continue;
+            // a TEvent entry is only there while TStore has nothing of this name
+            if ( entry.fromStore ? store != nullptr : inEvent ) {
+              ++s_hits;
+              return static_cast<T*>( const_cast<void*>(entry.object) );
+            }
+          }
+        }
+        ++s_misses;
+        return nullptr;
+      }
+
+      template <typename T>
+      void add(const std::string& name, const T* object, bool fromStore) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if ( !m_listening || !m_entry ) return;
+        this->sync();
+        m_cache[name].push_back( Entry{ std::type_index(typeid(T)), object, fromStore, std::is_const<T>::value } );
+      }
+
+    private:
+      RetrieveCache();
+
+      // drop the objects of an earlier entry, with m_mutex held
+      void sync() {
+        if ( m_cachedEntry == m_entry ) return;
+        m_cache.clear();
+        m_cachedEntry = m_entry;
+      }
+
+      struct Entry {
+        std::type_index type;
+        const void* object;
+        bool fromStore;
+        bool isConst;
+      };
+
+      bool m_listening;
+      // entries our TEvent has loaded since we listen to it (0: none yet) / the one the objects belong to
+      unsigned long m_entry;
+      unsigned long m_cachedEntry;
+      std::unordered_map< std::string, std::vector<Entry> > m_cache;
+      std::mutex m_mutex;
+
+      static std::mutex s_mutex;
+      static std::map< const xAOD::TEvent*, RetrieveCache* > s_caches;
+      static std::atomic<unsigned long> s_generation;
+      static std::atomic<unsigned long> s_hits;
+      static std::atomic<unsigned long> s_misses;
+  };
+
   template <typename T>
   StatusCode retrieve(T*& cont, std::string name, xAOD::TEvent* event, xAOD::TStore* store, bool debug=false){
     /* Checking Order:
@@ -213,6 +339,12 @@ namespace HelperFunctions {
         return SUCCESS (should never reach this last line)
     */
 
+    RetrieveCache* cache = RetrieveCache::forEvent(event);
+    if( cache && (cont = cache->find<T>(name, event != NULL, store)) ){
+      if(debug) Info("HelperFunctions::retrieve()", "\tRetrieved %s of type %s from the per-event cache", name.c_str(), type_name<T>().c_str());
+      return StatusCode::SUCCESS;
+    }
+
     if(debug) Info("HelperFunctions::retrieve()", "\tAttempting to retrieve %s of type %s", name.c_str(), type_name<T>().c_str());
     if((store == NULL) && (debug))                      Info("HelperFunctions::retrieve()", "\t\tLooking inside: xAOD::TEvent");
     if((event == NULL) && (debug))                      Info("HelperFunctions::retrieve()", "\t\tLooking inside: xAOD::TStore");
@@ -221,10 +353,12 @@ namespace HelperFunctions {
       if(debug) Info("HelperFunctions::retrieve()", "\t\t\tFound inside xAOD::TStore");
       if(!store->retrieve( cont, name ).isSuccess()) return StatusCode::FAILURE;
       if(debug) Info("HelperFunctions::retrieve()", "\t\t\tRetrieved from xAOD::TStore");
+      if(cache) cache->add<T>(name, cont, true);
     } else if((event != NULL) && (event->contains<T>(name))){
       if(debug) Info("HelperFunctions::retrieve()", "\t\t\tFound inside xAOD::TEvent");
       if(!event->retrieve( cont, name ).isSuccess()) return StatusCode::FAILURE;
       if(debug) Info("HelperFunctions::retrieve()", "\t\t\tRetrieved from xAOD::TEvent");
+      if(cache) cache->add<T>(name, cont, false);
     } else {
       if(debug) Info("HelperFunctions::retrieve()", "\t\tNot found at all");
       return StatusCode::FAILURE;
@@ -232,6 +366,60 @@ namespace HelperFunctions {
     return StatusCode::SUCCESS;
   }
 
+  /*  record    records an object in TStore, where retrieve() will find it
+        - same as store->record( obj, name ), and the retrieve() cache learns that TStore
+          now has something of this name, which comes before an object of the same name
+          found in TEvent earlier in the event
+        - record the objects that later algorithms retrieve through here, not in TStore
+          directly
+
+      Example Usage:
+      RETURN_CHECK("JetSelector::execute()", HelperFunctions::record( selectedJets, m_outContainerName, m_store ), "Failed to store const data container.");
+  */
+  template <typename T>
+  StatusCode record(T* obj, const std::string& name, xAOD::TStore* store){
+    if(!store || !store->record( obj, name ).isSuccess()) return StatusCode::FAILURE;
+    RetrieveCache::recorded(name);
+    return StatusCode::SUCCESS;
+  }
+
+  /*  preloading for the workers of a TaskPool
+        TEvent reads a container the first time it is retrieved on an entry, its TAuxStore
+        reads an aux variable the first time it is asked for, and an ElementLink looks up
+        its target the first time it is followed. None of that is thread safe, so before
+        handing objects to the syst threads the main thread does it for the variables the
+        caller knows its CP tool to read.
+        @ preloadEvent()  : retrieves EventInfo and PrimaryVertices and reads the variables
+                            of them the CP tools use (run/event numbers, pile-up, vertex type
+                            and tracks)
+        @ preloadAux()    : reads the listed aux variables of the containers owning the
+                            object(s), views are followed to the containers behind them.
+                            Variables a container does not have are skipped
+        Follow the links the tools follow (caloCluster(), btagging(), ...) on the main
+        thread as well and preload what they point to.
+
+        This does not make the threads safe: a tool reading a variable that is not listed,
+        or retrieving something through its own evtStore(), still reaches TEvent from the
+        thread. That is why SystThreads is experimental.
+
+      Example Usage:
+      if ( m_systPool->workers() > 1 ) {
+        RETURN_CHECK("JetCalibrator::execute()", HelperFunctions::preloadEvent(m_event, m_store, m_debug), "");
+        HelperFunctions::preloadAux(inJets, { "pt", "eta", "phi", "m" });
+      }
+  */
+  StatusCode preloadEvent(xAOD::TEvent* event, xAOD::TStore* store, bool debug=false);
+  void preloadAux(const std::set<const SG::AuxVectorData*>& containers, const std::vector<std::string>& variables);
+  void preloadAux(const SG::AuxElement* obj, const std::vector<std::string>& variables);
+
+  template <typename T>
+  void preloadAux(const DataVector<T>* cont, const std::vector<std::string>& variables){
+    if(!cont) return;
+    std::set<const SG::AuxVectorData*> containers;
+    for(const T* obj : *cont) containers.insert(obj->container());
+    preloadAux(containers, variables);
+  }
+
   /* update with better logic
       -- call HelperFunctions::retrieve() instead
       -- if user wants `const DataVector<T>` and `ConstDataVector<T>` exists but `const DataVector<T>` does not, auto-convert for them
@@ -0,0 +1,162 @@
+#ifndef xAODAnaHelpers_JaggedVector_H
+#define xAODAnaHelpers_JaggedVector_H
+
+// ROOT include(s):
+#include "TTree.h"
+
+// C++ include(s)
+#include <string>
+#include <vector>
+
+/*
+  JaggedVector
+
+    A per-object branch that holds a list per object (e.g. per-vertex track
+    moments of a jet). Written either as the usual std::vector<std::vector<T>>
+    or, with flat = true, as two plain branches:
+      <name>          std::vector<T>   all values of all objects, one after the other
+      <name>_offsets  std::vector<int> where the values of each object start
+    so the object i has the values [ offsets[i], offsets[i+1] ) with the last
+    one running to the end.
+
+    The flat layout has no inner vectors to allocate per event and ROOT streams
+    it as two simple arrays. JaggedVectorReader gives back the per-object view
+    for either layout.
+
+    The nested layout is written from a vector<vector> of the owner (the
+    m_jet_* members of HelpTreeBase), which is left empty in the flat layout.
+
+    Example Usage:
+      // constructor: m_jet_jvfBranch( m_jet_jvf )
+      m_jet_jvfBranch.branch( m_tree, "jet_JVF", flat );
+      ...
+      m_jet_jvfBranch.push_back( jvf( *jet_itr ) );
+      // or element by element
+      m_jet_GhostTrack_ptBranch.newRow();
+      for( ... ) { m_jet_GhostTrack_ptBranch.append( trk->pt() / m_units ); }
+*/
+template <typename T>
+class JaggedVector
+{
+  public:
+    JaggedVector( std::vector< std::vector<T> >& nested ) : m_flat(false), m_nested(nested) { }
+
+    void branch( TTree* tree, const std::string& name, bool flat )
+    {
+      m_flat = flat;
+      if ( m_flat ) {
+        tree->Branch( name.c_str(),                &m_values  );
+        tree->Branch( (name + "_offsets").c_str(), &m_offsets );
+      } else {
+        tree->Branch( name.c_str(),                &m_nested  );
+      }
+    }
+
+    // start the list of the next object
+    void newRow()
+    {
+      if ( m_flat ) { m_offsets.push_back( m_values.size() ); }
+      else          { m_nested.push_back( std::vector<T>() ); }
+    }
+
+    // add to the list of the current object
+    void append( T value )
+    {
+      if ( m_flat ) { m_values.push_back( value ); }
+      else          { m_nested.back().push_back( value ); }
+    }
+
+    // the whole list of the next object, optionally divided by the units
+    void push_back( const std::vector<T>& row, float units = 0. )
+    {
+      if ( !m_flat && !units ) { m_nested.push_back( row ); return; }
+      this->newRow();
+      for ( auto value : row ) { this->append( units ? value / units : value ); }
+    }
+
+    void clear()
+    {
+      m_values.clear();
+      m_offsets.clear();
+      m_nested.clear();
+    }
+
+  private:
+    bool m_flat;
+    std::vector<T>                m_values;
+    std::vector<int>              m_offsets;
+    std::vector< std::vector<T> >& m_nested;
+};
+
+/*
+  JaggedVectorReader
+
+    Reads a branch written by JaggedVector in either layout.
+
+    Example Usage:
+      JaggedVectorReader<float> jvf;
+      jvf.setBranchAddress( tree, "jet_JVF" );
+      tree->GetEntry( i );
+      for( unsigned int iJet = 0; iJet < jvf.size(); ++iJet ) {
+        float jvfPV = jvf.at(iJet)[pvLocation];
+      }
+*/
+template <typename T>
+class JaggedVectorReader
+{
+  public:
+    class Row
+    {
+      public:
+        Row( const T* begin, const T* end ) : m_begin(begin), m_end(end) { }
+        unsigned int size() const { return m_end - m_begin; }
+        bool empty() const { return m_begin == m_end; }
+        const T& operator[]( unsigned int i ) const { return m_begin[i]; }
+        const T* begin() const { return m_begin; }
+        const T* end() const { return m_end; }
+        std::vector<T> vector() const { return std::vector<T>( m_begin, m_end ); }
+      private:
+        const T* m_begin;
+        const T* m_end;
+    };
+
+    JaggedVectorReader() : m_flat(false), m_values(0), m_offsets(0), m_nested(0) { }
+    ~JaggedVectorReader()
+    {
+      delete m_values;
+      delete m_offsets;
+      delete m_nested;
+    }
+
+    void setBranchAddress( TTree* tree, const std::string& name )
+    {
+      m_flat = tree->GetBranch( (name + "_offsets").c_str() ) != 0;
+      if ( m_flat ) {
+        tree->SetBranchAddress( name.c_str(),                &m_values  );
+        tree->SetBranchAddress( (name + "_offsets").c_str(), &m_offsets );
+      } else {
+        tree->SetBranchAddress( name.c_str(),                &m_nested  );
+      }
+    }
+
+    unsigned int size() const { return m_flat ? m_offsets->size() : m_nested->size(); }
+
+    Row at( unsigned int i ) const
+    {
+      if ( !m_flat ) {
+        const std::vector<T>& row = m_nested->at(i);
+        return Row( row.data(), row.data() + row.size() );
+      }
+      unsigned int end = ( i + 1 < m_offsets->size() ) ? m_offsets->at(i + 1) : m_values->size();
+      return Row( m_values->data() + m_offsets->at(i), m_values->data() + end );
+    }
+    Row operator[]( unsigned int i ) const { return this->at(i); }
+
+  private:
+    bool m_flat;
+    std::vector<T>*                m_values;
+    std::vector<int>*              m_offsets;
+    std::vector< std::vector<T> >* m_nested;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef xAODAnaHelpers_JetAttributeView_H
+#define xAODAnaHelpers_JetAttributeView_H
+
+// EDM include(s):
+#include "xAODJet/JetContainer.h"
+
+// C++ include(s)
+#include <vector>
+
+/*
+  JetAttributeView
+
+    The jet attributes used per jet in the selection and the ntuples, read
+    through accessors made once and by const reference:
+    jet->getAttribute< std::vector<float> >( "JVF" ) copies the whole vector
+    (one entry per vertex) and getAttribute< xAOD::JetFourMom_t >(
+    "JetConstitScaleMomentum" ) looks up and reads all four components, where
+    only the eta is wanted.
+
+    Whether the attributes are there is looked up once per container owning
+    the jets, on the first of its jets asked about, and again whenever a jet
+    of another one comes (a view can hold jets of several). A missing
+    attribute reads as getAttribute() would have returned it:
+    constituent-scale eta 0, an empty JVF vector (so jvfPV() throws
+    std::out_of_range as the .at() on the copy did).
+
+    Example Usage:
+      // per container
+      m_jetAttributes.setContainer( inJets, m_pvLocation );
+      // per jet
+      float detEta = m_jetAttributes.constitScaleEta( *jet );
+      if ( m_jetAttributes.jvfPV( *jet ) < m_JVFCut ) { ... }
+*/
+class JetAttributeView
+{
+  public:
+    JetAttributeView() :
+      m_constitEta("JetConstitScaleMomentum_eta"),
+      m_jvf("JVF"),
+      m_pvLocation(-1),
+      m_resolvedFor(nullptr),
+      m_hasConstitEta(false),
+      m_hasJVF(false)
+    { }
+
+    void setContainer( const xAOD::JetContainer* /*jets*/, int pvLocation )
+    {
+      m_pvLocation  = pvLocation;
+      m_resolvedFor = nullptr;
+    }
+
+    float constitScaleEta( const xAOD::Jet& jet ) const
+    {
+      this->resolve( jet );
+      return m_hasConstitEta ? m_constitEta( jet ) : 0.;
+    }
+
+    bool hasJVF( const xAOD::Jet& jet ) const
+    {
+      this->resolve( jet );
+      return m_hasJVF;
+    }
+
+    const std::vector<float>& jvf( const xAOD::Jet& jet ) const
+    {
+      static const std::vector<float> none;
+      return this->hasJVF( jet ) ? m_jvf( jet ) : none;
+    }
+
+    // the JVF w.r.t. the vertex given to setContainer()
+    float jvfPV( const xAOD::Jet& jet ) const
+    {
+      return this->jvf( jet ).at( m_pvLocation );
+    }
+
+  private:
+    // an aux variable is there for all the jets of its container or for none
+    void resolve( const xAOD::Jet& jet ) const
+    {
+      if ( jet.container() == m_resolvedFor ) { return; }
+      m_resolvedFor   = jet.container();
+      m_hasConstitEta = m_constitEta.isAvailable( jet );
+      m_hasJVF        = m_jvf.isAvailable( jet );
+    }
+
+    SG::AuxElement::ConstAccessor< float >              m_constitEta;
+    SG::AuxElement::ConstAccessor< std::vector<float> > m_jvf;
+
+    int  m_pvLocation;
+    mutable const SG::AuxVectorData* m_resolvedFor;
+    mutable bool m_hasConstitEta;
+    mutable bool m_hasJVF;
+};
+
+#endif
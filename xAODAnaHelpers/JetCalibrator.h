@@ -13,6 +13,8 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/SystematicIndex.h"
+#include "xAODAnaHelpers/TaskPool.h"
 
 class JetCalibrator : public xAH::Algorithm
 {
@@ -42,6 +44,7 @@ public:
 
 private:
   int m_numEvent;         //!
+  // jets written out, counted once per variation
   int m_numObject;        //!
 
   bool m_isMC;
@@ -53,11 +56,19 @@ private:
   std::string m_outSCAuxContainerName;  //!
 
   std::vector<CP::SystematicSet> m_systList; //!
+  // ids in SystematicIndex, in the order of m_systList
+  std::vector<unsigned int> m_systIds;       //!
+  SystematicKeys m_outSCKeys;                //!
+  SystematicKeys m_outSCAuxKeys;             //!
+  SystematicKeys m_outKeys;                  //!
 
   // tools
   JetCalibrationTool    * m_jetCalibration; //!
   JetCleaningTool       * m_jetCleaning;    //!
   JetUncertaintiesTool  * m_jetUncert;      //!
+  // one uncertainty tool per thread of m_systPool, the first is m_jetUncert
+  std::vector<JetUncertaintiesTool*> m_jetUncertTools; //!
+  TaskPool              * m_systPool;       //!
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
@@ -84,6 +95,9 @@ public:
   // these are the functions not inherited from Algorithm
   virtual EL::StatusCode configure ();
 
+  // a new JetUncertaintiesTool, configured and initialized
+  EL::StatusCode makeUncertTool ( JetUncertaintiesTool*& jetUncert, const std::string& name );
+
   // this is needed to distribute the algorithm to the workers
   ClassDef(JetCalibrator, 1);
 };
@@ -5,6 +5,7 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/SystematicIndex.h"
 
 class JetHistsAlgo : public xAH::Algorithm
 {
@@ -18,6 +19,9 @@ public:
 
 private:
   std::map< std::string, JetHists* > m_plots; //!
+  // the same, by systematic id
+  std::vector< JetHists* > m_systPlots; //!
+  SystematicKeys m_inKeys; //!
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
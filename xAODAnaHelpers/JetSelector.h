@@ -10,6 +10,11 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/AuxHandles.h"
+#include "xAODAnaHelpers/BatchPreselection.h"
+#include "xAODAnaHelpers/JetAttributeView.h"
+#include "xAODAnaHelpers/CutSequence.h"
+#include "xAODAnaHelpers/SystematicIndex.h"
 
 class JetSelector : public xAH::Algorithm
 {
@@ -22,7 +27,7 @@ public:
   std::string m_inContainerName;   //! input container name
   std::string m_outContainerName;  //! output container name
   std::string m_inputAlgo;         //! input type - from xAOD or from xAODAnaHelper Algo output
-  std::string m_outputAlgo;        //! output type - this is how the vector<string> w/ syst names will be saved in TStore
+  std::string m_outputAlgo;        //! output type - this is how the vector<unsigned int> w/ syst ids (see SystematicIndex) will be saved in TStore
   std::string m_decor;            //! The decoration key written to passing objects
   bool m_decorateSelectedObjects; //! decorate selected objects? defaul passSel
   bool m_createSelectedContainer; //! fill using SG::VIEW_ELEMENTS to be light weight
@@ -56,13 +61,22 @@ public:
   std::string              m_passAuxDecorKeys;  //!
   std::string              m_failAuxDecorKeys;  //!
 
+  bool m_adaptiveCutOrder;        //! reorder the cuts by measured cost and rejection
+  int  m_cutOrderWarmup;          //! number of jets to measure the cuts on
+  bool m_batchPreselection;       //! apply the pT, eta, detEta, mass, rapidity windows to all jets at once before the other cuts
+
 private:
   int m_numEvent;         //!
   int m_numObject;        //!
   int m_numEventPass;     //!
   int m_weightNumEventPass; //!
   int m_numObjectPass;    //!
+
+  // container names of each systematic
+  SystematicKeys m_inKeys;  //!
+  SystematicKeys m_outKeys; //!
   int m_pvLocation;       //!
+  JetAttributeView m_jetAttributes; //! JVF and constituent-scale eta of the jets of the current container
 
   bool m_isEMjet;                //!
   bool m_isLCjet;                //!
@@ -75,6 +89,17 @@ private:
   std::vector<std::string> m_passKeys;  //!
   std::vector<std::string> m_failKeys;  //!
 
+  // the passSel (m_decor) decoration, resolved in configure()
+  const SG::AuxElement::Decorator< char >* m_passSelDecor; //!
+
+  // the enabled cuts, in the order PassCuts() runs them
+  CutSequence<const xAOD::Jet*> m_cuts; //!
+
+  // the window cuts, if done on the whole container, and what each window is on
+  enum PreselectionQuantity { PRE_PT, PRE_ETA, PRE_DETETA, PRE_MASS, PRE_RAPIDITY };
+  BatchPreselection m_preselection; //!
+  std::vector<int>  m_preQuantity;  //!
+
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
@@ -106,6 +131,10 @@ public:
   // added functions not from Algorithm
   // why does this need to be virtual?
   virtual int PassCuts( const xAOD::Jet* jet );
+  // put the enabled cuts in m_cuts (and m_preselection)
+  void buildCuts();
+  // copy the quantities of the windows of the first nJet jets and evaluate them
+  void preselect( const xAOD::JetContainer* inJets, unsigned int nJet );
   // this is needed to distribute the algorithm to the workers
   ClassDef(JetSelector, 1);
 };
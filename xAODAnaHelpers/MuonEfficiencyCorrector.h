@@ -13,6 +13,7 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/TaskPool.h"
 
 class MuonEfficiencyCorrector : public xAH::Algorithm
 {
@@ -43,6 +44,9 @@ private:
 
   // tools
   CP::MuonEfficiencyScaleFactors  *m_MuonEffSFTool; //!
+  // one efficiency tool per thread of m_systPool, the first is m_MuonEffSFTool
+  std::vector<CP::MuonEfficiencyScaleFactors*> m_MuonEffSFTools; //!
+  TaskPool *m_systPool; //!
 
   // variables that don't get filled at submission time should be
   // protected from being send from the submission node to the worker
@@ -71,6 +75,9 @@ public:
   // these are the functions not inherited from Algorithm
   virtual EL::StatusCode configure ();
 
+  // a new MuonEfficiencyScaleFactors, configured and initialized
+  EL::StatusCode makeEffSFTool ( CP::MuonEfficiencyScaleFactors*& effSFTool, const std::string& name );
+
   // this is needed to distribute the algorithm to the workers
   ClassDef(MuonEfficiencyCorrector, 1);
 };
@@ -3,6 +3,7 @@
 
 // EDM include(s):
 #include "xAODMuon/MuonContainer.h"
+#include "xAODPrimitives/IsolationType.h"
 #include "xAODTracking/Vertex.h"
 
 // ROOT include(s):
@@ -13,6 +14,8 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/AuxHandles.h"
+#include "xAODAnaHelpers/CutSequence.h"
 
 class MuonSelector : public xAH::Algorithm
 {
@@ -43,6 +46,9 @@ public:
   std::string  m_TrackBasedIsoType;
   float    m_TrackBasedIsoCut;
 
+  bool     m_adaptiveCutOrder;        // reorder the cuts by measured cost and rejection
+  int      m_cutOrderWarmup;          // number of muons to measure the cuts on
+
   std::string              m_passAuxDecorKeys;  //!
   std::string              m_failAuxDecorKeys;  //!
 
@@ -54,6 +60,12 @@ private:
   int m_numObjectPass;    //!
   std::string  m_outAuxContainerName; // output auxiliary container name
 
+  // m_muonQuality, m_muonType and the isolation types, resolved in configure()
+  xAOD::Muon::Quality      m_muonQualityEnum;   //!
+  xAOD::Muon::MuonType     m_muonTypeEnum;      //!
+  xAOD::Iso::IsolationType m_trackBasedIsoEnum; //!
+  xAOD::Iso::IsolationType m_caloBasedIsoEnum;  //!
+
   // cutflow
   TH1D* m_cutflowHist;          //!
   TH1D* m_cutflowHistW;         //!
@@ -62,6 +74,12 @@ private:
   std::vector<std::string> m_passKeys;  //!
   std::vector<std::string> m_failKeys;  //!
 
+  // the passSel decoration, resolved in configure()
+  const SG::AuxElement::Decorator< char >* m_passSelDecor; //!
+
+  // the enabled cuts, in the order PassCuts() runs them
+  CutSequence<const xAOD::Muon*, const xAOD::Vertex*> m_cuts; //!
+
   // tools
   CP::MuonSelectionTool *m_muonSelectionTool;//!
 
@@ -94,8 +112,10 @@ public:
   // added functions not from Algorithm
   // why does this need to be virtual?
   virtual int PassCuts( const xAOD::Muon* muon, const xAOD::Vertex *primaryVertex );
+  // put the enabled cuts in m_cuts
+  void buildCuts();
   // this is needed to distribute the algorithm to the workers
-  ClassDef(MuonSelector, 1);
+  ClassDef(MuonSelector, 2);
 };
 
 #endif
@@ -15,6 +15,7 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/SystematicIndex.h"
 
 class OverlapRemover : public xAH::Algorithm
 {
@@ -29,18 +30,18 @@ public:
   /* Electrons */
   std::string  m_inContainerName_Electrons;
   std::string  m_outContainerName_Electrons;        // output container name
-  std::string  m_inputAlgoElectrons;                // name of vector<string> of syst retrieved from TStore
-  std::string  m_outputAlgoElectrons;               // name of vector<string> of syst pushed in TStore
+  std::string  m_inputAlgoElectrons;                // name of the list of systematics retrieved from TStore (see SystematicIndex)
+  std::string  m_outputAlgoElectrons;               // name of the list of systematics pushed in TStore (see SystematicIndex)
   /* Muons */
   std::string m_inContainerName_Muons;
   std::string  m_outContainerName_Muons;        // output container name
-  std::string  m_inputAlgoMuons;                // name of vector<string> of syst retrieved from TStore
-  std::string  m_outputAlgoMuons;               // name of vector<string> of syst pushed in TStore
+  std::string  m_inputAlgoMuons;                // name of the list of systematics retrieved from TStore (see SystematicIndex)
+  std::string  m_outputAlgoMuons;               // name of the list of systematics pushed in TStore (see SystematicIndex)
   /* Jets */
   std::string m_inContainerName_Jets;
   std::string  m_outContainerName_Jets;        // output container name
-  std::string  m_inputAlgoJets;                // name of vector<string> of syst retrieved from TStore
-  std::string  m_outputAlgoJets;               // name of vector<string> of syst pushed in TStore
+  std::string  m_inputAlgoJets;                // name of the list of systematics retrieved from TStore (see SystematicIndex)
+  std::string  m_outputAlgoJets;               // name of the list of systematics pushed in TStore (see SystematicIndex)
   /* Photons */
   std::string m_inContainerName_Photons;
   std::string  m_outContainerName_Photons;        // output container name
@@ -70,6 +71,17 @@ private:
   /* Taus */
   std::string  m_outAuxContainerName_Taus;     // output auxiliary container name
 
+  // container and decoration names of each systematic
+  SystematicKeys m_inKeys_Electrons;  //!
+  SystematicKeys m_inKeys_Muons;      //!
+  SystematicKeys m_inKeys_Jets;       //!
+  SystematicKeys m_outKeys_Electrons; //!
+  SystematicKeys m_outKeys_Muons;     //!
+  SystematicKeys m_outKeys_Jets;      //!
+  SystematicKeys m_outKeys_Photons;   //!
+  SystematicKeys m_outKeys_Taus;      //!
+  SystematicKeys m_ORdecorKeys;       //!
+
 
   // tools
   OverlapRemovalTool *m_overlapRemovalTool; //!
@@ -111,7 +123,7 @@ public:
 
   virtual EL::StatusCode executeOR( const xAOD::ElectronContainer* inElectrons, const xAOD::MuonContainer* inMuons, const xAOD::JetContainer* inJets,
 				    const xAOD::PhotonContainer* inPhotons,	const xAOD::TauJetContainer* inTaus,
-				    SystType syst_type = NOMINAL, std::vector<std::string>* sysVec = nullptr);
+				    SystType syst_type = NOMINAL, std::vector<unsigned int>* sysVec = nullptr);
 
   // this is needed to distribute the algorithm to the workers
   ClassDef(OverlapRemover, 1);
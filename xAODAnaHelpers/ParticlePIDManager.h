@@ -4,6 +4,8 @@
 // package include(s):
 #include "xAODAnaHelpers/HelperClasses.h"
 #include "xAODAnaHelpers/HelperFunctions.h"
+#include "xAODAnaHelpers/AuxHandles.h"
+#include "xAODAnaHelpers/ToolRegistry.h"
 
 #include <xAODAnaHelpers/tools/ReturnCheck.h>
 #include <xAODAnaHelpers/tools/ReturnCheckConfig.h>
@@ -19,77 +21,168 @@
 #include "xAODEgamma/Electron.h"
 
 // C++ include(s)
+#include <algorithm>
 #include <string>
+#include <vector>
+
+/*
+  PIDWorkingPoints
+
+    The working points of a PID manager, loosest first, each with the decoration
+    set to -1 on every electron and - for those set up - the tool and the
+    decoration of its decision. Everything is resolved once in setupTools(), the
+    per-electron loop only walks a flat array.
+
+    The WPs are nested (a Tight electron is Medium, Loose, ...), so with
+    short-circuit (the default) the tools are asked loosest first and, once one
+    fails, the tighter WPs are decorated 0 without calling theirs. Without it
+    every tool gives its own decision, as before.
+
+    The tools come from the ToolRegistry (shared w/ any other manager set up w/
+    the same configuration) and are released here.
+
+    Example Usage:
+      // constructor
+      m_allWPs.add( "Loose", LikeEnum::Loose, "LHLoose" );
+      // setupTools(), in the order of all()
+      m_allWPs.addTool( tool, tool->getOperatingPointName() );
+      // per electron
+      m_allWPs.setDefaults( electron );
+      if ( !m_allWPs.evaluate( electron, doCut ) ) { ... fails the first (selected) WP ... }
+*/
+template <typename T>
+class PIDWorkingPoints
+{
+   public:
+     struct WorkingPoint
+     {
+       std::string  name;
+       unsigned int tightness;
+       const SG::AuxElement::Decorator< char >* defaultDecor;
+     };
+
+     PIDWorkingPoints () : m_shortCircuit(true) { };
+     ~PIDWorkingPoints ()
+     {
+       for ( auto& link : m_chain ) { ToolRegistry::instance().release( link.tool ); }
+     };
+
+     /* a WP the manager knows of, kept in order of tightness */
+     void add( const std::string& name, unsigned int tightness, const std::string& defaultDecor ) {
+       WorkingPoint wp = { name, tightness, &AuxHandles<char>::decorator( defaultDecor ) };
+       m_WPs.insert( std::upper_bound( m_WPs.begin(), m_WPs.end(), wp,
+                                       []( const WorkingPoint& a, const WorkingPoint& b ) { return a.tightness < b.tightness; } ), wp );
+     };
+
+     const std::vector<WorkingPoint>& all() const { return m_WPs; }
+
+     /* an initialised tool to evaluate, from the loosest to the tightest; released by the destructor */
+     void addTool( T* tool, const std::string& decor ) {
+       Link link = { tool, &AuxHandles<char>::decorator( decor ), decor };
+       m_chain.push_back( link );
+     };
+
+     unsigned int tools() const { return m_chain.size(); }
+     const std::string& decorName( unsigned int i ) const { return m_chain.at( i ).decorName; }
+
+     void setShortCircuit( bool shortCircuit ) { m_shortCircuit = shortCircuit; }
+
+     void setDefaults( const xAOD::Electron* electron ) const {
+       for ( const auto& wp : m_WPs ) { (*wp.defaultDecor)( *electron ) = -1; }
+     };
+
+     /*
+     /
+     / Decorate the electron with the decision of each tool. The first one is the selected WP:
+     / if it fails and cut is set, return false leaving the decorations to their defaults.
+     /
+     */
+     bool evaluate( const xAOD::Electron* electron, bool cut ) const {
+       bool passLooser(true);
+       for ( unsigned int i = 0; i < m_chain.size(); ++i ) {
+         const Link& link = m_chain[i];
+         bool accept = ( passLooser || !m_shortCircuit ) && static_cast<bool>( link.tool->accept( *electron ) );
+         if ( i == 0 && cut && !accept ) { return false; }
+         (*link.decor)( *electron ) = static_cast<char>( accept );
+         passLooser = passLooser && accept;
+       }
+       return true;
+     };
+
+   private:
+     struct Link
+     {
+       T* tool;
+       const SG::AuxElement::Decorator< char >* decor;
+       std::string decorName;
+     };
+
+     bool m_shortCircuit;
+     std::vector<WorkingPoint> m_WPs;
+     std::vector<Link>         m_chain;
+
+     PIDWorkingPoints ( const PIDWorkingPoints& );
+     PIDWorkingPoints& operator= ( const PIDWorkingPoints& );
+};
+
+/* true if the WP is to be set up: the selected one, and the tighter ones to decorate (all if none given) */
+inline bool usePIDWorkingPoint( const std::string& WP, unsigned int tightness, const std::string& selectedWP, unsigned int selectedTightness,
+                                const std::vector<std::string>& decorWPs )
+{
+  if ( WP == selectedWP ) { return true; }
+  if ( tightness < selectedTightness ) { return false; }
+  return decorWPs.empty() || std::find( decorWPs.begin(), decorWPs.end(), WP ) != decorWPs.end();
+}
 
 class ElectronLHPIDManager
 {
    public: 
      ElectronLHPIDManager ();
-     ElectronLHPIDManager (std::string WP) :
-        m_asgElectronLikelihoodTool_VeryLoose(nullptr),
-	m_asgElectronLikelihoodTool_Loose(nullptr),    
-	m_asgElectronLikelihoodTool_Medium(nullptr),   
-	m_asgElectronLikelihoodTool_Tight(nullptr),    
-	m_asgElectronLikelihoodTool_VeryTight(nullptr)
+     ElectronLHPIDManager (std::string WP)
      {
 	m_selectedWP = WP;
         
-        /*  fill the multimap with WPs and corresponding tools */
-	std::pair < std::string, AsgElectronLikelihoodTool* > veryloose = std::make_pair( std::string("VeryLoose"), m_asgElectronLikelihoodTool_VeryLoose );
-        m_allWPs.insert(veryloose);
-	std::pair < std::string, AsgElectronLikelihoodTool* > loose = std::make_pair( std::string("Loose"), m_asgElectronLikelihoodTool_Loose );
-        m_allWPs.insert(loose);
-	std::pair < std::string, AsgElectronLikelihoodTool* > medium = std::make_pair( std::string("Medium"), m_asgElectronLikelihoodTool_Medium );
-        m_allWPs.insert(medium);
-	std::pair < std::string, AsgElectronLikelihoodTool* > tight = std::make_pair( std::string("Tight"), m_asgElectronLikelihoodTool_Tight );
-        m_allWPs.insert(tight);
-	std::pair < std::string, AsgElectronLikelihoodTool* > verytight = std::make_pair( std::string("VeryTight"), m_asgElectronLikelihoodTool_VeryTight );
-        m_allWPs.insert(verytight);
+        /*  all the WPs, ordered by the corresponding LikeEnum, with their default decorations */
+        const char* WPs[] = { "VeryLoose", "Loose", "Medium", "Tight", "VeryTight" };
+        for ( const std::string name : WPs ) {
+          m_allWPs.add( name, static_cast<unsigned int>( HelperClasses::EnumParser<LikeEnum::Menu>::parseEnum(name) ), "LH" + name );
+        }
      };
      
-     ~ElectronLHPIDManager()
-     {
-     	if ( m_asgElectronLikelihoodTool_VeryLoose ) { delete m_asgElectronLikelihoodTool_VeryLoose; m_asgElectronLikelihoodTool_VeryLoose = nullptr; }
-     	if ( m_asgElectronLikelihoodTool_Loose )     { delete m_asgElectronLikelihoodTool_Loose; m_asgElectronLikelihoodTool_Loose = nullptr; }
-     	if ( m_asgElectronLikelihoodTool_Medium )    { delete m_asgElectronLikelihoodTool_Medium; m_asgElectronLikelihoodTool_Medium = nullptr; }
-     	if ( m_asgElectronLikelihoodTool_Tight )     { delete m_asgElectronLikelihoodTool_Tight; m_asgElectronLikelihoodTool_Tight = nullptr; }
-     	if ( m_asgElectronLikelihoodTool_VeryTight ) { delete m_asgElectronLikelihoodTool_VeryTight; m_asgElectronLikelihoodTool_VeryTight = nullptr; }       
-     };
+     ~ElectronLHPIDManager() { };
      
      
-     StatusCode setupTools( std::string confDir, std::string year ) {
+     StatusCode setupTools( std::string confDir, std::string year, const std::vector<std::string>& decorWPs = std::vector<std::string>() ) {
      
-        HelperClasses::EnumParser<LikeEnum::Menu> selectedWP_parser;
-        unsigned int selectedWP_enum = static_cast<unsigned int>( selectedWP_parser.parseEnum(m_selectedWP) );
+        unsigned int selectedWP_enum = static_cast<unsigned int>( HelperClasses::EnumParser<LikeEnum::Menu>::parseEnum(m_selectedWP) );
        
         /*  
 	/
 	/ By converting the string to the corresponding LikeEnum, we can exploit the ordering of the enum itself 
 	/ ( see ElectronPhotonID/ElectronPhotonSelectorTools/trunk/ElectronPhotonSelectorTools/TElectronLikelihoodTool.h for definition)
-	/ to initialise ONLY the tools with WP tighter (or equal) the selected one.
+	/ to initialise ONLY the tools with WP tighter (or equal) the selected one - and of those only the ones in decorWPs, if given.
 	/ The selected WP will be used to cut loose electrons in the selector, the tighter WPs to decorate! 
 	/
 	*/       
-	for ( auto it : (m_allWPs) ) {
+	for ( const auto& wp : m_allWPs.all() ) {
 
-	    /* instantiate tools (do it for all) */
-            it.second =  new AsgElectronLikelihoodTool( (it.first).c_str() );
-            
-            HelperClasses::EnumParser<LikeEnum::Menu>  itWP_parser;
-            unsigned int itWP_enum = static_cast<unsigned int>( itWP_parser.parseEnum(it.first) );
-            
-            /* if this WP is looser than user's WP, skip to next */
-            if ( itWP_enum < selectedWP_enum ) { continue; }
+            if ( !usePIDWorkingPoint( wp.name, wp.tightness, m_selectedWP, selectedWP_enum, decorWPs ) ) { continue; }
         
-            /* configure and initialise only tools with (WP >= selectedWP) */
-            it.second->msg().setLevel( MSG::INFO); /* ERROR, VERBOSE, DEBUG, INFO */
-	    RETURN_CHECK( "ParticlePIDManager::setupTools()", it.second->setProperty("primaryVertexContainer", "PrimaryVertices"), "Failed to set primaryVertexContainer property");
-	    std::string config_string = confDir + "ElectronLikelihood" + it.first + "OfflineConfig" + year + ".conf";
-            RETURN_CHECK( "ParticlePIDManager::setupTools()", it.second->setProperty("ConfigFile", config_string ), "Failed to set ConfigFile property");
-	    RETURN_CHECK( "ParticlePIDManager::setupTools()", it.second->initialize(), "Failed to initialize tool." );
+	    std::string config_string = confDir + "ElectronLikelihood" + wp.name + "OfflineConfig" + year + ".conf";
+
+            /* the same tool for every manager w/ this config file */
+            AsgElectronLikelihoodTool* tool(nullptr);
+            RETURN_CHECK( "ParticlePIDManager::setupTools()", ToolRegistry::instance().share( tool, config_string, [&]( AsgElectronLikelihoodTool*& newTool ) -> EL::StatusCode {
+              newTool = new AsgElectronLikelihoodTool( wp.name.c_str() );
+              newTool->msg().setLevel( MSG::INFO); /* ERROR, VERBOSE, DEBUG, INFO */
+	      RETURN_CHECK( "ParticlePIDManager::setupTools()", newTool->setProperty("primaryVertexContainer", "PrimaryVertices"), "Failed to set primaryVertexContainer property");
+              RETURN_CHECK( "ParticlePIDManager::setupTools()", newTool->setProperty("ConfigFile", config_string ), "Failed to set ConfigFile property");
+	      RETURN_CHECK( "ParticlePIDManager::setupTools()", newTool->initialize(), "Failed to initialize tool." );
+              return EL::StatusCode::SUCCESS;
+            }), "Failed to set up tool." );
             
-	    /* copy map element into container of valid tools for later usage */
-	    m_validWPs.insert( it );
+	    /* append to the tools to evaluate, loosest first */
+	    m_allWPs.addTool( tool, tool->getOperatingPointName() );
 	    
         }
 	
@@ -100,34 +193,26 @@ class ElectronLHPIDManager
      /* set default values for decorations (do it for all WPs) */
      StatusCode setDecorations( const xAOD::Electron* electron ) {
        
-       for ( auto it : (m_allWPs) ) { 
-         const std::string defaultDecorWP =  "LH" + it.first;  
-         electron->auxdecor<char>(defaultDecorWP) = -1;
-       }
+       m_allWPs.setDefaults( electron );
 
        return StatusCode::SUCCESS;
      }  
      
+     /* cut on the selected WP (if cut), and decorate w/ the decision of each WP set up */
+     bool evaluate( const xAOD::Electron* electron, bool cut ) const { return m_allWPs.evaluate( electron, cut ); }
+
+     /* tighter WPs decorated 0 w/o calling their tool once a looser one fails (default) */
+     void setShortCircuit( bool shortCircuit ) { m_allWPs.setShortCircuit( shortCircuit ); }
+
      const std::string getSelectedWP ( ) { return m_selectedWP; }  
 	
-     /* returns a map containing all the tools  */
-     std::multimap< std::string, AsgElectronLikelihoodTool* > getTools() { return m_allWPs; };
-     
-     /* returns a map containing only the tools w/ (WP >= selected WP) */
-     std::multimap< std::string, AsgElectronLikelihoodTool* > getValidTools() { return m_validWPs; };
+     /* all the WPs, and the tools w/ (WP >= selected WP) */
+     const PIDWorkingPoints< AsgElectronLikelihoodTool >& getWorkingPoints() const { return m_allWPs; };
      
    private:   
      
      std::string m_selectedWP;
-     std::multimap<std::string, AsgElectronLikelihoodTool*> m_allWPs;
-     std::multimap<std::string, AsgElectronLikelihoodTool*> m_validWPs;
-     
-
-     AsgElectronLikelihoodTool*  m_asgElectronLikelihoodTool_VeryLoose;  
-     AsgElectronLikelihoodTool*  m_asgElectronLikelihoodTool_Loose;	 
-     AsgElectronLikelihoodTool*  m_asgElectronLikelihoodTool_Medium;	 
-     AsgElectronLikelihoodTool*  m_asgElectronLikelihoodTool_Tight;	 
-     AsgElectronLikelihoodTool*  m_asgElectronLikelihoodTool_VeryTight;  
+     PIDWorkingPoints< AsgElectronLikelihoodTool > m_allWPs;
 
 };
 
@@ -135,81 +220,70 @@ class ElectronCutBasedPIDManager
 {
    public: 
      ElectronCutBasedPIDManager ();
-     ElectronCutBasedPIDManager (std::string WP) :
-	m_asgElectronIsEMSelector_Loose(nullptr),    
-	m_asgElectronIsEMSelector_Medium(nullptr),   
-	m_asgElectronIsEMSelector_Tight(nullptr)    
+     ElectronCutBasedPIDManager (std::string WP)
      {
 	m_selectedWP = WP;
 	
-        /*  fill the multimap with WPs and corresponding tools. Use an ordered index to reflect the tightness order (0: loosest WP, ...) */
-	std::pair < std::string, AsgElectronIsEMSelector* > loose = std::make_pair( std::string("IsEMLoose"), m_asgElectronIsEMSelector_Loose );
-        m_allWPs.insert( loose );
-	std::pair < std::string, AsgElectronIsEMSelector* > medium = std::make_pair( std::string("IsEMMedium"), m_asgElectronIsEMSelector_Medium );
-        m_allWPs.insert( medium );
-	std::pair < std::string, AsgElectronIsEMSelector* > tight = std::make_pair( std::string("IsEMTight"), m_asgElectronIsEMSelector_Tight );
-        m_allWPs.insert( tight );
+        /*  all the WPs, ordered by the corresponding egammaPID (0: loosest WP, ...), with their default decorations ("IsEM" stripped) */
+        const char* WPs[] = { "IsEMLoose", "IsEMMedium", "IsEMTight" };
+        for ( const std::string name : WPs ) {
+          m_allWPs.add( name, static_cast<unsigned int>( HelperClasses::EnumParser<egammaPID::PID>::parseEnum(name) ), name.substr(4) );
+        }
      };
      
-     ~ElectronCutBasedPIDManager()
-     {
-     	if ( m_asgElectronIsEMSelector_Loose )     { delete m_asgElectronIsEMSelector_Loose; m_asgElectronIsEMSelector_Loose = nullptr; }
-     	if ( m_asgElectronIsEMSelector_Medium )    { delete m_asgElectronIsEMSelector_Medium; m_asgElectronIsEMSelector_Medium = nullptr; }
-     	if ( m_asgElectronIsEMSelector_Tight )     { delete m_asgElectronIsEMSelector_Tight; m_asgElectronIsEMSelector_Tight = nullptr; }
-     };
+     ~ElectronCutBasedPIDManager() { };
      
      
-     StatusCode setupTools( std::string confDir, std::string year ) {
+     StatusCode setupTools( std::string confDir, std::string year, const std::vector<std::string>& decorWPs = std::vector<std::string>() ) {
      
-        HelperClasses::EnumParser<egammaPID::PID> selectedWP_parser;
-        unsigned int selectedWP_enum = static_cast<unsigned int>( selectedWP_parser.parseEnum(m_selectedWP) );
+        unsigned int selectedWP_enum = static_cast<unsigned int>( HelperClasses::EnumParser<egammaPID::PID>::parseEnum(m_selectedWP) );
        
         /*  
 	/
 	/ By converting the string to the corresponding egammaPID, we can exploit the ordering of the enum itself 
 	/ ( see ElectronPhotonID/ElectronPhotonSelectorTools/trunk/ElectronPhotonSelectorTools/TElectronIsEMSelector.h for definition)
-	/ to initialise ONLY the tools with WP tighter (or equal) the selected one.
+	/ to initialise ONLY the tools with WP tighter (or equal) the selected one - and of those only the ones in decorWPs, if given.
 	/ The selected WP will be used to cut loose electrons in the selector, the tighter WPs to decorate! 
 	/
 	/ egammaPID enums :http://acode-browser.usatlas.bnl.gov/lxr/source/atlas/Reconstruction/egamma/egammaEvent/egammaEvent/egammaPIDdefs.h
 	/
 	*/       
 	
-	for ( auto it : (m_allWPs) ) {
+	for ( const auto& wp : m_allWPs.all() ) {
 
-	    /* instantiate tools (do it for all) */
-            it.second =  new AsgElectronIsEMSelector( (it.first).c_str() );
-           
-            HelperClasses::EnumParser<egammaPID::PID>  itWP_parser;
-            unsigned int itWP_enum = static_cast<unsigned int>( itWP_parser.parseEnum(it.first) );
-            
-            /* if this WP is looser than user's WP, skip to next */
-            if ( itWP_enum < selectedWP_enum ) { continue; }
+            if ( !usePIDWorkingPoint( wp.name, wp.tightness, m_selectedWP, selectedWP_enum, decorWPs ) ) { continue; }
 
-            /* configure and initialise only tools with (WP >= selectedWP) */
-
-            it.second->msg().setLevel( MSG::INFO); /* ERROR, VERBOSE, DEBUG, INFO */	    
-	    std::string config_string = confDir + "Electron" + it.first + "SelectorCutDefs" + year + ".conf";
-            RETURN_CHECK( "ParticlePIDManager::setupTools()", it.second->setProperty("ConfigFile", config_string ), "Failed to set ConfigFile property");
+	    std::string config_string = confDir + "Electron" + wp.name + "SelectorCutDefs" + year + ".conf";
     	    /* set the bitmask only for samples with 2012 config */
+    	    unsigned int EMMask = 999;
     	    if ( year == "2012" )  {
-    	      unsigned int EMMask = 999;
-    	      if ( (it.first).find("IsEMLoose") != std::string::npos ) {
+    	      if ( wp.name.find("IsEMLoose") != std::string::npos ) {
     		EMMask = egammaPID::ElectronLoosePP;
-    	      } else if ( (it.first).find("IsEMMedium") != std::string::npos ) {
+    	      } else if ( wp.name.find("IsEMMedium") != std::string::npos ) {
     		EMMask = egammaPID::ElectronMediumPP;
-    	      } else if ( (it.first).find("IsEMTight") != std::string::npos ) {
+    	      } else if ( wp.name.find("IsEMTight") != std::string::npos ) {
     		EMMask = egammaPID::ElectronTightPP;
     	      } else {
     		Error("initialize()", "Unavailable electron cut-based PID bitmask for this operating point!");
     		return EL::StatusCode::FAILURE;
     	      }
-    	      RETURN_CHECK( "ParticlePIDManager::setupTools()", it.second->setProperty("isEMMask", EMMask ), "Failed to set isEMMask property");
     	    }
-            RETURN_CHECK( "ParticlePIDManager::setupTools()", it.second->initialize(), "Failed to initialize tool." );
+
+            /* the same tool for every manager w/ this config file (and bitmask) */
+            AsgElectronIsEMSelector* tool(nullptr);
+            RETURN_CHECK( "ParticlePIDManager::setupTools()", ToolRegistry::instance().share( tool, config_string + " isEMMask " + std::to_string(EMMask), [&]( AsgElectronIsEMSelector*& newTool ) -> EL::StatusCode {
+              newTool = new AsgElectronIsEMSelector( wp.name.c_str() );
+              newTool->msg().setLevel( MSG::INFO); /* ERROR, VERBOSE, DEBUG, INFO */	    
+              RETURN_CHECK( "ParticlePIDManager::setupTools()", newTool->setProperty("ConfigFile", config_string ), "Failed to set ConfigFile property");
+    	      if ( year == "2012" )  {
+    	        RETURN_CHECK( "ParticlePIDManager::setupTools()", newTool->setProperty("isEMMask", EMMask ), "Failed to set isEMMask property");
+    	      }
+              RETURN_CHECK( "ParticlePIDManager::setupTools()", newTool->initialize(), "Failed to initialize tool." );
+              return EL::StatusCode::SUCCESS;
+            }), "Failed to set up tool." );
             
-	    /* copy map element into container of valid tools for later usage */
-	    m_validWPs.insert( it );
+	    /* append to the tools to evaluate, loosest first */
+	    m_allWPs.addTool( tool, tool->getOperatingPointName() );
 	    
         }
 	
@@ -220,37 +294,28 @@ class ElectronCutBasedPIDManager
      /* set default values for decorations (do it for all WPs) */
      StatusCode setDecorations( const xAOD::Electron* electron ) {
        
-       for ( auto it : (m_allWPs) ) { 
-         std::string defaultDecorWP = it.first;  
-	 defaultDecorWP.erase(0,4);
-         electron->auxdecor<char>(defaultDecorWP) = -1;
-       }
+       m_allWPs.setDefaults( electron );
        
        return StatusCode::SUCCESS;
 	
      }
 
+     /* cut on the selected WP (if cut), and decorate w/ the decision of each WP set up */
+     bool evaluate( const xAOD::Electron* electron, bool cut ) const { return m_allWPs.evaluate( electron, cut ); }
+
+     /* tighter WPs decorated 0 w/o calling their tool once a looser one fails (default) */
+     void setShortCircuit( bool shortCircuit ) { m_allWPs.setShortCircuit( shortCircuit ); }
+
      const std::string getSelectedWP ( ) { return m_selectedWP; }  
      
-     /* returns a map containing all the tools */
-     std::multimap< std::string, AsgElectronIsEMSelector* > getTools() { return m_allWPs; };
-    
-     /* returns a map containing only the tools w/ (WP >= selected WP) */
-     std::multimap< std::string, AsgElectronIsEMSelector* > getValidTools() { return m_validWPs; };
+     /* all the WPs, and the tools w/ (WP >= selected WP) */
+     const PIDWorkingPoints< AsgElectronIsEMSelector >& getWorkingPoints() const { return m_allWPs; };
      
    private:   
      
      std::string m_selectedWP;
-     
-     std::multimap<std::string, AsgElectronIsEMSelector*> m_allWPs;
-     std::multimap<std::string, AsgElectronIsEMSelector*> m_validWPs;
-
-     AsgElectronIsEMSelector*  m_asgElectronIsEMSelector_Loose;	 
-     AsgElectronIsEMSelector*  m_asgElectronIsEMSelector_Medium;	 
-     AsgElectronIsEMSelector*  m_asgElectronIsEMSelector_Tight;	 
+     PIDWorkingPoints< AsgElectronIsEMSelector > m_allWPs;
 
 };
 
 #endif
-
-
@@ -0,0 +1,125 @@
+#ifndef xAODAnaHelpers_SystematicIndex_H
+#define xAODAnaHelpers_SystematicIndex_H
+
+// Infrastructure include(s):
+#include "AsgTools/StatusCode.h"
+
+// C++ include(s)
+#include <map>
+#include <string>
+#include <vector>
+
+namespace xAOD {
+  class TStore;
+}
+
+/*
+  SystematicIndex
+
+    Job-wide numbering of the systematic variations. The algorithms that make
+    variations (calibrators) register their names in initialize(), and from
+    then on the lists passed on through TStore (OutputAlgo -> InputAlgo) are
+    std::vector<unsigned int> of these ids instead of lists of names. They
+    are recorded under idsKey( OutputAlgo ); OutputAlgo itself still holds
+    the std::vector<std::string> of the names, as it did before the ids, for
+    the algorithms outside the package reading it.
+
+    The nominal is always id 0, with an empty name.
+
+    Each of these lists is also declared in initialize(), under its TStore name,
+    with every id it can hold: all those of a calibrator, those of its input
+    list for an algorithm passing some of them on (selectors, overlap removal).
+    An algorithm further down (TreeAlgo) can then set up what it needs for each
+    systematic before the first event.
+
+    Example Usage:
+      // initialize()
+      for ( const auto& syst_it : m_systList ) { m_systIds.push_back( SystematicIndex::instance().id( syst_it.name() ) ); }
+      SystematicIndex::instance().declareList( m_outputAlgo, m_systIds );
+      // initialize() of an algorithm passing them on
+      SystematicIndex::instance().forwardList( m_inputAlgo, m_outputAlgo );
+      // initialize() of an algorithm reading them (nullptr: nobody declared it)
+      const std::vector<unsigned int>* systIds = SystematicIndex::instance().list( m_inputAlgo );
+      // execute()
+      RETURN_CHECK( ..., SystematicIndex::instance().recordList( new std::vector<unsigned int>( m_systIds ), m_outputAlgo, m_store ), "");
+      // execute() of an algorithm reading them
+      RETURN_CHECK( ..., HelperFunctions::retrieve( systIds, SystematicIndex::idsKey( m_inputAlgo ), 0, m_store, m_debug ), "");
+      // anywhere
+      std::string systName = SystematicIndex::instance().name( systId );
+*/
+class SystematicIndex
+{
+  public:
+    static SystematicIndex& instance();
+
+    // the id of a systematic, a new one the first time the name is seen
+    unsigned int id( const std::string& systName );
+
+    const std::string& name( unsigned int id ) const { return m_names.at( id ); }
+    unsigned int size() const { return m_names.size(); }
+
+    // the ids the TStore list listName can hold
+    void declareList( const std::string& listName, const std::vector<unsigned int>& ids );
+    // outListName holds some of the ids of inListName (nothing if that is not declared)
+    void forwardList( const std::string& inListName, const std::string& outListName );
+    const std::vector<unsigned int>* list( const std::string& listName ) const;
+
+    // the TStore key of the ids of the list listName
+    static std::string idsKey( const std::string& listName ) { return listName + "_ids"; }
+    // records ids under idsKey( listName ) and their names under listName, TStore owns both
+    StatusCode recordList( std::vector<unsigned int>* ids, const std::string& listName, xAOD::TStore* store ) const;
+
+  private:
+    SystematicIndex();
+
+    std::vector<std::string>            m_names;
+    std::map<std::string, unsigned int> m_ids;
+    std::map< std::string, std::vector<unsigned int> > m_lists;
+};
+
+/*
+  SystematicKeys
+
+    The names that go with each systematic, e.g. the TStore key of the
+    container of one variation, put together once per systematic and not
+    on every event.
+
+    Example Usage:
+      // configure()
+      m_inKeys = SystematicKeys( m_inContainerName );
+      m_decorKeys = SystematicKeys( "", "_overlaps" );
+      // execute()
+      for ( auto systId : *systIds ) {
+        RETURN_CHECK( ..., HelperFunctions::retrieve( inJets, m_inKeys[systId], m_event, m_store, m_debug ), "");
+      }
+*/
+class SystematicKeys
+{
+  public:
+    SystematicKeys( const std::string& prefix = "", const std::string& suffix = "" ) :
+      m_prefix(prefix),
+      m_suffix(suffix)
+    { }
+
+    // prefix + name of the systematic + suffix
+    const std::string& operator[]( unsigned int id )
+    {
+      if ( id >= m_keys.size() ) {
+        m_keys.resize( id + 1 );
+        m_built.resize( id + 1, false );
+      }
+      if ( !m_built[id] ) {
+        m_keys[id]  = m_prefix + SystematicIndex::instance().name( id ) + m_suffix;
+        m_built[id] = true;
+      }
+      return m_keys[id];
+    }
+
+  private:
+    std::string m_prefix;
+    std::string m_suffix;
+    std::vector<std::string> m_keys;
+    std::vector<bool>        m_built;
+};
+
+#endif
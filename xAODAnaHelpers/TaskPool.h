@@ -0,0 +1,81 @@
+#ifndef xAODAnaHelpers_TaskPool_H
+#define xAODAnaHelpers_TaskPool_H
+
+// C++ include(s)
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+  TaskPool
+
+    A fixed set of worker threads to spread independent tasks over, e.g. the
+    systematic variations of one event. run() hands out the tasks 0 .. n-1 to
+    the workers and returns once all of them are done; the calling thread is
+    worker 0 and works along. Each call of the task is told which worker runs
+    it, so that it can use the tools of that worker only (one instance of a
+    CP tool per worker, as applySystematicVariation changes the instance).
+
+    The order in which the tasks run is not fixed: anything that has to come
+    out in order (recording to TStore, filling decoration vectors) is done by
+    the caller after run() returns.
+
+    TEvent and TStore are not thread safe. The tasks must not retrieve or record
+    anything, nor read an aux variable or follow an ElementLink the first time on
+    the entry: the caller reads what it can beforehand (HelperFunctions::preloadEvent,
+    HelperFunctions::preloadAux) and records after run() returns. A CP tool called
+    by a task may still retrieve through its own evtStore(), nothing here prevents
+    that, so the systematic threads (Algorithm::m_systThreads) are experimental.
+
+    The CP tools print through ROOT and use its histograms: with more than one
+    worker, ROOT has to be made thread safe before the job does any I/O, by
+    xAH::Algorithm::enableThreadSafety() in histInitialize() of the algorithm.
+
+    With one worker no thread is started and the tasks run in order in the
+    calling thread.
+
+    Example Usage:
+      m_pool = new TaskPool( m_tools.size() );
+      // per event
+      bool ok = m_pool->run( m_systList.size(), [&]( unsigned int worker, unsigned int iSyst ) {
+        return m_tools.at( worker )->applySystematicVariation( m_systList.at( iSyst ) ) == CP::SystematicCode::Ok;
+      });
+      // at the end
+      delete m_pool;
+*/
+class TaskPool
+{
+  public:
+    typedef std::function<bool(unsigned int, unsigned int)> Task;
+
+    TaskPool( unsigned int nWorkers );
+    ~TaskPool();
+
+    unsigned int workers() const { return m_nWorkers; }
+
+    // calls task( worker, i ) for i = 0 .. nTasks-1, false if any of the calls did
+    bool run( unsigned int nTasks, const Task& task );
+
+  private:
+    void work( unsigned int worker );
+    void drain( unsigned int worker );
+
+    unsigned int m_nWorkers;
+    std::vector<std::thread> m_threads;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_cond;
+    const Task*   m_task;
+    unsigned int  m_nTasks;
+    unsigned long m_batch;  // counts the calls of run(), tells the workers there is a new one
+    unsigned int  m_busy;   // workers still on the current batch
+    bool          m_stop;
+
+    std::atomic<unsigned int> m_next;
+    std::atomic<bool>         m_ok;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef xAODAnaHelpers_ToolRegistry_H
+#define xAODAnaHelpers_ToolRegistry_H
+
+// EL include(s):
+#include <EventLoop/StatusCode.h>
+
+// C++ include(s)
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+
+/*
+  ToolRegistry
+
+    Job-wide (per worker process) instances of the tools that several algorithms
+    set up the same way: the TrigDecisionTool of BasicEventSelection and TreeAlgo,
+    the electron PID tools of every ElectronSelector, ... An instance is keyed by
+    the tool type and a string with everything that configures it (config file,
+    properties). The first algorithm asking for it makes and initialises it, the
+    others get the same instance, so the calibration files are read once and held
+    in memory once.
+
+    The registry counts the users of each instance and deletes it when the last
+    one releases it. Only share tools whose state does not change with the user:
+    tools that get applySystematicVariation() (the calibrators, the efficiency
+    correctors, one per syst thread) must stay private to their algorithm.
+
+    Example Usage:
+      // initialize()
+      RETURN_CHECK("initialize()", ToolRegistry::instance().share( m_grl, "GRL " + m_GRLxml, [&]( GoodRunsListSelectionTool*& grl ) {
+        grl = new GoodRunsListSelectionTool( "GoodRunsListSelectionTool" );
+        RETURN_CHECK("initialize()", grl->setProperty( "GoodRunsListVec", vecStringGRL ), "");
+        return grl->initialize();
+      }), "");
+      // finalize()
+      ToolRegistry::instance().release( m_grl );
+*/
+class ToolRegistry
+{
+  public:
+    static ToolRegistry& instance();
+
+    /*
+      Set tool to the instance of T configured as config, calling make( tool ) to create and
+      initialise it if there is none yet. If make fails, whatever it left in tool is deleted.
+    */
+    template <typename T, typename Make>
+    EL::StatusCode share( T*& tool, const std::string& config, Make make )
+    {
+      std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
+      const std::string key = std::string( typeid(T).name() ) + "/" + config;
+      auto it = m_tools.find( key );
+      if ( it != m_tools.end() ) {
+        ++it->second.users;
+        tool = static_cast<T*>( it->second.tool );
+        return EL::StatusCode::SUCCESS;
+      }
+
+      tool = nullptr;
+      EL::StatusCode status = make( tool );
+      if ( !status.isSuccess() || !tool ) {
+        delete tool; tool = nullptr;
+        return EL::StatusCode::FAILURE;
+      }
+
+      Entry entry;
+      entry.tool    = tool;
+      entry.users   = 1;
+      T* owned      = tool;
+      entry.destroy = [owned]() { delete owned; };
+      m_tools.insert( std::make_pair( key, entry ) );
+
+      return EL::StatusCode::SUCCESS;
+    }
+
+    // one user less, the last one deletes the tool; tool is set to nullptr either way
+    template <typename T>
+    void release( T*& tool )
+    {
+      this->releaseTool( tool );
+      tool = nullptr;
+    }
+
+    // number of algorithms using this instance (0: not from the registry)
+    unsigned int users( const void* tool ) const;
+
+  private:
+    struct Entry
+    {
+      void*                 tool;
+      unsigned int          users;
+      std::function<void()> destroy;
+    };
+
+    ToolRegistry() { }
+    ToolRegistry( const ToolRegistry& );
+    ToolRegistry& operator=( const ToolRegistry& );
+
+    void releaseTool( const void* tool );
+
+    mutable std::recursive_mutex  m_mutex;
+    std::map<std::string, Entry>  m_tools;
+};
+
+#endif
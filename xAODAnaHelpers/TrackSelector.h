@@ -9,6 +9,9 @@
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
+#include "xAODAnaHelpers/AuxHandles.h"
+#include "xAODAnaHelpers/BatchPreselection.h"
+#include "xAODAnaHelpers/CutSequence.h"
 
 class TrackSelector : public xAH::Algorithm
 {
@@ -53,6 +56,20 @@ private:
   float m_nPixHoles_max;          // require nPixHoles < nPixHoles_max
   float m_chi2NdofCut_max;        // require chi2/ndof < chi2NdofCut_max
   float m_chi2Prob_max;           // require TMath::Prob(chi2,ndof) < chi2ProbMax
+  bool  m_adaptiveCutOrder;       // reorder the cuts by measured cost and rejection
+  int   m_cutOrderWarmup;         // number of tracks to measure the cuts on
+  bool  m_batchPreselection;      // apply the pT, eta, d0, z0 windows to all tracks at once before the other cuts
+
+  // the passSel decoration, resolved in configure()
+  const SG::AuxElement::Decorator< char >* m_passSelDecor; //!
+
+  // the enabled cuts, in the order PassCuts() runs them
+  CutSequence<const xAOD::TrackParticle*, const xAOD::Vertex*> m_cuts; //!
+
+  // the window cuts, if done on the whole container, and what each window is on
+  enum PreselectionQuantity { PRE_PT, PRE_ETA, PRE_D0, PRE_Z0, PRE_Z0SINT };
+  BatchPreselection m_preselection; //!
+  std::vector<int>  m_preQuantity;  //!
 
 
   // variables that don't get filled at submission time should be
@@ -84,9 +101,13 @@ public:
   // added functions not from Algorithm
   // why does this need to be virtual?
   virtual int PassCuts( const xAOD::TrackParticle* jet, const xAOD::Vertex *pvx );
+  // put the enabled cuts in m_cuts (and m_preselection)
+  void buildCuts();
+  // copy the quantities of the windows of the first nTrk tracks and evaluate them
+  void preselect( const xAOD::TrackParticleContainer* inTracks, const xAOD::Vertex *pvx, unsigned int nTrk );
 
   // this is needed to distribute the algorithm to the workers
-  ClassDef(TrackSelector, 1);
+  ClassDef(TrackSelector, 2);
 };
 
 #endif
@@ -3,7 +3,10 @@
 
 #include "TTree.h"
 
+#include <map>
+
 #include <xAODAnaHelpers/HelpTreeBase.h>
+#include <xAODAnaHelpers/SystematicIndex.h>
 
 // algorithm wrapper
 #include "xAODAnaHelpers/Algorithm.h"
@@ -16,40 +19,81 @@ namespace Trig {
   class TrigDecisionTool;
 }
 
+class TrigDecisionCache;
+
 class TreeAlgo : public xAH::Algorithm
 {
   // put your configuration variables here as public variables.
   // that way they can be set directly from CINT and python.
 public:
   // choose whether the tree gets saved in the same directory as output histograms
-  bool m_outHistDir;                   //!
+  bool m_outHistDir;
 
   // holds bools that control which branches are filled
-  std::string m_evtDetailStr;	       //!
-  std::string m_trigDetailStr;	       //!
-  std::string m_jetTrigDetailStr;	   //!
-  std::string m_muDetailStr;	       //!
-  std::string m_elDetailStr;	       //!
-  std::string m_jetDetailStr;	       //!
-  std::string m_fatJetDetailStr;       //!
-  std::string m_tauDetailStr;          //!
-
-  std::string m_evtContainerName;      //!
-  std::string m_muContainerName;       //!
-  std::string m_elContainerName;       //!
-  std::string m_jetContainerName;      //!
-  std::string m_fatJetContainerName;   //!
-  std::string m_tauContainerName;      //!
-
-  std::string m_triggerSelection;      //!
-
-  bool m_DC14;                         //!
+  std::string m_evtDetailStr;
+  std::string m_trigDetailStr;
+  std::string m_jetTrigDetailStr;
+  std::string m_muDetailStr;
+  std::string m_elDetailStr;
+  std::string m_jetDetailStr;
+  std::string m_fatJetDetailStr;
+  std::string m_tauDetailStr;
+
+  std::string m_evtContainerName;
+  std::string m_muContainerName;
+  std::string m_elContainerName;
+  std::string m_jetContainerName;
+  std::string m_fatJetContainerName;
+  std::string m_tauContainerName;
+
+  std::string m_triggerSelection;
+
+  // names of the TStore vectors of systematic ids (the OutputAlgo of a calibrator
+  // or selector) of each collection. Each systematic besides nominal gets a
+  // tree <name>_<collection>_<systematic> with only that collection's branches,
+  // made in initialize() from the list declared to SystematicIndex
+  std::string m_muSystsVec;
+  std::string m_elSystsVec;
+  std::string m_jetSystsVec;
+  std::string m_tauSystsVec;
+
+  bool m_DC14;
+
+  // fill the tree on a background thread, overlapping with the next event
+  bool m_asyncWrite;
+
+  // output layout, unset values keep the ROOT defaults. Compression of the
+  // whole tree, e.g. "LZMA" and 9
+  std::string m_compressionAlgorithm;
+  int m_compressionLevel;
+  // bytes per basket for every branch
+  int m_basketSize;
+  // TTree::SetAutoFlush: > 0 entries, < 0 bytes per cluster
+  int m_autoFlush;
+  // per branch group, space separated "<pattern>:<algorithm>:<level>[:<basketSize>]",
+  // e.g. "jet_pt:LZ4:4 jet_eta:LZ4:4 el_*:LZMA:9:16000". Applied in order,
+  // an empty algorithm keeps the compression
+  std::string m_branchSettings;
+  // resize the baskets from what the first m_autoTuneEntries entries wrote,
+  // in at most m_autoTuneMemory bytes for all of them
+  int m_autoTuneEntries;
+  int m_autoTuneMemory;
 
 private:
   HelpTreeBase* m_helpTree;            //!
   
   TrigConf::xAODConfigTool*  m_trigConfTool;  //!
   Trig::TrigDecisionTool*    m_trigDecTool;   //!
+  TrigDecisionCache*         m_trigCache;     //!
+
+  // trees of the systematics by collection, then by systematic. They have one
+  // entry per entry of the main tree, with its runNumber and eventNumber, and
+  // are not attached to it, readers AddFriend the ones they want
+  std::map< std::string, std::map< unsigned int, HelpTreeBase* > > m_systTrees; //!
+  SystematicKeys m_muKeys;  //!
+  SystematicKeys m_elKeys;  //!
+  SystematicKeys m_jetKeys; //!
+  SystematicKeys m_tauKeys; //!
 
 public:
 
@@ -58,6 +102,7 @@ public:
 
   // these are the functions inherited from Algorithm
   virtual EL::StatusCode setupJob (EL::Job& job);           //!
+  virtual EL::StatusCode histInitialize ();                 //!
   virtual EL::StatusCode fileExecute ();                    //!
   virtual EL::StatusCode treeInitialize ();                 //!
   virtual EL::StatusCode changeInput (bool firstFile);      //!
@@ -69,9 +114,15 @@ public:
 
   // these are the functions not inherited from Algorithm
   virtual EL::StatusCode configure ();                      //!
+  EL::StatusCode applyTreeLayout ( HelpTreeBase* helpTree ); //!
+  EL::StatusCode createSystTrees ( const std::string& collection, const std::string& systsVec ); //!
+  EL::StatusCode fillSystTrees ( const std::string& collection, const std::string& systsVec, const xAOD::EventInfo* eventInfo,
+                                 const xAOD::Vertex* primaryVertex, int pvLocation ); //!
+  // empty entry of the collection of a systematic's tree
+  void clearSystTree ( const std::string& collection, HelpTreeBase* systTree ); //!
 
   // this is needed to distribute the algorithm to the workers
-  ClassDef(TreeAlgo, 1);                                 //!
+  ClassDef(TreeAlgo, 2);                                 //!
 };
 
 #endif
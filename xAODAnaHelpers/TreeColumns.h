@@ -0,0 +1,152 @@
+#ifndef xAODAnaHelpers_TreeColumns_H
+#define xAODAnaHelpers_TreeColumns_H
+
+// EDM include(s):
+#include "AthContainers/AuxElement.h"
+#include "AthContainers/AuxVectorData.h"
+
+// ROOT include(s):
+#include "TTree.h"
+
+// C++ include(s)
+#include <string>
+#include <vector>
+
+/*
+  TreeColumns
+
+    The per-object branches of HelpTreeBase that are nothing but an aux variable
+    of the object: one std::vector branch per variable, filled with the value
+    (optionally divided by the output units) or with a default if the variable
+    is not there. The vectors are members of the tree (m_jet_time, ...), so
+    the *User hooks of derived trees still see them filled.
+
+    For the variables of the input file (add()), whether a variable is there
+    is looked up once per event and container owning the objects, on the
+    first of its objects filled, not on every object: an aux variable is
+    there for all the objects of a container or for none. Decorations the job itself writes, possibly only on some objects or
+    in some events (electron PID and isolation flags of ElectronSelector, ...),
+    are added with addDecoration() and looked up on every object. The branch
+    vectors are cleared, not released, between events so they keep their
+    capacity.
+
+    Example Usage:
+      // AddJets()
+      m_jetColumns = new TreeColumns( m_tree, m_units );
+      m_jetColumns->add<float>     ( m_jet_time, "jet_Timing",    "Timing"        );
+      m_jetColumns->add<float>     ( m_jet_negE, "jet_NegativeE", "NegativeE", true );
+      m_jetColumns->add<float, int>( m_jet_fracSampMaxIdx, "jet_FracSamplingMaxIndex", "FracSamplingMaxIndex" );
+      m_elColumns->addDecoration<int, char>( m_el_LHLoose, "el_LHLoose", "LHLoose", false, -1 );
+      // FillJets()
+      m_jetColumns->reserve( jets->size() );
+      for( auto jet_itr : *jets ) { m_jetColumns->fill( *jet_itr ); }
+*/
+class TreeColumns
+{
+  public:
+    TreeColumns( TTree* tree, float units ) :
+      m_tree(tree),
+      m_units(units),
+      m_resolvedFor(nullptr)
+    { }
+
+    ~TreeColumns()
+    {
+      for ( auto column : m_columns ) { delete column; }
+    }
+
+    // T is what goes in the branch (values), AUX the type of the aux variable
+    template <typename T, typename AUX = T>
+    void add( std::vector<T>& values, const std::string& branchName, const std::string& auxName, bool scale = false, T missing = -999 )
+    {
+      this->addColumn( new Column<T, AUX>( values, auxName, scale ? m_units : 0., missing, false ), branchName );
+    }
+
+    // the same for a decoration that is not on every object, checked object by object
+    template <typename T, typename AUX = T>
+    void addDecoration( std::vector<T>& values, const std::string& branchName, const std::string& auxName, bool scale = false, T missing = -999 )
+    {
+      this->addColumn( new Column<T, AUX>( values, auxName, scale ? m_units : 0., missing, true ), branchName );
+    }
+
+    // availability is looked up again on the next object
+    void newInputFile() { m_resolvedFor = nullptr; }
+
+    void reserve( std::size_t n )
+    {
+      for ( auto column : m_columns ) { column->reserve( n ); }
+    }
+
+    void fill( const SG::AuxElement& obj )
+    {
+      if ( obj.container() != m_resolvedFor ) {
+        for ( auto column : m_columns ) { column->resolve( obj ); }
+        m_resolvedFor = obj.container();
+      }
+      for ( auto column : m_columns ) { column->fill( obj ); }
+    }
+
+    // the containers of the next event may sit where those of this one did
+    void clear()
+    {
+      for ( auto column : m_columns ) { column->clear(); }
+      m_resolvedFor = nullptr;
+    }
+
+  private:
+    struct ColumnBase;
+
+    void addColumn( ColumnBase* column, const std::string& branchName )
+    {
+      column->branch( m_tree, branchName );
+      m_columns.push_back( column );
+      m_resolvedFor = nullptr;
+    }
+
+    struct ColumnBase {
+      virtual ~ColumnBase() { }
+      virtual void resolve( const SG::AuxElement& obj ) = 0;
+      virtual void fill( const SG::AuxElement& obj ) = 0;
+      virtual void clear() = 0;
+      virtual void reserve( std::size_t n ) = 0;
+      virtual void branch( TTree* tree, const std::string& branchName ) = 0;
+    };
+
+    template <typename T, typename AUX>
+    struct Column : ColumnBase {
+      Column( std::vector<T>& values, const std::string& auxName, float units, T missing, bool perObject ) :
+        m_values(values),
+        m_acc(auxName),
+        m_units(units),
+        m_missing(missing),
+        m_perObject(perObject),
+        m_available(false)
+      { }
+
+      void resolve( const SG::AuxElement& obj ) { m_available = m_acc.isAvailable( obj ); }
+      void fill( const SG::AuxElement& obj )
+      {
+        bool available = m_perObject ? m_acc.isAvailable( obj ) : m_available;
+        if ( !available )   { m_values.push_back( m_missing ); return; }
+        if ( m_units )      { m_values.push_back( m_acc( obj ) / m_units ); return; }
+        m_values.push_back( m_acc( obj ) );
+      }
+      void clear() { m_values.clear(); }
+      void reserve( std::size_t n ) { m_values.reserve( n ); }
+      void branch( TTree* tree, const std::string& branchName ) { tree->Branch( branchName.c_str(), &m_values ); }
+
+      std::vector<T>& m_values;
+      SG::AuxElement::ConstAccessor<AUX> m_acc;
+      float m_units;
+      T m_missing;
+      bool m_perObject;
+      bool m_available;
+    };
+
+    TTree* m_tree;
+    float m_units;
+    const SG::AuxVectorData* m_resolvedFor; // the container the availability was looked up for
+    std::vector<ColumnBase*> m_columns;
+};
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef xAODAnaHelpers_TrigDecisionCache_H
+#define xAODAnaHelpers_TrigDecisionCache_H
+
+// EL include(s):
+#include <EventLoop/StatusCode.h>
+
+// EDM include(s):
+#include "xAODEventInfo/EventInfo.h"
+
+// C++ include(s)
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TrigConf {
+  class xAODConfigTool;
+}
+
+namespace Trig {
+  class TrigDecisionTool;
+  class ChainGroup;
+}
+
+/*
+  TrigDecisionCache
+
+    Resolves the chain groups of a trigger selection once, and again only when the
+    trigger menu keys change, instead of asking the TrigDecisionTool to match a regex
+    on every event.
+
+    decide() evaluates the decision of every chain of the selection into a packed
+    bitset (bit i <-> chains().at(i)) and decorates it onto EventInfo. Any other
+    TrigDecisionCache for the same selection (e.g. the one of BasicEventSelection and
+    the one of TreeAlgo) finds the bits already there and does not go back to the tool.
+
+    shareTools() sets up the trigger tools themselves, one pair per configuration for
+    all the algorithms of the job (see ToolRegistry).
+
+    Example Usage:
+      // initialize()
+      RETURN_CHECK("initialize()", TrigDecisionCache::shareTools( m_trigDecTool, m_trigConfTool ), "");
+      m_trigCache = new TrigDecisionCache( m_trigDecTool, m_trigConfTool, "HLT_j.*" );
+      // execute()
+      m_trigCache->decide( eventInfo );
+      if ( !m_trigCache->passSelection() ) { ... }
+      // finalize()
+      delete m_trigCache;
+      TrigDecisionCache::releaseTools( m_trigDecTool, m_trigConfTool );
+*/
+class TrigDecisionCache
+{
+  public:
+    TrigDecisionCache( Trig::TrigDecisionTool* trigDecTool, TrigConf::xAODConfigTool* trigConfTool, const std::string& selection );
+
+    // evaluate this event, to be called before anything below
+    // (eventInfo: where the bits are shared with the other caches of the selection, nullptr: not shared)
+    void decide( const xAOD::EventInfo* eventInfo );
+    // only resolve the chains for the menu of this event, nothing is evaluated (chains() and the keys are set)
+    void updateMenu();
+
+    // what the chains are resolved with
+    Trig::TrigDecisionTool*   trigDecTool() const  { return m_trigDecTool; }
+    TrigConf::xAODConfigTool* trigConfTool() const { return m_trigConfTool; }
+    const std::string&        selection() const    { return m_selection; }
+
+    // the selection
+    bool  passSelection() const;
+    float selectionPrescale() const;
+
+    // single chains of the selection, in bit order
+    const std::vector<std::string>& chains() const { return m_chains; }
+    const std::vector<unsigned int>& bits() const { return m_bits; }
+    bool passChain( unsigned int iChain ) const { return ( m_bits.at( iChain/32 ) >> ( iChain%32 ) ) & 1; }
+
+    // global decisions, from precompiled ".*", "L1_.*" and "HLT_.*" groups
+    bool passAny() const;
+    bool passL1() const;
+    bool passHLT() const;
+
+    // menu keys of the current event
+    uint32_t masterKey() const { return m_masterKey; }
+    uint32_t L1PSKey() const   { return m_L1PSKey; }
+    uint32_t HLTPSKey() const  { return m_HLTPSKey; }
+    // bumped every time the chains are resolved again, so readers can tell the list changed
+    unsigned int menuVersion() const { return m_menuVersion; }
+
+    // reading the decoration back, without a cache of your own
+    static std::string decorationName( const std::string& selection );
+
+    // the trigger tools reading trigDecisionKey, made by the first algorithm asking for them
+    static EL::StatusCode shareTools( Trig::TrigDecisionTool*& trigDecTool, TrigConf::xAODConfigTool*& trigConfTool, const std::string& trigDecisionKey = "xTrigDecision" );
+    static void releaseTools( Trig::TrigDecisionTool*& trigDecTool, TrigConf::xAODConfigTool*& trigConfTool );
+
+  private:
+    void resolve();
+
+    Trig::TrigDecisionTool*   m_trigDecTool;
+    TrigConf::xAODConfigTool* m_trigConfTool;
+    std::string m_selection;
+    SG::AuxElement::Decorator< std::vector<unsigned int> > m_bitsDecor;
+
+    uint32_t m_masterKey;
+    uint32_t m_L1PSKey;
+    uint32_t m_HLTPSKey;
+    unsigned int m_menuVersion;
+
+    const Trig::ChainGroup* m_selectionGroup;
+    const Trig::ChainGroup* m_anyGroup;
+    const Trig::ChainGroup* m_L1Group;
+    const Trig::ChainGroup* m_HLTGroup;
+
+    std::vector<std::string>             m_chains;
+    std::vector<const Trig::ChainGroup*> m_chainGroups;
+    std::vector<unsigned int>            m_bits;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef xAODAnaHelpers_TriggerMenuReader_H
+#define xAODAnaHelpers_TriggerMenuReader_H
+
+// ROOT include(s):
+#include "TFile.h"
+#include "TTree.h"
+
+// C++ include(s)
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/*
+  TriggerMenuReader
+
+    Turns the triggerBits branch written by HelpTreeBase (TriggerInfoSwitch
+    "triggerBits") back into trigger names, using the <tree>_triggerMenu tree
+    written next to the output tree. The menu of an event is the one with its
+    MasterKey/L1PSKey/HLTPSKey, so files merged with hadd (whose menu trees are
+    simply concatenated, the same menu possibly several times) read back fine.
+
+    Header only, so it can be used from a plain ROOT macro.
+
+    Example Usage:
+      TriggerMenuReader menu( file, "outTree" );
+      std::vector<unsigned int>* bits(0); int smk(0), l1psk(0), hltpsk(0);
+      tree->SetBranchAddress("triggerBits", &bits);
+      tree->SetBranchAddress("MasterKey",   &smk);
+      tree->SetBranchAddress("L1PSKey",     &l1psk);
+      tree->SetBranchAddress("HLTPSKey",    &hltpsk);
+      ...
+      tree->GetEntry(i);
+      int menuIndex = menu.menuIndex( smk, l1psk, hltpsk );
+      if ( menu.isPassed( "HLT_j360", menuIndex, *bits ) ) { ... }
+      std::vector<std::string> fired = menu.passedTriggers( menuIndex, *bits );
+*/
+class TriggerMenuReader
+{
+  public:
+    TriggerMenuReader( TFile* file, const std::string& treeName )
+    {
+      TTree* menuTree = dynamic_cast<TTree*>( file->Get( (treeName + "_triggerMenu").c_str() ) );
+      if ( !menuTree ) {
+        Error("TriggerMenuReader()", "No %s_triggerMenu tree in %s", treeName.c_str(), file->GetName());
+        return;
+      }
+
+      std::vector<std::string>* names(0);
+      int masterKey(0), L1PSKey(0), HLTPSKey(0);
+      menuTree->SetBranchAddress( "triggerNames", &names );
+      menuTree->SetBranchAddress( "MasterKey",    &masterKey );
+      menuTree->SetBranchAddress( "L1PSKey",      &L1PSKey );
+      menuTree->SetBranchAddress( "HLTPSKey",     &HLTPSKey );
+      for ( Long64_t iMenu = 0; iMenu < menuTree->GetEntries(); ++iMenu ) {
+        menuTree->GetEntry( iMenu );
+        // the same menu from several merged files: keep the first one
+        if ( !m_menus.insert( std::make_pair( std::make_tuple( masterKey, L1PSKey, HLTPSKey ), m_names.size() ) ).second ) { continue; }
+        m_names.push_back( *names );
+        std::map<std::string, unsigned int> index;
+        for ( unsigned int iChain = 0; iChain < names->size(); ++iChain ) { index[ names->at(iChain) ] = iChain; }
+        m_index.push_back( index );
+      }
+      menuTree->ResetBranchAddresses();
+      delete names;
+    }
+
+    unsigned int nMenus() const { return m_names.size(); }
+
+    // index of the menu with these keys, -1 if there is none
+    int menuIndex( int masterKey, int L1PSKey, int HLTPSKey ) const
+    {
+      std::map< std::tuple<int, int, int>, int >::const_iterator it = m_menus.find( std::make_tuple( masterKey, L1PSKey, HLTPSKey ) );
+      return it == m_menus.end() ? -1 : it->second;
+    }
+
+    // trigger names of one menu, in bit order
+    const std::vector<std::string>& triggerNames( int menuIndex ) const { return m_names.at( menuIndex ); }
+
+    bool isPassed( const std::string& trigName, int menuIndex, const std::vector<unsigned int>& bits ) const
+    {
+      if ( menuIndex < 0 ) { return false; }
+      const std::map<std::string, unsigned int>& index = m_index.at( menuIndex );
+      std::map<std::string, unsigned int>::const_iterator it = index.find( trigName );
+      if ( it == index.end() ) { return false; }
+      return passBit( it->second, bits );
+    }
+
+    std::vector<std::string> passedTriggers( int menuIndex, const std::vector<unsigned int>& bits ) const
+    {
+      std::vector<std::string> passed;
+      if ( menuIndex < 0 ) { return passed; }
+      const std::vector<std::string>& names = m_names.at( menuIndex );
+      for ( unsigned int iChain = 0; iChain < names.size(); ++iChain ) {
+        if ( passBit( iChain, bits ) ) { passed.push_back( names.at(iChain) ); }
+      }
+      return passed;
+    }
+
+  private:
+    static bool passBit( unsigned int iChain, const std::vector<unsigned int>& bits )
+    {
+      if ( iChain/32 >= bits.size() ) { return false; }
+      return ( bits.at( iChain/32 ) >> ( iChain%32 ) ) & 1;
+    }
+
+    std::map< std::tuple<int, int, int>, int >          m_menus;
+    std::vector< std::vector<std::string> >             m_names;
+    std::vector< std::map<std::string, unsigned int> > m_index;
+};
+
+#endif